@@ -0,0 +1,286 @@
+#include "Benchmark.hpp"
+
+#include <algorithm> // std::sort
+#include <chrono>
+#include <cmath> // std::ceil
+#include <cstdio>
+#include <cstdlib> // std::strtod
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double ElapsedNs(Clock::time_point start, Clock::time_point end)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+
+std::string EscapeJson(const std::string& text)
+{
+    std::string escaped;
+    for (const char character : text)
+    {
+        if (character == '"' || character == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += character;
+    }
+
+    return escaped;
+}
+
+// The baseline is a file written by WriteJson, which puts every benchmark on its own line
+bool FindJsonNumber(const std::string& line, const std::string& key, double& value)
+{
+    const std::string pattern = "\"" + key + "\": ";
+    const size_t pos = line.find(pattern);
+    if (pos == std::string::npos)
+    {
+        return false;
+    }
+    value = std::strtod(line.c_str() + pos + pattern.size(), nullptr);
+
+    return true;
+}
+
+bool FindJsonString(const std::string& line, const std::string& key, std::string& value)
+{
+    const std::string pattern = "\"" + key + "\": \"";
+    const size_t pos = line.find(pattern);
+    if (pos == std::string::npos)
+    {
+        return false;
+    }
+
+    value.clear();
+    for (size_t i = pos + pattern.size(); i < line.size() && line[i] != '"'; i++)
+    {
+        if (line[i] == '\\' && i + 1 < line.size())
+        {
+            i++;
+        }
+        value += line[i];
+    }
+
+    return true;
+}
+} // namespace
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options) : m_options(options)
+{
+}
+
+void BenchmarkRunner::Run(const std::string& name, const std::function<size_t()>& body)
+{
+    Run(name, [] {}, body);
+}
+
+void BenchmarkRunner::Run(const std::string& name, const std::function<void()>& setup, const std::function<size_t()>& body)
+{
+    if (!IsSelected(name))
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < m_options.warmupIterations; i++)
+    {
+        setup();
+        body();
+    }
+
+    m_samples.clear();
+    size_t items = 0;
+    size_t allocations = 0;
+
+    const Clock::time_point benchmarkStart = Clock::now();
+    while (m_samples.size() < m_options.maxIterations)
+    {
+        setup();
+
+        const size_t allocationsBefore = AllocationTracker::GetAllocationCount();
+        const Clock::time_point start = Clock::now();
+        items += body();
+        const Clock::time_point end = Clock::now();
+        allocations += AllocationTracker::GetAllocationCount() - allocationsBefore;
+
+        m_samples.emplace_back(ElapsedNs(start, end));
+
+        if (m_samples.size() >= m_options.minIterations && ElapsedNs(benchmarkStart, end) >= m_options.minTimeMs * 1e6)
+        {
+            break;
+        }
+    }
+
+    AddResult(name, m_samples, items, allocations);
+}
+
+void BenchmarkRunner::AddResult(const std::string& name, std::vector<double>& samplesNs, size_t items, size_t allocations)
+{
+    if (samplesNs.empty())
+    {
+        return;
+    }
+
+    double timedNs = 0.0;
+    for (const double sampleNs : samplesNs)
+    {
+        timedNs += sampleNs;
+    }
+
+    std::sort(samplesNs.begin(), samplesNs.end());
+    const size_t numSamples = samplesNs.size();
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = numSamples;
+    result.meanNs = timedNs / numSamples;
+    result.medianNs = numSamples % 2 == 1 ? samplesNs[numSamples / 2] : (samplesNs[numSamples / 2 - 1] + samplesNs[numSamples / 2]) / 2.0;
+    result.p99Ns = samplesNs[std::min(numSamples - 1, static_cast<size_t>(std::ceil(0.99 * numSamples)) - 1)];
+    result.itemsPerSecond = timedNs > 0.0 ? items / (timedNs / 1e9) : 0.0;
+    result.allocationsPerIteration = static_cast<double>(allocations) / numSamples;
+
+    PrintResult(result);
+    m_results.emplace_back(result);
+}
+
+bool BenchmarkRunner::IsSelected(const std::string& name) const
+{
+    return m_options.filter.empty() || name.find(m_options.filter) != std::string::npos;
+}
+
+bool BenchmarkRunner::WriteJson(const std::string& filePath) const
+{
+    FILE* file = std::fopen(filePath.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < m_results.size(); i++)
+    {
+        const BenchmarkResult& result = m_results[i];
+        std::fprintf(file, "    {\"name\": \"%s\", \"iterations\": %zu, \"mean_ns\": %.1f, \"median_ns\": %.1f, \"p99_ns\": %.1f, \"items_per_second\": %.1f, \"allocations_per_iteration\": %.2f}%s\n",
+            EscapeJson(result.name).c_str(),
+            result.iterations,
+            result.meanNs,
+            result.medianNs,
+            result.p99Ns,
+            result.itemsPerSecond,
+            result.allocationsPerIteration,
+            i + 1 < m_results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    std::fclose(file);
+
+    return true;
+}
+
+bool BenchmarkRunner::ReadJson(const std::string& filePath, std::vector<BenchmarkResult>& results)
+{
+    std::ifstream file(filePath);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    results.clear();
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        BenchmarkResult result;
+        if (!FindJsonString(line, "name", result.name) || !FindJsonNumber(line, "median_ns", result.medianNs))
+        {
+            continue;
+        }
+
+        double iterations = 0.0;
+        FindJsonNumber(line, "iterations", iterations);
+        result.iterations = static_cast<size_t>(iterations);
+        FindJsonNumber(line, "mean_ns", result.meanNs);
+        FindJsonNumber(line, "p99_ns", result.p99Ns);
+        FindJsonNumber(line, "items_per_second", result.itemsPerSecond);
+        FindJsonNumber(line, "allocations_per_iteration", result.allocationsPerIteration);
+
+        results.emplace_back(result);
+    }
+
+    return true;
+}
+
+size_t BenchmarkRunner::CompareWithBaseline(const std::vector<BenchmarkResult>& baseline, double thresholdPercent) const
+{
+    size_t numRegressions = 0;
+
+    std::printf("\n%-56s %12s %12s %9s\n", "Benchmark", "Baseline", "Current", "Change");
+    for (const BenchmarkResult& result : m_results)
+    {
+        const auto baselineIt = std::find_if(baseline.begin(), baseline.end(), [&](const BenchmarkResult& baselineResult) { return baselineResult.name == result.name; });
+        if (baselineIt == baseline.end() || baselineIt->medianNs <= 0.0)
+        {
+            std::printf("%-56s %12s %12s %9s\n", result.name.c_str(), "-", FormatDuration(result.medianNs).c_str(), "new");
+            continue;
+        }
+
+        const double changePercent = (result.medianNs - baselineIt->medianNs) / baselineIt->medianNs * 100.0;
+        const char* verdict = "";
+        if (changePercent > thresholdPercent)
+        {
+            verdict = "  REGRESSION";
+            numRegressions++;
+        }
+        else if (changePercent < -thresholdPercent)
+        {
+            verdict = "  faster";
+        }
+
+        std::printf("%-56s %12s %12s %+8.1f%%%s\n", result.name.c_str(), FormatDuration(baselineIt->medianNs).c_str(), FormatDuration(result.medianNs).c_str(), changePercent, verdict);
+    }
+
+    return numRegressions;
+}
+
+void BenchmarkRunner::PrintHeader()
+{
+    std::printf("%-56s %9s %12s %12s %12s %14s %10s\n", "Benchmark", "Iters", "Mean", "Median", "p99", "Items/s", "Allocs/it");
+}
+
+void BenchmarkRunner::PrintResult(const BenchmarkResult& result)
+{
+    std::printf("%-56s %9zu %12s %12s %12s %14.0f %10.1f\n",
+        result.name.c_str(),
+        result.iterations,
+        FormatDuration(result.meanNs).c_str(),
+        FormatDuration(result.medianNs).c_str(),
+        FormatDuration(result.p99Ns).c_str(),
+        result.itemsPerSecond,
+        result.allocationsPerIteration);
+    std::fflush(stdout);
+}
+
+std::string BenchmarkRunner::FormatDuration(double ns)
+{
+    char buffer[32];
+    if (ns < 1e3)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.0f ns", ns);
+    }
+    else if (ns < 1e6)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+    }
+    else
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+    }
+
+    return buffer;
+}
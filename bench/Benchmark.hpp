@@ -0,0 +1,64 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchmarkOptions
+{
+    double minTimeMs = 300.0; // each benchmark runs at least this long (setup included)...
+    size_t minIterations = 10; // ...and at least this many iterations
+    size_t maxIterations = 1000000;
+    size_t warmupIterations = 3;
+    std::string filter; // only run the benchmarks whose name contains this text
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    size_t iterations = 0;
+    double meanNs = 0.0;
+    double medianNs = 0.0;
+    double p99Ns = 0.0;
+    double itemsPerSecond = 0.0; // throughput, in whatever the benchmark processes (levels, tiles...)
+    double allocationsPerIteration = 0.0;
+};
+
+// Runs each benchmark until enough samples have been taken, timing every iteration on its own so the
+// distribution (median, p99) is known and not only the mean
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions& options);
+
+    // `setup` runs before every iteration and is not timed; `body` is timed and returns the number of items it processed
+    void Run(const std::string& name, const std::function<void()>& setup, const std::function<size_t()>& body);
+    void Run(const std::string& name, const std::function<size_t()>& body);
+
+    // Adds a result from samples timed by the caller, e.g. when replaying a recorded session
+    void AddResult(const std::string& name, std::vector<double>& samplesNs, size_t items, size_t allocations);
+
+    bool IsSelected(const std::string& name) const;
+
+    const std::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+    bool WriteJson(const std::string& filePath) const;
+    static bool ReadJson(const std::string& filePath, std::vector<BenchmarkResult>& results);
+
+    // Compares the medians against a previous run, returns the number of benchmarks which got slower than the threshold
+    size_t CompareWithBaseline(const std::vector<BenchmarkResult>& baseline, double thresholdPercent) const;
+
+    static void PrintHeader();
+
+private:
+    BenchmarkOptions m_options;
+    std::vector<BenchmarkResult> m_results;
+    std::vector<double> m_samples; // reused between benchmarks
+
+    static void PrintResult(const BenchmarkResult& result);
+    static std::string FormatDuration(double ns);
+};
+
+#endif // BENCHMARK_HPP
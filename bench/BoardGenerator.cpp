@@ -0,0 +1,119 @@
+#include "BoardGenerator.hpp"
+
+#include <algorithm> // std::shuffle
+#include <cstdlib> // std::abs
+#include <numeric> // std::iota
+#include <random>
+#include <vector>
+
+namespace
+{
+// Places one queen per row and column, with no two queens touching, trying the columns of each row in a random order
+bool PlaceQueens(int row, std::vector<int>& queenColumns, std::vector<bool>& usedColumns, std::mt19937& rng)
+{
+    const int size = static_cast<int>(queenColumns.size());
+    if (row == size)
+    {
+        return true;
+    }
+
+    std::vector<int> columns(size);
+    std::iota(columns.begin(), columns.end(), 0);
+    std::shuffle(columns.begin(), columns.end(), rng);
+
+    for (const int column : columns)
+    {
+        // Queens in different rows can only touch diagonally, i.e. from the previous row
+        if (usedColumns[column] || (row > 0 && std::abs(queenColumns[row - 1] - column) <= 1))
+        {
+            continue;
+        }
+
+        queenColumns[row] = column;
+        usedColumns[column] = true;
+        if (PlaceQueens(row + 1, queenColumns, usedColumns, rng))
+        {
+            return true;
+        }
+        usedColumns[column] = false;
+    }
+
+    return false;
+}
+} // namespace
+
+namespace BoardGenerator
+{
+std::vector<std::vector<int>> Generate(int size, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+
+    // Sizes 2 and 3 have no valid queen layout
+    std::vector<int> queenColumns(size, -1);
+    std::vector<bool> usedColumns(size, false);
+    if (size < 4 || !PlaceQueens(0, queenColumns, usedColumns, rng))
+    {
+        return {};
+    }
+
+    // Each queen seeds its own region
+    std::vector<std::vector<int>> repr(size, std::vector<int>(size, -1));
+    std::vector<std::pair<int, int>> frontier;
+    const int offsets[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    const auto addNeighboursToFrontier = [&](int row, int column) {
+        for (const auto& offset : offsets)
+        {
+            const int neighbourRow = row + offset[0];
+            const int neighbourColumn = column + offset[1];
+            if (neighbourRow >= 0 && neighbourRow < size && neighbourColumn >= 0 && neighbourColumn < size && repr[neighbourRow][neighbourColumn] < 0)
+            {
+                frontier.emplace_back(neighbourRow, neighbourColumn);
+            }
+        }
+    };
+
+    for (int row = 0; row < size; row++)
+    {
+        repr[row][queenColumns[row]] = row;
+    }
+    for (int row = 0; row < size; row++)
+    {
+        addNeighboursToFrontier(row, queenColumns[row]);
+    }
+
+    // Grow the regions one random tile at a time, so they end up with irregular shapes
+    while (!frontier.empty())
+    {
+        std::uniform_int_distribution<size_t> frontierDistribution(0, frontier.size() - 1);
+        const size_t index = frontierDistribution(rng);
+        const std::pair<int, int> tile = frontier[index];
+        frontier[index] = frontier.back();
+        frontier.pop_back();
+
+        const int row = tile.first;
+        const int column = tile.second;
+        if (repr[row][column] >= 0)
+        {
+            continue;
+        }
+
+        // Join the region of a random neighbour which already belongs to one
+        std::vector<int> neighbourRegions;
+        for (const auto& offset : offsets)
+        {
+            const int neighbourRow = row + offset[0];
+            const int neighbourColumn = column + offset[1];
+            if (neighbourRow >= 0 && neighbourRow < size && neighbourColumn >= 0 && neighbourColumn < size && repr[neighbourRow][neighbourColumn] >= 0)
+            {
+                neighbourRegions.emplace_back(repr[neighbourRow][neighbourColumn]);
+            }
+        }
+        std::uniform_int_distribution<size_t> neighbourDistribution(0, neighbourRegions.size() - 1);
+        repr[row][column] = neighbourRegions[neighbourDistribution(rng)];
+
+        addNeighboursToFrontier(row, column);
+    }
+
+    return repr;
+}
+} // namespace BoardGenerator
@@ -0,0 +1,15 @@
+#ifndef BOARD_GENERATOR_HPP
+#define BOARD_GENERATOR_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace BoardGenerator
+{
+// Generates a size x size level (same representation as the level files: one region id per tile) with `size` regions.
+// Regions are grown around a valid queen layout, so the level always has at least one solution.
+// The same size and seed always give the same level.
+std::vector<std::vector<int>> Generate(int size, uint32_t seed);
+} // namespace BoardGenerator
+
+#endif // BOARD_GENERATOR_HPP
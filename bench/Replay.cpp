@@ -0,0 +1,76 @@
+#include "Replay.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "AllocationTracker.hpp"
+#include "InputRecorder.hpp"
+#include "Level.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double ElapsedNs(Clock::time_point start, Clock::time_point end)
+{
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+}
+} // namespace
+
+void ReplayRecording(BenchmarkRunner& runner, const std::vector<InputEvent>& events, size_t numPasses)
+{
+    const size_t numTypes = static_cast<size_t>(InputEventType::COUNT);
+    std::array<std::vector<double>, numTypes> samplesByType;
+    std::array<size_t, numTypes> allocationsByType = {};
+    std::vector<double> passSamples;
+    size_t sessionAllocations = 0;
+
+    // Without the solution cache, as the session was recorded (see InputRecorder::StartRecording)
+    Level level;
+    level.SetSolutionCacheEnabled(false);
+    for (size_t pass = 0; pass < numPasses; pass++)
+    {
+        // Every pass starts from the same state: no level loaded
+        level.Clear();
+
+        const size_t passAllocationsBefore = AllocationTracker::GetAllocationCount();
+        double passNs = 0.0;
+        for (const InputEvent& event : events)
+        {
+            const size_t allocationsBefore = AllocationTracker::GetAllocationCount();
+            const Clock::time_point start = Clock::now();
+
+            InputRecorder::Apply(level, event);
+            if (level.HasLoaded())
+            {
+                level.UpdateDynamicVertices();
+            }
+
+            const double eventNs = ElapsedNs(start, Clock::now());
+            const size_t type = static_cast<size_t>(event.type);
+            samplesByType[type].emplace_back(eventNs);
+            allocationsByType[type] += AllocationTracker::GetAllocationCount() - allocationsBefore;
+            passNs += eventNs;
+        }
+        passSamples.emplace_back(passNs);
+        sessionAllocations += AllocationTracker::GetAllocationCount() - passAllocationsBefore;
+    }
+
+    // Throughput in events per second
+    for (size_t type = 0; type < numTypes; type++)
+    {
+        const std::string name = std::string("replay/") + InputRecorder::GetEventTypeName(static_cast<InputEventType>(type));
+        runner.AddResult(name, samplesByType[type], samplesByType[type].size(), allocationsByType[type]);
+    }
+    runner.AddResult("replay/session", passSamples, events.size() * numPasses, sessionAllocations);
+
+    if (!events.empty() && !runner.GetResults().empty())
+    {
+        const double recordedMs = events.back().timestampMs;
+        const double replayedMs = runner.GetResults().back().meanNs / 1e6;
+        std::printf("\nRecorded session: %zu events over %.1f s, replayed in %.2f ms (%.0fx faster)\n", events.size(), recordedMs / 1000.0, replayedMs, replayedMs > 0.0 ? recordedMs / replayedMs : 0.0);
+    }
+}
@@ -0,0 +1,14 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "InputRecorder.hpp"
+
+// Feeds a recorded session into the game logic as fast as possible, without a window, and adds the latency of every
+// kind of event (applying it plus rewriting the vertices it changed) and of the whole session to the runner's results
+void ReplayRecording(BenchmarkRunner& runner, const std::vector<InputEvent>& events, size_t numPasses);
+
+#endif // REPLAY_HPP
@@ -0,0 +1,106 @@
+#include "RuleVariants.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "RulePolicies.hpp"
+
+namespace
+{
+// Larger generated levels take seconds to prove they have a single solution, which would drown the others
+const int MAX_LEVEL_SIZE = 16;
+
+struct VariantSummary
+{
+    const char* name = "";
+    uint64_t nodesPerIteration = 0;
+    size_t numSolvable = 0;
+    double medianNs = 0.0;
+
+    double GetNsPerNode() const { return nodesPerIteration > 0 ? medianNs / nodesPerIteration : 0.0; }
+};
+
+template <typename Rules>
+void BenchmarkVariant(BenchmarkRunner& runner, const std::vector<GridBoard>& levels, std::vector<VariantSummary>& summaries)
+{
+    const std::string name = std::string("variants/") + Rules::NAME;
+    if (!runner.IsSelected(name))
+    {
+        return;
+    }
+
+    VariantSummary summary;
+    summary.name = Rules::NAME;
+
+    // Throughput in levels per second
+    BasicGridSolver<Rules> solver;
+    runner.Run(name, [&] {
+        summary.nodesPerIteration = 0;
+        summary.numSolvable = 0;
+        for (const GridBoard& level : levels)
+        {
+            solver.SetBoard(level);
+            if (solver.Solve(2) > 0)
+            {
+                summary.numSolvable++;
+            }
+            summary.nodesPerIteration += solver.GetStats().nodes;
+        }
+        return levels.size();
+    });
+    summary.medianNs = runner.GetResults().back().medianNs;
+
+    summaries.emplace_back(summary);
+}
+} // namespace
+
+void RunRuleVariants(BenchmarkRunner& runner, const std::vector<GridBoard>& levels)
+{
+    std::vector<GridBoard> smallLevels;
+    for (const GridBoard& level : levels)
+    {
+        if (level.size <= MAX_LEVEL_SIZE)
+        {
+            smallLevels.emplace_back(level);
+        }
+    }
+    if (smallLevels.empty())
+    {
+        return;
+    }
+
+    std::vector<VariantSummary> summaries;
+    BenchmarkVariant<StandardRules>(runner, smallLevels, summaries);
+    BenchmarkVariant<RadiusTwoRules>(runner, smallLevels, summaries);
+    BenchmarkVariant<KnightRules>(runner, smallLevels, summaries);
+    BenchmarkVariant<TwoQueensRules>(runner, smallLevels, summaries);
+    BenchmarkVariant<ToroidalRules>(runner, smallLevels, summaries);
+    if (summaries.empty())
+    {
+        return;
+    }
+
+    // The levels are made for the standard rules, so the variants search different trees: only the time per node (setting
+    // up each level included) compares
+    std::printf("\nRule variants on %zu levels:\n", smallLevels.size());
+    double standardNsPerNode = 0.0;
+    for (const VariantSummary& summary : summaries)
+    {
+        if (summary.name == StandardRules::NAME)
+        {
+            standardNsPerNode = summary.GetNsPerNode();
+        }
+    }
+    for (const VariantSummary& summary : summaries)
+    {
+        const double nsPerNode = summary.GetNsPerNode();
+        std::printf("%-12s %3zu solvable, %8llu nodes, %7.1f ns per node", summary.name, summary.numSolvable, static_cast<unsigned long long>(summary.nodesPerIteration), nsPerNode);
+        if (standardNsPerNode > 0.0 && summary.name != StandardRules::NAME)
+        {
+            std::printf(" (%.2fx the standard rules)", nsPerNode / standardNsPerNode);
+        }
+        std::printf("\n");
+    }
+}
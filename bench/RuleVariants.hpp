@@ -0,0 +1,13 @@
+#ifndef RULE_VARIANTS_HPP
+#define RULE_VARIANTS_HPP
+
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GridSolver.hpp"
+
+// Solves (up to two solutions, as when rating a level) every level under each variant of the rules, and prints the
+// time per search node of each variant next to the standard rules', which the templated solver should match
+void RunRuleVariants(BenchmarkRunner& runner, const std::vector<GridBoard>& levels);
+
+#endif // RULE_VARIANTS_HPP
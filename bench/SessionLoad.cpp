@@ -0,0 +1,170 @@
+#include "SessionLoad.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "GameSession.hpp"
+#include "SessionManager.hpp"
+
+namespace
+{
+const size_t MOVE_SCRIPT_SIZE = 1 << 20;
+const size_t MOVES_PER_ITERATION = 10000;
+const uint32_t MOVE_SCRIPT_SEED = 2024;
+// Larger generated levels take the solver far too long to find the solution the move script plays from
+const int MAX_LEVEL_SIZE = 16;
+
+enum class MoveKind : uint8_t
+{
+    PLACE,
+    UNDO
+};
+
+struct ScriptedMove
+{
+    uint32_t sessionIndex = 0;
+    MoveKind kind = MoveKind::PLACE;
+    uint8_t row = 0;
+    uint8_t column = 0;
+    SessionMark mark = SessionMark::EMPTY;
+};
+
+// Drawn once up front, so the benchmark only times the sessions and not the random number generator
+std::vector<ScriptedMove> GenerateMoveScript(const SessionManager& manager, const std::vector<SessionId>& sessions, const std::vector<GridBoard>& solutions, const std::vector<int>& sessionLevels)
+{
+    std::mt19937 random(MOVE_SCRIPT_SEED);
+    std::uniform_int_distribution<uint32_t> sessionDistribution(0, static_cast<uint32_t>(sessions.size()) - 1);
+    std::uniform_int_distribution<int> percentDistribution(0, 99);
+
+    std::vector<ScriptedMove> script(MOVE_SCRIPT_SIZE);
+    for (ScriptedMove& move : script)
+    {
+        move.sessionIndex = sessionDistribution(random);
+
+        const GridBoard& level = manager.GetSession(sessions[move.sessionIndex])->GetLevel();
+        std::uniform_int_distribution<int> tileDistribution(0, level.size - 1);
+        move.row = static_cast<uint8_t>(tileDistribution(random));
+        move.column = static_cast<uint8_t>(tileDistribution(random));
+
+        const int percent = percentDistribution(random);
+        if (percent < 50)
+        {
+            move.mark = SessionMark::QUEEN;
+            move.column = static_cast<uint8_t>(solutions[sessionLevels[move.sessionIndex]].queens[move.row]);
+        }
+        else if (percent < 75)
+        {
+            move.mark = SessionMark::X;
+        }
+        else if (percent < 85)
+        {
+            move.mark = SessionMark::QUEEN;
+        }
+        else if (percent < 95)
+        {
+            move.mark = SessionMark::EMPTY;
+        }
+        else
+        {
+            move.kind = MoveKind::UNDO;
+        }
+    }
+
+    return script;
+}
+} // namespace
+
+void RunSessionLoad(BenchmarkRunner& runner, const std::vector<GridBoard>& levels, size_t numSessions)
+{
+    if (levels.empty() || numSessions == 0 || (!runner.IsSelected("sessions/create-destroy") && !runner.IsSelected("sessions/moves")))
+    {
+        return;
+    }
+
+    SessionManager manager;
+    std::vector<GridBoard> solutions;
+    for (const GridBoard& level : levels)
+    {
+        if (level.size > MAX_LEVEL_SIZE)
+        {
+            continue;
+        }
+
+        GridBoard emptyLevel = level;
+        emptyLevel.ClearQueens();
+
+        GridBoard solution;
+        if (GridSolver(emptyLevel).Solve(1, &solution) > 0)
+        {
+            manager.AddLevel(emptyLevel);
+            solutions.emplace_back(solution);
+        }
+    }
+    if (manager.GetNumLevels() == 0)
+    {
+        return;
+    }
+
+    const int numLevels = static_cast<int>(manager.GetNumLevels());
+
+    // Throughput in sessions per second
+    runner.Run("sessions/create-destroy", [&] {
+        for (size_t i = 0; i < numSessions; i++)
+        {
+            manager.CreateSession(static_cast<int>(i % numLevels));
+        }
+        manager.DestroyAllSessions();
+        return numSessions;
+    });
+
+    std::vector<SessionId> sessions;
+    std::vector<int> sessionLevels;
+    for (size_t i = 0; i < numSessions; i++)
+    {
+        sessionLevels.emplace_back(static_cast<int>(i % numLevels));
+        sessions.emplace_back(manager.CreateSession(sessionLevels.back()));
+    }
+    const size_t emptySessionsBytes = manager.GetMemoryUsage();
+
+    const std::vector<ScriptedMove> script = GenerateMoveScript(manager, sessions, solutions, sessionLevels);
+    size_t nextMove = 0;
+    size_t numMoves = 0;
+    size_t numWins = 0;
+
+    // Throughput in moves per second, the win check included
+    runner.Run("sessions/moves", [&] {
+        for (size_t i = 0; i < MOVES_PER_ITERATION; i++)
+        {
+            const ScriptedMove& move = script[nextMove];
+            nextMove = (nextMove + 1) % script.size();
+
+            GameSession& session = *manager.GetSession(sessions[move.sessionIndex]);
+            if (move.kind == MoveKind::UNDO)
+            {
+                session.Undo();
+            }
+            else
+            {
+                session.ApplyMove(move.row, move.column, move.mark);
+            }
+
+            if (session.IsWon())
+            {
+                numWins++;
+                session.Restart();
+            }
+        }
+        numMoves += MOVES_PER_ITERATION;
+        return MOVES_PER_ITERATION;
+    });
+
+    std::printf("\nSessions: %zu on %d levels, %zu bytes each when created, %zu bytes each after %zu moves (%zu games won)\n",
+        numSessions,
+        numLevels,
+        emptySessionsBytes / numSessions,
+        manager.GetMemoryUsage() / numSessions,
+        numMoves,
+        numWins);
+}
@@ -0,0 +1,15 @@
+#ifndef SESSION_LOAD_HPP
+#define SESSION_LOAD_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "GridSolver.hpp"
+
+// Synthetic load on a SessionManager: `numSessions` players spread over the levels, playing random moves (mostly
+// queens of the solution, so games do get won and restarted, plus crosses, wrong queens, erasures and undos).
+// Adds the session creation and move throughputs to the runner's results and prints the memory used per session.
+void RunSessionLoad(BenchmarkRunner& runner, const std::vector<GridBoard>& levels, size_t numSessions);
+
+#endif // SESSION_LOAD_HPP
@@ -0,0 +1,918 @@
+#include <algorithm> // std::sort
+#include <cstdio>
+#include <cstdlib> // std::atof
+#include <cstring> // std::strcmp
+#include <filesystem>
+#include <functional>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "SFML/Graphics/VertexArray.hpp"
+
+#include "AllocationTracker.hpp"
+#include "Benchmark.hpp"
+#include "BoardFormat.hpp"
+#include "BoardGenerator.hpp"
+#include "BoardOverview.hpp"
+#include "GlobalSettings.hpp"
+#include "InputRecorder.hpp"
+#include "Level.hpp"
+#include "LevelIndex.hpp"
+#include "Log.hpp"
+#include "Replay.hpp"
+#include "RuleVariants.hpp"
+#include "SessionLoad.hpp"
+#include "SessionManager.hpp"
+#include "SolutionCache.hpp"
+#include "ThumbnailRenderer.hpp"
+#include "Trace.hpp"
+
+namespace
+{
+const int GENERATED_BOARD_SIZES[] = {12, 16, 24, 32};
+const uint32_t GENERATED_BOARD_SEED = 2024;
+
+const int CAMERA_BOARD_SIZE = 200;
+
+const size_t OVERVIEW_NUM_BOARDS = 500;
+const int OVERVIEW_MAX_LEVEL_SIZE = 12;
+const size_t OVERVIEW_MOVES_PER_FRAME = 10;
+
+const size_t INDEX_NUM_LEVELS = 100000;
+
+const int THUMBNAIL_MAX_LEVEL_SIZE = 16; // bigger generated levels take the solver minutes
+
+const TraceEvent RULES[] = {
+    TraceEvent::RULE_QUEENS_CROSS_OUT_RELATED_TILES,
+    TraceEvent::RULE_MARK_QUEEN_IN_REGIONS_WITH_ONLY_ONE_EMPTY_TILE,
+    TraceEvent::RULE_MARK_QUEEN_IN_ROWS_OR_COLUMNS_WITH_ONLY_ONE_EMPTY_TILE,
+    TraceEvent::RULE_CROSSING_OUT_TILES_IN_REGION_EXCEPT_ROW_OR_COLUMN,
+    TraceEvent::RULE_CROSS_OUT_ROW_OR_COLUMN_EXCEPT_REGION};
+
+// A level loaded once and reused by every benchmark
+struct BenchmarkBoard
+{
+    std::string name;
+    std::unique_ptr<Level> level;
+    bool isGenerated = false;
+    int generatedSize = 0;
+    size_t numTiles = 0;
+    std::vector<std::vector<Mark>> solveStates; // marks after each move of the rules, from the empty board until they are stuck or the level is completed
+    bool isSolvedByRules = false;
+
+    size_t GetNumSolveSteps() const { return solveStates.size() - 1; }
+};
+
+// Forgets every solution, so the next solve has to go through the rules
+void ForgetSolutions()
+{
+    SolutionCache::getInstance().Close();
+}
+
+// Every move marks at least one tile, so a level never takes more moves than it has tiles: the bound only guards
+// against a rule which would report a move without making one
+size_t GetMaxSolveSteps(const Level& level)
+{
+    return static_cast<size_t>(level.GetNumRows()) * level.GetNumColumns();
+}
+
+size_t SolveCompletely(Level& level)
+{
+    const size_t maxSteps = GetMaxSolveSteps(level);
+    size_t numSteps = 0;
+    while (numSteps < maxSteps && !level.IsCompleted() && level.Solve())
+    {
+        numSteps++;
+    }
+
+    return numSteps;
+}
+
+void PrepareBoard(BenchmarkBoard& board)
+{
+    board.numTiles = static_cast<size_t>(board.level->GetNumRows()) * board.level->GetNumColumns();
+
+    ForgetSolutions();
+    board.level->Reset();
+    board.solveStates.emplace_back(board.level->GetMarks());
+    while (board.solveStates.size() <= GetMaxSolveSteps(*board.level) && !board.level->IsCompleted() && board.level->Solve())
+    {
+        board.solveStates.emplace_back(board.level->GetMarks());
+    }
+    board.isSolvedByRules = board.level->IsCompleted();
+    board.level->Reset();
+}
+
+std::vector<std::string> ListLevelFiles()
+{
+    std::vector<std::string> levelFiles;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(std::string(GlobalSettings::LEVELS_PATH), error))
+    {
+        levelFiles.emplace_back(entry.path().filename().string());
+    }
+    std::sort(levelFiles.begin(), levelFiles.end());
+
+    return levelFiles;
+}
+
+std::vector<BenchmarkBoard> LoadBoards(const std::vector<std::string>& levelFiles)
+{
+    std::vector<BenchmarkBoard> boards;
+
+    for (const std::string& levelFile : levelFiles)
+    {
+        BenchmarkBoard board;
+        board.name = levelFile;
+        board.level = std::make_unique<Level>();
+        board.level->Load(levelFile);
+        if (board.level->HasLoaded())
+        {
+            PrepareBoard(board);
+            boards.emplace_back(std::move(board));
+        }
+    }
+
+    for (const int size : GENERATED_BOARD_SIZES)
+    {
+        BenchmarkBoard board;
+        board.name = "generated-" + std::to_string(size) + "x" + std::to_string(size);
+        board.isGenerated = true;
+        board.generatedSize = size;
+        board.level = std::make_unique<Level>();
+        board.level->LoadFromRepr(BoardGenerator::Generate(size, GENERATED_BOARD_SEED + size));
+        if (board.level->HasLoaded())
+        {
+            PrepareBoard(board);
+            boards.emplace_back(std::move(board));
+        }
+    }
+
+    return boards;
+}
+
+// The same levels as plain boards, for the session load
+std::vector<GridBoard> LoadGridBoards(const std::vector<std::string>& levelFiles)
+{
+    std::vector<GridBoard> gridBoards;
+
+    std::string line;
+    std::string error;
+    GridBoard gridBoard;
+    for (const std::string& levelFile : levelFiles)
+    {
+        std::ifstream file(std::string(GlobalSettings::LEVELS_PATH) + levelFile);
+        if (BoardFormat::ReadBoard(file, line, gridBoard, error) && error.empty())
+        {
+            gridBoards.emplace_back(gridBoard);
+        }
+    }
+
+    for (const int size : GENERATED_BOARD_SIZES)
+    {
+        const std::vector<std::vector<int>> repr = BoardGenerator::Generate(size, GENERATED_BOARD_SEED + size);
+        gridBoard.size = size;
+        gridBoard.ClearQueens();
+        for (int row = 0; row < size; row++)
+        {
+            for (int column = 0; column < size; column++)
+            {
+                gridBoard.regions[row][column] = static_cast<uint8_t>(repr[row][column]);
+            }
+        }
+        gridBoards.emplace_back(gridBoard);
+    }
+
+    return gridBoards;
+}
+
+void BenchmarkLoad(BenchmarkRunner& runner, const std::vector<std::string>& levelFiles)
+{
+    Level level;
+    for (const std::string& levelFile : levelFiles)
+    {
+        runner.Run("load/" + levelFile, [&] {
+            level.Load(levelFile);
+            return size_t(1);
+        });
+    }
+
+    for (const int size : GENERATED_BOARD_SIZES)
+    {
+        const std::vector<std::vector<int>> repr = BoardGenerator::Generate(size, GENERATED_BOARD_SEED + size);
+        runner.Run("load/generated-" + std::to_string(size) + "x" + std::to_string(size), [&] {
+            level.LoadFromRepr(repr);
+            return size_t(1);
+        });
+    }
+}
+
+void BenchmarkCheck(BenchmarkRunner& runner, std::vector<BenchmarkBoard>& boards)
+{
+    for (BenchmarkBoard& board : boards)
+    {
+        Level& level = *board.level;
+
+        runner.Run("check/" + board.name + "/empty", [&] { level.Reset(); }, [&] {
+            level.Check();
+            return size_t(1);
+        });
+
+        if (!board.isSolvedByRules)
+        {
+            continue;
+        }
+
+        // Completed board, first with its solution known (fast path), then going through every rule
+        const auto solve = [&] {
+            level.Reset();
+            SolveCompletely(level);
+        };
+        solve();
+        runner.Run("check/" + board.name + "/solved-cached", [&] {
+            level.Check();
+            return size_t(1);
+        });
+
+        ForgetSolutions();
+        runner.Run("check/" + board.name + "/solved", [&] {
+            level.Check();
+            return size_t(1);
+        });
+
+        level.Reset();
+    }
+}
+
+void BenchmarkRules(BenchmarkRunner& runner, std::vector<BenchmarkBoard>& boards, bool generated)
+{
+    // Every intermediate state of the solves, visited in a fixed random order so short runs still sample all of them
+    std::vector<std::pair<BenchmarkBoard*, size_t>> states;
+    for (BenchmarkBoard& board : boards)
+    {
+        if (board.isGenerated != generated)
+        {
+            continue;
+        }
+        for (size_t step = 0; step < board.solveStates.size(); step++)
+        {
+            states.emplace_back(&board, step);
+        }
+    }
+    std::shuffle(states.begin(), states.end(), std::mt19937(GENERATED_BOARD_SEED));
+
+    if (states.empty())
+    {
+        return;
+    }
+
+    for (const TraceEvent rule : RULES)
+    {
+        size_t nextState = 0;
+        Level* level = nullptr;
+        const auto setup = [&] {
+            const std::pair<BenchmarkBoard*, size_t>& state = states[nextState];
+            nextState = (nextState + 1) % states.size();
+
+            level = state.first->level.get();
+            level->SetMarks(state.first->solveStates[state.second]);
+        };
+
+        runner.Run(std::string("rule/") + Tracer::GetEventName(rule) + (generated ? "/generated" : "/levels"), setup, [&] {
+            level->RunRule(rule);
+            return size_t(1);
+        });
+    }
+
+    for (BenchmarkBoard& board : boards)
+    {
+        board.level->Reset();
+    }
+}
+
+void BenchmarkSolve(BenchmarkRunner& runner, std::vector<BenchmarkBoard>& boards)
+{
+    for (BenchmarkBoard& board : boards)
+    {
+        Level& level = *board.level;
+
+        const std::string name = "solve/" + board.name + (board.isSolvedByRules ? "" : "/stuck");
+        runner.Run(name, [&] {
+            ForgetSolutions();
+            level.Reset();
+        }, [&] {
+            SolveCompletely(level);
+            return size_t(1);
+        });
+
+        if (board.isSolvedByRules)
+        {
+            // The last run stored the solution, which can now be placed in one go
+            runner.Run("solve/" + board.name + "/cached", [&] { level.Reset(); }, [&] {
+                level.Solve();
+                return size_t(1);
+            });
+        }
+
+        level.Reset();
+    }
+}
+
+void BenchmarkRender(BenchmarkRunner& runner, std::vector<BenchmarkBoard>& boards)
+{
+    sf::VertexArray vertices;
+    std::vector<size_t> borderRowStarts;
+    for (BenchmarkBoard& board : boards)
+    {
+        Level& level = *board.level;
+
+        // Throughput in tiles per second
+        runner.Run("render/static-vertices/" + board.name, [&] {
+            level.BuildStaticVertices(vertices, borderRowStarts);
+            return board.numTiles;
+        });
+
+        // Resetting marks every tile as dirty, i.e. the worst case where every tile has to be rewritten
+        runner.Run("render/dynamic-vertices/" + board.name, [&] { level.Reset(); }, [&] {
+            level.UpdateDynamicVertices();
+            return board.numTiles;
+        });
+    }
+}
+
+void BenchmarkCamera(BenchmarkRunner& runner)
+{
+    // Too big for the rules to be benchmarked on, so it is not one of the benchmark boards
+    Level level;
+    level.LoadFromRepr(BoardGenerator::Generate(CAMERA_BOARD_SIZE, GENERATED_BOARD_SEED + CAMERA_BOARD_SIZE));
+    if (!level.HasLoaded())
+    {
+        return;
+    }
+    level.SetSolutionCacheEnabled(false);
+
+    const std::string name = "generated-" + std::to_string(CAMERA_BOARD_SIZE) + "x" + std::to_string(CAMERA_BOARD_SIZE);
+    const size_t numTiles = static_cast<size_t>(CAMERA_BOARD_SIZE) * CAMERA_BOARD_SIZE;
+    const sf::Vector2u viewportSize(GlobalSettings::WINDOW_WIDTH, GlobalSettings::WINDOW_HEIGHT);
+    const sf::Vector2i viewportCenter(GlobalSettings::WINDOW_WIDTH / 2, GlobalSettings::WINDOW_HEIGHT / 2);
+
+    // Every tile dirty, as after a reset: throughput in tiles per second, for all of them and for those the camera shows
+    runner.Run("render/dynamic-vertices/" + name, [&] { level.Reset(); }, [&] {
+        level.UpdateDynamicVertices();
+        return numTiles;
+    });
+
+    level.UpdateCamera(viewportSize);
+    runner.Run("render/visible-vertices/" + name + "/fit", [&] { level.Reset(); }, [&] {
+        return level.UpdateVisibleDynamicVertices();
+    });
+
+    level.ZoomCamera(viewportCenter, 1.0f / level.GetCameraZoom());
+    runner.Run("render/visible-vertices/" + name + "/1:1", [&] { level.Reset(); }, [&] {
+        return level.UpdateVisibleDynamicVertices();
+    });
+}
+
+void BenchmarkOverview(BenchmarkRunner& runner, const std::vector<GridBoard>& levels)
+{
+    SessionManager manager;
+    for (const GridBoard& level : levels)
+    {
+        if (level.size <= OVERVIEW_MAX_LEVEL_SIZE)
+        {
+            manager.AddLevel(level);
+        }
+    }
+    if (manager.GetNumLevels() == 0)
+    {
+        return;
+    }
+
+    std::vector<GameSession*> players;
+    for (size_t i = 0; i < OVERVIEW_NUM_BOARDS; i++)
+    {
+        players.emplace_back(manager.GetSession(manager.CreateSession(static_cast<int>(i % manager.GetNumLevels()))));
+    }
+    const std::vector<const GameSession*> sessions(players.begin(), players.end());
+
+    BoardOverview overview;
+    overview.SetSessions(sessions);
+    const sf::Vector2u targetSize(GlobalSettings::WINDOW_WIDTH, GlobalSettings::WINDOW_HEIGHT);
+    const std::string suffix = "/" + std::to_string(OVERVIEW_NUM_BOARDS);
+
+    // Throughput in boards per second, when every board has to be written (e.g. after a resize)
+    runner.Run("render/overview-layout" + suffix, [&] {
+        overview.UpdateLayout(targetSize);
+        return overview.UpdateDynamicVertices();
+    });
+
+    // A frame of the overview with a few players moving: throughput in frames per second
+    std::mt19937 random(GENERATED_BOARD_SEED);
+    std::uniform_int_distribution<size_t> sessionDistribution(0, players.size() - 1);
+    runner.Run("render/overview-frame" + suffix, [&] {
+        for (size_t i = 0; i < OVERVIEW_MOVES_PER_FRAME; i++)
+        {
+            GameSession& session = *players[sessionDistribution(random)];
+            std::uniform_int_distribution<int> tileDistribution(0, session.GetLevel().size - 1);
+            session.ApplyMove(tileDistribution(random), tileDistribution(random), SessionMark::QUEEN);
+            session.Undo();
+        }
+        overview.UpdateDynamicVertices();
+        return size_t(1);
+    });
+}
+
+void BenchmarkThumbnails(BenchmarkRunner& runner, const std::vector<GridBoard>& levels)
+{
+    if (levels.empty() || (!runner.IsSelected("thumbnail/render") && !runner.IsSelected("thumbnail/render-png")))
+    {
+        return;
+    }
+
+    // With the queens of their solutions, as for a website; throughput in thumbnails per second, on one thread
+    std::vector<GridBoard> solvedLevels;
+    for (const GridBoard& level : levels)
+    {
+        if (level.size > THUMBNAIL_MAX_LEVEL_SIZE)
+        {
+            continue;
+        }
+
+        GridBoard solution;
+        if (GridSolver(level).Solve(1, &solution) > 0)
+        {
+            solvedLevels.emplace_back(solution);
+        }
+    }
+    if (solvedLevels.empty())
+    {
+        return;
+    }
+
+    const ThumbnailOptions options;
+    Thumbnail thumbnail;
+    std::vector<uint8_t> png;
+    runner.Run("thumbnail/render", [&] {
+        for (const GridBoard& level : solvedLevels)
+        {
+            ThumbnailRenderer::Render(level, options, thumbnail);
+        }
+        return solvedLevels.size();
+    });
+    runner.Run("thumbnail/render-png", [&] {
+        for (const GridBoard& level : solvedLevels)
+        {
+            ThumbnailRenderer::Render(level, options, thumbnail);
+            ThumbnailRenderer::EncodePng(thumbnail, png);
+        }
+        return solvedLevels.size();
+    });
+}
+
+void BenchmarkLevelIndex(BenchmarkRunner& runner)
+{
+    // A catalogue the size the level picker is meant for, of names only: the files do not exist, so the levels are all
+    // "rated" at once as unknown and this measures the search alone
+    const char* prefixes[] = {"daily-", "level-", "Weekly-"};
+    std::vector<std::string> names;
+    names.reserve(INDEX_NUM_LEVELS);
+    char name[32];
+    for (size_t i = 0; i < INDEX_NUM_LEVELS; i++)
+    {
+        std::snprintf(name, sizeof(name), "%s%06zu.txt", prefixes[i % 3], i);
+        names.emplace_back(name);
+    }
+
+    LevelIndex index;
+    index.Build(std::move(names), "bench-no-such-directory/");
+    while (index.IsRating())
+    {
+        index.Update();
+        std::this_thread::yield();
+    }
+
+    // The same search twice in a row is free, so every iteration alternates between two
+    LevelFilter filters[2];
+    filters[0].query = "level-01";
+    filters[1].query = "weekly-02";
+    runner.Run("index/search-prefix", [&] {
+        for (const LevelFilter& filter : filters)
+        {
+            index.Search(filter);
+        }
+        return size_t(2);
+    });
+
+    filters[0].mode = LevelSearchMode::CONTAINS;
+    filters[0].query = "123";
+    filters[1].mode = LevelSearchMode::CONTAINS;
+    filters[1].query = "456";
+    runner.Run("index/search-contains", [&] {
+        for (const LevelFilter& filter : filters)
+        {
+            index.Search(filter);
+        }
+        return size_t(2);
+    });
+
+    // Typing a name in, one character at a time: all but the first search refine the previous matches
+    const std::string typed = "9999";
+    LevelFilter filter;
+    filter.mode = LevelSearchMode::CONTAINS;
+    runner.Run("index/search-typing", [&] {
+        for (size_t length = 1; length <= typed.size(); length++)
+        {
+            filter.query.assign(typed, 0, length);
+            index.Search(filter);
+        }
+        return typed.size();
+    });
+}
+
+// Loads another instance of a board's level, which does not share any state with the others
+std::unique_ptr<Level> LoadIndependentLevel(const BenchmarkBoard& board)
+{
+    std::unique_ptr<Level> level = std::make_unique<Level>();
+    if (board.isGenerated)
+    {
+        level->LoadFromRepr(BoardGenerator::Generate(board.generatedSize, GENERATED_BOARD_SEED + board.generatedSize));
+    }
+    else
+    {
+        level->Load(board.name);
+    }
+    level->SetSolutionCacheEnabled(false);
+
+    return level;
+}
+
+// Replays every solve step of the levels the rules can solve, and counts the heap allocations of Solve() and Check().
+// Once the level is loaded and has gone through its steps once, they should not allocate at all: returns the number of
+// steps which did.
+size_t CheckSteadyStateAllocations(const std::vector<BenchmarkBoard>& boards)
+{
+    size_t numFailures = 0;
+    for (const BenchmarkBoard& board : boards)
+    {
+        if (!board.isSolvedByRules)
+        {
+            continue;
+        }
+
+        // Without the solution cache, which may allocate and would solve the level in one go
+        std::unique_ptr<Level> level = LoadIndependentLevel(board);
+        for (int pass = 0; pass < 2; pass++)
+        {
+            const bool isWarmup = pass == 0;
+            for (size_t step = 0; step + 1 < board.solveStates.size(); step++)
+            {
+                level->SetMarks(board.solveStates[step]);
+
+                const size_t solveAllocationsBefore = AllocationTracker::GetAllocationCount();
+                level->Solve();
+                const size_t solveAllocations = AllocationTracker::GetAllocationCount() - solveAllocationsBefore;
+
+                const size_t checkAllocationsBefore = AllocationTracker::GetAllocationCount();
+                level->Check();
+                const size_t checkAllocations = AllocationTracker::GetAllocationCount() - checkAllocationsBefore;
+
+                if (!isWarmup && (solveAllocations > 0 || checkAllocations > 0))
+                {
+                    std::fprintf(stderr, "%s, step %zu: %zu allocation(s) in Solve(), %zu in Check()\n", board.name.c_str(), step, solveAllocations, checkAllocations);
+                    numFailures++;
+                }
+            }
+        }
+    }
+
+    return numFailures;
+}
+
+// Opens a cache file whose last record was cut short (as when the program is killed while writing it), stores a
+// solution in it and reopens it: returns false if a solution stored before or after the cut got lost
+bool CheckSolutionCacheRecovery()
+{
+    const std::string filePath = (std::filesystem::temp_directory_path() / "queens_bench_solutions.bin").string();
+    std::filesystem::remove(filePath);
+
+    SolutionCache& solutionCache = SolutionCache::getInstance();
+    const QueenLayout before = {1, 3, 0, 2};
+    const QueenLayout after = {2, 0, 3, 1};
+    solutionCache.Open(filePath);
+    solutionCache.Store(1, before);
+    solutionCache.Close();
+
+    {
+        // Grid hash and number of rows of a record, with only one of its four columns
+        const unsigned char truncatedRecord[] = {2, 0, 0, 0, 0, 0, 0, 0, 4, 0, 1, 0};
+        std::ofstream file(filePath, std::ios::binary | std::ios::app);
+        file.write(reinterpret_cast<const char*>(truncatedRecord), sizeof(truncatedRecord));
+    }
+
+    solutionCache.Open(filePath);
+    solutionCache.Store(3, after);
+    solutionCache.Close();
+
+    QueenLayout layout;
+    bool isRecovered = solutionCache.Open(filePath);
+    isRecovered = isRecovered && solutionCache.Lookup(1, before.size(), before.size(), layout) && layout == before;
+    isRecovered = isRecovered && solutionCache.Lookup(3, after.size(), after.size(), layout) && layout == after;
+    solutionCache.Close();
+    std::filesystem::remove(filePath);
+
+    return isRecovered;
+}
+
+void PrintScopeAllocations()
+{
+    std::printf("\n%-8s %12s %14s\n", "Scope", "Allocations", "Bytes");
+    for (int i = 0; i < static_cast<int>(AllocationScope::COUNT); i++)
+    {
+        const AllocationScope scope = static_cast<AllocationScope>(i);
+        const AllocationCounters counters = AllocationTracker::GetScopeCounters(scope);
+        std::printf("%-8s %12zu %14zu\n", AllocationTracker::GetScopeName(scope), counters.count, counters.bytes);
+    }
+}
+
+// 1, 2, 4... up to the number of hardware threads
+std::vector<int> GetThreadCounts()
+{
+    const int numHardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    std::vector<int> threadCounts;
+    for (int numThreads = 1; numThreads < numHardwareThreads; numThreads *= 2)
+    {
+        threadCounts.emplace_back(numThreads);
+    }
+    threadCounts.emplace_back(numHardwareThreads);
+
+    return threadCounts;
+}
+
+void BenchmarkParallel(BenchmarkRunner& runner, const std::vector<BenchmarkBoard>& boards)
+{
+    const std::vector<int> threadCounts = GetThreadCounts();
+
+    // Every thread gets its own instance of every level the rules can solve, without the (shared) solution cache,
+    // so the threads never wait on each other and the throughput should grow with the number of threads
+    std::vector<const BenchmarkBoard*> solvableBoards;
+    for (const BenchmarkBoard& board : boards)
+    {
+        if (board.isSolvedByRules)
+        {
+            solvableBoards.emplace_back(&board);
+        }
+    }
+    if (solvableBoards.empty())
+    {
+        return;
+    }
+
+    std::vector<std::vector<std::unique_ptr<Level>>> threadLevels(threadCounts.back());
+    for (std::vector<std::unique_ptr<Level>>& levels : threadLevels)
+    {
+        for (const BenchmarkBoard* board : solvableBoards)
+        {
+            levels.emplace_back(LoadIndependentLevel(*board));
+        }
+    }
+
+    const auto checkLevels = [&](std::vector<std::unique_ptr<Level>>& levels) {
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            levels[i]->SetMarks(solvableBoards[i]->solveStates.back());
+            levels[i]->Check();
+        }
+    };
+    const auto solveLevels = [&](std::vector<std::unique_ptr<Level>>& levels) {
+        for (std::unique_ptr<Level>& level : levels)
+        {
+            level->Reset();
+            SolveCompletely(*level);
+        }
+    };
+    const std::pair<const char*, std::function<void(std::vector<std::unique_ptr<Level>>&)>> pipelines[] = {{"check", checkLevels}, {"solve", solveLevels}};
+
+    std::string scalingSummary;
+    for (const auto& [pipelineName, pipeline] : pipelines)
+    {
+        double singleThreadThroughput = 0.0;
+        for (const int numThreads : threadCounts)
+        {
+            // Throughput in levels per second, over all the threads
+            const std::string name = std::string("parallel/") + pipelineName + "/" + std::to_string(numThreads) + "-threads";
+            if (!runner.IsSelected(name))
+            {
+                continue;
+            }
+
+            runner.Run(name, [&] {
+                std::vector<std::thread> threads;
+                for (int thread = 0; thread < numThreads; thread++)
+                {
+                    threads.emplace_back([&, thread] { pipeline(threadLevels[thread]); });
+                }
+                for (std::thread& thread : threads)
+                {
+                    thread.join();
+                }
+                return solvableBoards.size() * numThreads;
+            });
+
+            const double throughput = runner.GetResults().back().itemsPerSecond;
+            if (numThreads == 1)
+            {
+                singleThreadThroughput = throughput;
+            }
+            else if (singleThreadThroughput > 0.0)
+            {
+                const double speedup = throughput / singleThreadThroughput;
+                char line[128];
+                std::snprintf(line, sizeof(line), "%-6s %3d threads: %5.2fx the throughput of 1 thread (%3.0f%% efficiency)\n", pipelineName, numThreads, speedup, speedup / numThreads * 100.0);
+                scalingSummary += line;
+            }
+        }
+    }
+
+    if (!scalingSummary.empty())
+    {
+        std::printf("\nParallel scaling:\n%s", scalingSummary.c_str());
+    }
+}
+
+void PrintUsage()
+{
+    std::printf(
+        "Usage: queens_bench [options]\n"
+        "  --filter <text>        only run the benchmarks whose name contains <text>\n"
+        "  --min-time <ms>        minimum time spent on each benchmark (default: 300)\n"
+        "  --min-iterations <n>   minimum iterations of each benchmark (default: 10)\n"
+        "  --json <file>          write the results to <file>\n"
+        "  --baseline <file>      compare the results with a previous --json output\n"
+        "  --threshold <percent>  slowdown of the median reported as a regression (default: 10)\n"
+        "  --replay <file>        replay a recorded input session instead of running the benchmarks\n"
+        "  --passes <n>           number of times the session is replayed (default: 20)\n"
+        "  --sessions <n>         number of game sessions of the session load (default: 10000)\n"
+        "Run it from the repository root, so the levels in %s are found.\n",
+        GlobalSettings::LEVELS_PATH);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    std::string jsonPath;
+    std::string baselinePath;
+    double thresholdPercent = 10.0;
+    std::string replayPath;
+    size_t numReplayPasses = 20;
+    size_t numSessions = 10000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+        {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+        {
+            options.minTimeMs = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--min-iterations") == 0 && hasValue)
+        {
+            options.minIterations = static_cast<size_t>(std::atol(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue)
+        {
+            baselinePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threshold") == 0 && hasValue)
+        {
+            thresholdPercent = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+        {
+            replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--passes") == 0 && hasValue)
+        {
+            numReplayPasses = std::max<size_t>(1, static_cast<size_t>(std::atol(argv[++i])));
+        }
+        else if (std::strcmp(argv[i], "--sessions") == 0 && hasValue)
+        {
+            numSessions = static_cast<size_t>(std::atol(argv[++i]));
+        }
+        else
+        {
+            PrintUsage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+        }
+    }
+
+    // The solver logs every move, which would both slow it down and clutter the results
+    Logger::getInstance().SetMinSeverity(LogSeverity::WARNING);
+
+    // Only costs a thread-local write around the load, check, solve, hint and render of a level
+    AllocationTracker::SetScopeTrackingEnabled(true);
+
+    BenchmarkRunner runner(options);
+    size_t numAllocationFailures = 0;
+    bool isSolutionCacheRecovered = true;
+
+    if (!replayPath.empty())
+    {
+        std::vector<InputEvent> events;
+        if (!InputRecorder::ReadRecording(replayPath, events))
+        {
+            std::fprintf(stderr, "Could not read recording %s\n", replayPath.c_str());
+            return 1;
+        }
+
+        BenchmarkRunner::PrintHeader();
+        ReplayRecording(runner, events, numReplayPasses);
+    }
+    else
+    {
+        const std::vector<std::string> levelFiles = ListLevelFiles();
+        if (levelFiles.empty())
+        {
+            std::fprintf(stderr, "No levels found in %s\n", GlobalSettings::LEVELS_PATH);
+        }
+        std::vector<BenchmarkBoard> boards = LoadBoards(levelFiles);
+
+        for (const BenchmarkBoard& board : boards)
+        {
+            std::printf("%-24s %5zu tiles, %4zu solver moves%s\n", board.name.c_str(), board.numTiles, board.GetNumSolveSteps(), board.isSolvedByRules ? "" : " (rules get stuck)");
+        }
+
+        numAllocationFailures = CheckSteadyStateAllocations(boards);
+        std::printf("Steady-state solve steps: %s\n", numAllocationFailures == 0 ? "no allocations" : "ALLOCATING (see above)");
+        isSolutionCacheRecovered = CheckSolutionCacheRecovery();
+        std::printf("Solution cache with a truncated record: %s\n", isSolutionCacheRecovered ? "recovered" : "RECORDS LOST");
+        std::printf("\n");
+
+        BenchmarkRunner::PrintHeader();
+        BenchmarkLoad(runner, levelFiles);
+        BenchmarkCheck(runner, boards);
+        BenchmarkRules(runner, boards, false);
+        BenchmarkRules(runner, boards, true);
+        BenchmarkSolve(runner, boards);
+        BenchmarkRender(runner, boards);
+        BenchmarkCamera(runner);
+        BenchmarkParallel(runner, boards);
+        const std::vector<GridBoard> gridBoards = LoadGridBoards(levelFiles);
+        BenchmarkOverview(runner, gridBoards);
+        BenchmarkThumbnails(runner, gridBoards);
+        BenchmarkLevelIndex(runner);
+        RunRuleVariants(runner, gridBoards);
+        RunSessionLoad(runner, gridBoards, numSessions);
+
+        PrintScopeAllocations();
+    }
+
+    if (!jsonPath.empty() && !runner.WriteJson(jsonPath))
+    {
+        std::fprintf(stderr, "Could not write %s\n", jsonPath.c_str());
+    }
+
+    if (!baselinePath.empty())
+    {
+        std::vector<BenchmarkResult> baseline;
+        if (!BenchmarkRunner::ReadJson(baselinePath, baseline))
+        {
+            std::fprintf(stderr, "Could not read baseline %s\n", baselinePath.c_str());
+            return 1;
+        }
+
+        const size_t numRegressions = runner.CompareWithBaseline(baseline, thresholdPercent);
+        if (numRegressions > 0)
+        {
+            std::printf("\n%zu benchmark(s) regressed by more than %.1f%%\n", numRegressions, thresholdPercent);
+            return 1;
+        }
+    }
+
+    if (numAllocationFailures > 0)
+    {
+        std::printf("\n%zu solve step(s) allocated once warmed up\n", numAllocationFailures);
+        return 1;
+    }
+
+    if (!isSolutionCacheRecovered)
+    {
+        std::printf("\nThe solution cache lost records after a truncated one\n");
+        return 1;
+    }
+
+    return 0;
+}
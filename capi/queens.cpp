@@ -0,0 +1,135 @@
+#include "queens.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "GridSolver.hpp"
+
+namespace
+{
+bool AreArgumentsValid(int32_t size, size_t count, const void* regions, const void* output, const void* statuses)
+{
+    return size > 0 && size <= QUEENS_MAX_SIZE && (count == 0 || (regions && output && statuses));
+}
+
+bool AreRegionsValid(int32_t size, const uint8_t* regions)
+{
+    for (int32_t i = 0; i < size * size; i++)
+    {
+        if (regions[i] >= size)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+} // namespace
+
+uint32_t queens_abi_version(void)
+{
+    return QUEENS_ABI_VERSION;
+}
+
+const char* queens_status_name(queens_status status)
+{
+    switch (status)
+    {
+    case QUEENS_OK:
+        return "ok";
+    case QUEENS_UNSOLVABLE:
+        return "unsolvable";
+    case QUEENS_INVALID:
+        return "invalid";
+    case QUEENS_BAD_BOARD:
+        return "bad board";
+    case QUEENS_BAD_ARGUMENT:
+        return "bad argument";
+    default:
+        return "unknown";
+    }
+}
+
+queens_status queens_solve_batch(int32_t size, size_t count, const uint8_t* regions, int8_t* solutions, queens_status* statuses)
+{
+    if (!AreArgumentsValid(size, count, regions, solutions, statuses))
+    {
+        return QUEENS_BAD_ARGUMENT;
+    }
+
+    // One solver per call, on the stack, reused for every board of the batch
+    GridSolver solver;
+    const size_t gridSize = static_cast<size_t>(size) * size;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t* boardRegions = regions + i * gridSize;
+        int8_t* boardSolution = solutions + i * size;
+
+        if (!AreRegionsValid(size, boardRegions))
+        {
+            statuses[i] = QUEENS_BAD_BOARD;
+        }
+        else
+        {
+            solver.SetRegions(size, boardRegions, size);
+            statuses[i] = solver.Solve(1) > 0 ? QUEENS_OK : QUEENS_UNSOLVABLE;
+        }
+
+        for (int32_t row = 0; row < size; row++)
+        {
+            boardSolution[row] = statuses[i] == QUEENS_OK ? solver.GetFirstSolution()[row] : QUEENS_NO_QUEEN;
+        }
+    }
+
+    return QUEENS_OK;
+}
+
+queens_status queens_count_solutions_batch(int32_t size, size_t count, const uint8_t* regions, uint64_t max_solutions, uint64_t* counts, queens_status* statuses)
+{
+    if (!AreArgumentsValid(size, count, regions, counts, statuses))
+    {
+        return QUEENS_BAD_ARGUMENT;
+    }
+
+    GridSolver solver;
+    const size_t gridSize = static_cast<size_t>(size) * size;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t* boardRegions = regions + i * gridSize;
+        if (!AreRegionsValid(size, boardRegions))
+        {
+            statuses[i] = QUEENS_BAD_BOARD;
+            counts[i] = 0;
+            continue;
+        }
+
+        solver.SetRegions(size, boardRegions, size);
+        counts[i] = solver.Solve(max_solutions);
+        statuses[i] = QUEENS_OK;
+    }
+
+    return QUEENS_OK;
+}
+
+queens_status queens_check_batch(int32_t size, size_t count, const uint8_t* regions, const int8_t* queens, queens_status* statuses)
+{
+    if (!AreArgumentsValid(size, count, regions, queens, statuses))
+    {
+        return QUEENS_BAD_ARGUMENT;
+    }
+
+    const size_t gridSize = static_cast<size_t>(size) * size;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t* boardRegions = regions + i * gridSize;
+        if (!AreRegionsValid(size, boardRegions))
+        {
+            statuses[i] = QUEENS_BAD_BOARD;
+            continue;
+        }
+
+        statuses[i] = GridSolver::Check(size, boardRegions, size, queens + i * size).isValid ? QUEENS_OK : QUEENS_INVALID;
+    }
+
+    return QUEENS_OK;
+}
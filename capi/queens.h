@@ -0,0 +1,66 @@
+#ifndef QUEENS_H
+#define QUEENS_H
+
+/*
+ * libqueens: the Queens solver as a plain C library, for embedding it in other languages (Python ctypes/cffi, Go cgo...).
+ *
+ * Boards are passed in batches of boards of the same size N, in arrays owned by the caller:
+ * - regions: `count` boards one after the other, each N * N region ids (0 to N - 1), row by row
+ * - queens: `count` boards one after the other, each N queen columns (one per row, QUEENS_NO_QUEEN for none)
+ * - statuses: one status per board
+ * The library never allocates nor keeps any pointer after returning, and it has no global state, so every function
+ * can be called from any number of threads at once.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#if defined(QUEENS_BUILDING_LIBRARY)
+#define QUEENS_API __declspec(dllexport)
+#else
+#define QUEENS_API __declspec(dllimport)
+#endif
+#else
+#define QUEENS_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever a function or a layout changes in a way that breaks existing callers */
+#define QUEENS_ABI_VERSION 1
+
+#define QUEENS_MAX_SIZE 36
+#define QUEENS_NO_QUEEN (-1)
+
+/* Fixed-size integer rather than an enum, so the layout of status arrays does not depend on the compiler */
+typedef int32_t queens_status;
+
+#define QUEENS_OK 0
+#define QUEENS_UNSOLVABLE 1 /* the board has no solution */
+#define QUEENS_INVALID 2 /* the queens do not make a completed level */
+#define QUEENS_BAD_BOARD 3 /* a region id is not between 0 and N - 1 */
+#define QUEENS_BAD_ARGUMENT 4 /* returned by the function itself: N out of range or a missing array */
+
+/* QUEENS_ABI_VERSION of the loaded library, to be compared with the one the caller was written against */
+QUEENS_API uint32_t queens_abi_version(void);
+
+QUEENS_API const char* queens_status_name(queens_status status);
+
+/* Solves every board: its first solution is written to `solutions` (N columns per board) and its status is
+ * QUEENS_OK, QUEENS_UNSOLVABLE or QUEENS_BAD_BOARD (the queens of unsolved boards are all QUEENS_NO_QUEEN) */
+QUEENS_API queens_status queens_solve_batch(int32_t size, size_t count, const uint8_t* regions, int8_t* solutions, queens_status* statuses);
+
+/* Counts the solutions of every board, stopping at `max_solutions`; the status is QUEENS_OK or QUEENS_BAD_BOARD */
+QUEENS_API queens_status queens_count_solutions_batch(int32_t size, size_t count, const uint8_t* regions, uint64_t max_solutions, uint64_t* counts, queens_status* statuses);
+
+/* Checks the queens of every board: QUEENS_OK if they complete the level, QUEENS_INVALID or QUEENS_BAD_BOARD otherwise */
+QUEENS_API queens_status queens_check_batch(int32_t size, size_t count, const uint8_t* regions, const int8_t* queens, queens_status* statuses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QUEENS_H */
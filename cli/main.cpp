@@ -0,0 +1,335 @@
+#include <algorithm> // std::sort, std::max
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib> // std::strtoull, std::atoi
+#include <cstring> // std::strcmp
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BoardFormat.hpp"
+#include "GridSolver.hpp"
+#include "ThumbnailRenderer.hpp"
+
+namespace
+{
+const size_t OUTPUT_FLUSH_SIZE = 1 << 16;
+
+enum class Command
+{
+    CHECK,
+    SOLVE,
+    COUNT_SOLUTIONS,
+    RATE,
+    CONVERT,
+    THUMBNAILS
+};
+
+struct Options
+{
+    Command command = Command::CHECK;
+    BoardFormat::Format outputFormat = BoardFormat::Format::PACKED;
+    uint64_t maxSolutions = 1000;
+
+    // Thumbnails
+    std::string inputDirectory;
+    std::string outputDirectory;
+    ThumbnailOptions thumbnailOptions;
+    bool drawSolutions = false;
+    int numThreads = 0; // 0 means one per hardware thread
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: queens-cli <command> [options] < boards > results\n"
+        "Boards are read from stdin, in the text format of the level files or in the packed format (one board per line),\n"
+        "and one result is written to stdout for each of them.\n"
+        "\n"
+        "Commands:\n"
+        "  check                      'valid', or 'invalid: <reason>', depending on the queens of the board\n"
+        "  solve                      the board with its first solution, or 'unsolvable'\n"
+        "  count-solutions [--max N]  the number of solutions, counting up to N (default: 1000)\n"
+        "  rate                       the difficulty: easy, medium, hard, or ambiguous/unsolvable\n"
+        "  convert                    the board, packed or as text (see --text/--packed)\n"
+        "\n"
+        "Options:\n"
+        "  --text, --packed           format of the boards written by solve and convert (default: packed)\n"
+        "\n"
+        "Usage: queens-cli thumbnails <levels directory> <output directory> [options]\n"
+        "Writes a PNG thumbnail of every board file of the directory, without any GPU.\n"
+        "  --tile <pixels>            size of the tiles (default: 12)\n"
+        "  --solutions                draws the queens of the first solution of the boards without queens\n"
+        "  --threads <n>              number of threads (default: one per hardware thread)\n");
+}
+
+bool ParseArguments(int argc, char* argv[], Options& options)
+{
+    if (argc < 2)
+    {
+        return false;
+    }
+
+    const char* command = argv[1];
+    if (std::strcmp(command, "check") == 0)
+    {
+        options.command = Command::CHECK;
+    }
+    else if (std::strcmp(command, "solve") == 0)
+    {
+        options.command = Command::SOLVE;
+    }
+    else if (std::strcmp(command, "count-solutions") == 0)
+    {
+        options.command = Command::COUNT_SOLUTIONS;
+    }
+    else if (std::strcmp(command, "rate") == 0)
+    {
+        options.command = Command::RATE;
+    }
+    else if (std::strcmp(command, "convert") == 0)
+    {
+        options.command = Command::CONVERT;
+    }
+    else if (std::strcmp(command, "thumbnails") == 0 && argc >= 4)
+    {
+        options.command = Command::THUMBNAILS;
+        options.inputDirectory = argv[2];
+        options.outputDirectory = argv[3];
+    }
+    else
+    {
+        return false;
+    }
+
+    const int firstOption = options.command == Command::THUMBNAILS ? 4 : 2;
+    for (int i = firstOption; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--text") == 0)
+        {
+            options.outputFormat = BoardFormat::Format::TEXT;
+        }
+        else if (std::strcmp(argv[i], "--packed") == 0)
+        {
+            options.outputFormat = BoardFormat::Format::PACKED;
+        }
+        else if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc)
+        {
+            options.maxSolutions = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--tile") == 0 && i + 1 < argc)
+        {
+            options.thumbnailOptions.tileSize = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--solutions") == 0)
+        {
+            options.drawSolutions = true;
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            options.numThreads = std::atoi(argv[++i]);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ProcessBoard(const Options& options, GridBoard& board, std::string& output)
+{
+    switch (options.command)
+    {
+    case Command::CHECK:
+    {
+        const GridCheckResult result = GridSolver::Check(board);
+        if (result.isValid)
+        {
+            output += "valid\n";
+        }
+        else
+        {
+            output += "invalid: ";
+            output += result.reason;
+            output += '\n';
+        }
+        break;
+    }
+    case Command::SOLVE:
+    {
+        GridSolver solver(board);
+        GridBoard solution;
+        if (solver.Solve(1, &solution) > 0)
+        {
+            BoardFormat::WriteBoard(solution, options.outputFormat, output);
+        }
+        else
+        {
+            output += "unsolvable\n";
+        }
+        break;
+    }
+    case Command::COUNT_SOLUTIONS:
+    {
+        GridSolver solver(board);
+        output += std::to_string(solver.Solve(options.maxSolutions));
+        output += '\n';
+        break;
+    }
+    case Command::RATE:
+    {
+        GridSolver solver;
+        output += GetDifficultyName(RateGrid(solver, board));
+        const GridSolverStats& stats = solver.GetStats();
+        output += " guesses=";
+        output += std::to_string(stats.guesses);
+        output += " nodes=";
+        output += std::to_string(stats.nodes);
+        output += '\n';
+        break;
+    }
+    case Command::CONVERT:
+        BoardFormat::WriteBoard(board, options.outputFormat, output);
+        break;
+    case Command::THUMBNAILS:
+        break;
+    }
+}
+
+// Renders the files of the input directory on every thread, each taking the next file not taken yet
+int WriteThumbnails(const Options& options)
+{
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(options.inputDirectory, error))
+    {
+        if (entry.is_regular_file())
+        {
+            files.emplace_back(entry.path());
+        }
+    }
+    if (error)
+    {
+        std::fprintf(stderr, "Could not read %s: %s\n", options.inputDirectory.c_str(), error.message().c_str());
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    const std::filesystem::path outputDirectory(options.outputDirectory);
+    std::filesystem::create_directories(outputDirectory, error);
+
+    const int numThreads = options.numThreads > 0 ? options.numThreads : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::atomic<size_t> nextFile{0};
+    std::atomic<size_t> numFailures{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < numThreads; thread++)
+    {
+        threads.emplace_back([&] {
+            // Every buffer is reused from board to board
+            std::string line;
+            std::string boardError;
+            GridBoard board;
+            GridSolver solver;
+            Thumbnail thumbnail;
+            std::vector<uint8_t> png;
+
+            for (size_t i = nextFile++; i < files.size(); i = nextFile++)
+            {
+                std::ifstream input(files[i]);
+                if (!BoardFormat::ReadBoard(input, line, board, boardError) || !boardError.empty())
+                {
+                    std::fprintf(stderr, "%s: %s\n", files[i].string().c_str(), boardError.empty() ? "no board" : boardError.c_str());
+                    numFailures++;
+                    continue;
+                }
+
+                if (options.drawSolutions && board.GetNumQueens() == 0)
+                {
+                    solver.SetBoard(board);
+                    solver.Solve(1, &board);
+                }
+                ThumbnailRenderer::Render(board, options.thumbnailOptions, thumbnail);
+                ThumbnailRenderer::EncodePng(thumbnail, png);
+
+                const std::filesystem::path outputPath = outputDirectory / files[i].stem().concat(".png");
+                std::ofstream output(outputPath, std::ios::binary);
+                if (!output.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size())))
+                {
+                    std::fprintf(stderr, "Could not write %s\n", outputPath.string().c_str());
+                    numFailures++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const size_t numWritten = files.size() - numFailures;
+    std::fprintf(stderr, "%zu thumbnails in %.1f ms (%.0f per second, %d threads)\n", numWritten, elapsedMs, elapsedMs > 0.0 ? numWritten * 1000.0 / elapsedMs : 0.0, numThreads);
+
+    return numFailures > 0 ? 1 : 0;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    if (options.command == Command::THUMBNAILS)
+    {
+        return WriteThumbnails(options);
+    }
+
+    std::ios::sync_with_stdio(false);
+
+    // Every buffer is reused from board to board
+    std::string line;
+    std::string error;
+    std::string output;
+    GridBoard board;
+
+    size_t boardNumber = 0;
+    bool hadErrors = false;
+    while (BoardFormat::ReadBoard(std::cin, line, board, error))
+    {
+        boardNumber++;
+
+        if (!error.empty())
+        {
+            // Keep one result per board, so results can still be matched with the input
+            output += "error: " + error + '\n';
+            std::fprintf(stderr, "Board %zu: %s\n", boardNumber, error.c_str());
+            hadErrors = true;
+        }
+        else
+        {
+            ProcessBoard(options, board, output);
+        }
+
+        if (output.size() >= OUTPUT_FLUSH_SIZE)
+        {
+            std::fwrite(output.data(), 1, output.size(), stdout);
+            output.clear();
+        }
+    }
+    std::fwrite(output.data(), 1, output.size(), stdout);
+
+    return hadErrors ? 1 : 0;
+}
@@ -0,0 +1,367 @@
+#include <algorithm> // std::sort
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib> // std::atoi, std::atof
+#include <cstring> // std::strcmp
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "BoardFormat.hpp"
+#include "GridSolver.hpp"
+#include "ServerProtocol.hpp"
+
+namespace
+{
+enum class LoadType
+{
+    SOLVE,
+    HINT,
+    VALIDATE,
+    MIX
+};
+
+struct Options
+{
+    std::string socketPath = ServerProtocol::DEFAULT_SOCKET_PATH;
+    int port = 0;
+    int numConnections = 4;
+    int depth = 16; // requests in flight per connection
+    double durationS = 5.0;
+    LoadType type = LoadType::MIX;
+    std::vector<std::string> boardFiles;
+};
+
+struct ConnectionResult
+{
+    std::vector<double> latenciesUs;
+    uint64_t numUnexpected = 0;
+    bool hasFailed = false;
+};
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: queens-loadgen [options] <board files...>\n"
+        "Sends requests for the given boards (level files or packed boards) to queens-server as fast as it answers,\n"
+        "then reports the throughput and the latency percentiles.\n"
+        "\n"
+        "Options:\n"
+        "  --socket PATH        Unix socket of the server (default: %s)\n"
+        "  --port N             connect to localhost TCP port N instead\n"
+        "  --connections N      concurrent connections, one thread each (default: 4)\n"
+        "  --depth N            requests in flight per connection (default: 16)\n"
+        "  --duration SECONDS   how long to send requests (default: 5)\n"
+        "  --type TYPE          solve, hint, validate or mix (default: mix)\n",
+        ServerProtocol::DEFAULT_SOCKET_PATH);
+}
+
+bool ParseArguments(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argument, "--socket") == 0 && hasValue)
+        {
+            options.socketPath = argv[++i];
+        }
+        else if (std::strcmp(argument, "--port") == 0 && hasValue)
+        {
+            options.port = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argument, "--connections") == 0 && hasValue)
+        {
+            options.numConnections = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argument, "--depth") == 0 && hasValue)
+        {
+            options.depth = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argument, "--duration") == 0 && hasValue)
+        {
+            options.durationS = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argument, "--type") == 0 && hasValue)
+        {
+            const char* type = argv[++i];
+            if (std::strcmp(type, "solve") == 0)
+            {
+                options.type = LoadType::SOLVE;
+            }
+            else if (std::strcmp(type, "hint") == 0)
+            {
+                options.type = LoadType::HINT;
+            }
+            else if (std::strcmp(type, "validate") == 0)
+            {
+                options.type = LoadType::VALIDATE;
+            }
+            else if (std::strcmp(type, "mix") == 0)
+            {
+                options.type = LoadType::MIX;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (argument[0] == '-')
+        {
+            return false;
+        }
+        else
+        {
+            options.boardFiles.emplace_back(argument);
+        }
+    }
+
+    return !options.boardFiles.empty() && options.numConnections > 0 && options.depth > 0;
+}
+
+// Encodes one request frame per board and type, only the request id changes when they are sent.
+// Solve and hint requests get the empty board, validate requests get it solved (locally) so they are answered OK.
+bool BuildRequestFrames(const Options& options, std::vector<std::vector<uint8_t>>& frames)
+{
+    std::vector<ServerProtocol::RequestType> types;
+    if (options.type == LoadType::SOLVE || options.type == LoadType::MIX)
+    {
+        types.push_back(ServerProtocol::RequestType::SOLVE);
+    }
+    if (options.type == LoadType::HINT || options.type == LoadType::MIX)
+    {
+        types.push_back(ServerProtocol::RequestType::HINT);
+    }
+    if (options.type == LoadType::VALIDATE || options.type == LoadType::MIX)
+    {
+        types.push_back(ServerProtocol::RequestType::VALIDATE);
+    }
+
+    std::string line;
+    std::string error;
+    GridBoard board;
+    GridBoard solution;
+    for (const std::string& boardFile : options.boardFiles)
+    {
+        std::ifstream file(boardFile);
+        if (!file.is_open())
+        {
+            std::fprintf(stderr, "Could not open %s\n", boardFile.c_str());
+            return false;
+        }
+
+        while (BoardFormat::ReadBoard(file, line, board, error))
+        {
+            if (!error.empty())
+            {
+                std::fprintf(stderr, "%s: %s\n", boardFile.c_str(), error.c_str());
+                return false;
+            }
+
+            board.ClearQueens();
+            if (GridSolver(board).Solve(1, &solution) == 0)
+            {
+                std::fprintf(stderr, "%s: skipping an unsolvable board\n", boardFile.c_str());
+                continue;
+            }
+
+            for (const ServerProtocol::RequestType type : types)
+            {
+                ServerProtocol::Request request;
+                request.type = type;
+                frames.emplace_back();
+                ServerProtocol::EncodeRequest(request, type == ServerProtocol::RequestType::VALIDATE ? solution : board, frames.back());
+            }
+        }
+    }
+
+    return !frames.empty();
+}
+
+// Keeps `depth` requests in flight on a single connection until the deadline, then waits for the last answers
+void RunConnection(const Options& options, const std::vector<std::vector<uint8_t>>& frames, size_t firstFrame, std::chrono::steady_clock::time_point deadline, ConnectionResult& result)
+{
+    const int fd = ServerProtocol::Connect(options.socketPath, options.port);
+    if (fd < 0)
+    {
+        result.hasFailed = true;
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    // Request ids cycle through the slots of the pipeline, each slot remembering when its request was sent
+    std::vector<Clock::time_point> sendTimes(options.depth);
+    std::vector<uint8_t> output;
+    std::vector<uint8_t> input;
+    size_t nextFrame = firstFrame;
+    uint32_t nextId = 0;
+    int numInFlight = 0;
+
+    const auto queueRequest = [&]() {
+        const std::vector<uint8_t>& frame = frames[nextFrame];
+        nextFrame = (nextFrame + 1) % frames.size();
+
+        const size_t offset = output.size();
+        output.insert(output.end(), frame.begin(), frame.end());
+        ServerProtocol::WriteUint32(output.data() + offset + ServerProtocol::LENGTH_SIZE, nextId);
+
+        sendTimes[nextId % options.depth] = Clock::now();
+        nextId++;
+        numInFlight++;
+    };
+
+    const auto sendAll = [&]() {
+        size_t sent = 0;
+        while (sent < output.size())
+        {
+            const ssize_t numSent = send(fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL);
+            if (numSent <= 0)
+            {
+                return false;
+            }
+            sent += static_cast<size_t>(numSent);
+        }
+        output.clear();
+
+        return true;
+    };
+
+    for (int i = 0; i < options.depth; i++)
+    {
+        queueRequest();
+    }
+
+    uint8_t buffer[64 * 1024];
+    bool isSending = sendAll();
+    while (isSending && numInFlight > 0)
+    {
+        const ssize_t numRead = read(fd, buffer, sizeof(buffer));
+        if (numRead <= 0)
+        {
+            result.hasFailed = true;
+            break;
+        }
+        input.insert(input.end(), buffer, buffer + numRead);
+
+        const Clock::time_point now = Clock::now();
+        const bool canSend = now < deadline;
+
+        size_t offset = 0;
+        size_t frameSize = 0;
+        while ((frameSize = ServerProtocol::GetFrameSize(input.data() + offset, input.size() - offset)) > 0)
+        {
+            const uint8_t* frame = input.data() + offset;
+            const uint32_t id = ServerProtocol::ReadUint32(frame + ServerProtocol::LENGTH_SIZE);
+            const auto status = static_cast<ServerProtocol::ResponseStatus>(frame[ServerProtocol::HEADER_SIZE - 2]);
+
+            result.latenciesUs.push_back(std::chrono::duration<double, std::micro>(now - sendTimes[id % options.depth]).count());
+            if (status != ServerProtocol::ResponseStatus::OK)
+            {
+                result.numUnexpected++;
+            }
+
+            numInFlight--;
+            if (canSend)
+            {
+                queueRequest();
+            }
+            offset += frameSize;
+        }
+        input.erase(input.begin(), input.begin() + offset);
+
+        isSending = sendAll();
+    }
+
+    close(fd);
+}
+
+double GetPercentile(const std::vector<double>& sortedValues, double percentile)
+{
+    const size_t rank = static_cast<size_t>(percentile / 100.0 * (sortedValues.size() - 1) + 0.5);
+    return sortedValues[rank];
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::vector<uint8_t>> frames;
+    if (!BuildRequestFrames(options, frames))
+    {
+        std::fprintf(stderr, "No board to send\n");
+        return 1;
+    }
+
+    std::vector<ConnectionResult> results(options.numConnections);
+    std::vector<std::thread> threads;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options.durationS));
+    for (int i = 0; i < options.numConnections; i++)
+    {
+        // Connections start at different boards so they do not all send the same requests at once
+        threads.emplace_back(RunConnection, std::cref(options), std::cref(frames), i * frames.size() / options.numConnections, deadline, std::ref(results[i]));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    const double elapsedS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> latenciesUs;
+    uint64_t numUnexpected = 0;
+    int numFailed = 0;
+    for (const ConnectionResult& result : results)
+    {
+        latenciesUs.insert(latenciesUs.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+        numUnexpected += result.numUnexpected;
+        numFailed += result.hasFailed ? 1 : 0;
+    }
+
+    if (numFailed > 0)
+    {
+        std::fprintf(stderr, "%d of %d connections failed\n", numFailed, options.numConnections);
+    }
+    if (latenciesUs.empty())
+    {
+        return 1;
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    double totalUs = 0.0;
+    for (const double latencyUs : latenciesUs)
+    {
+        totalUs += latencyUs;
+    }
+
+    std::printf("%zu requests in %.2f s over %d connections (depth %d): %.0f requests/s\n",
+        latenciesUs.size(), elapsedS, options.numConnections, options.depth, latenciesUs.size() / elapsedS);
+    std::printf("latency (us): mean %.1f, p50 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+        totalUs / latenciesUs.size(),
+        GetPercentile(latenciesUs, 50.0),
+        GetPercentile(latenciesUs, 99.0),
+        GetPercentile(latenciesUs, 99.9),
+        latenciesUs.back());
+    if (numUnexpected > 0)
+    {
+        std::printf("%llu responses were not OK\n", static_cast<unsigned long long>(numUnexpected));
+    }
+
+    return numFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,247 @@
+#include "ServerProtocol.hpp"
+
+#include <cstdio>
+#include <cstring> // std::memcpy, std::strncpy
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace ServerProtocol
+{
+void WriteUint32(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value);
+    data[1] = static_cast<uint8_t>(value >> 8);
+    data[2] = static_cast<uint8_t>(value >> 16);
+    data[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t ReadUint32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+size_t GetFrameSize(const uint8_t* data, size_t size)
+{
+    if (size < LENGTH_SIZE)
+    {
+        return 0;
+    }
+
+    const size_t frameSize = LENGTH_SIZE + ReadUint32(data);
+
+    return frameSize <= size ? frameSize : 0;
+}
+
+bool DecodeRequest(const uint8_t* frame, size_t frameSize, Request& request, GridBoard& board)
+{
+    if (frameSize < HEADER_SIZE)
+    {
+        return false;
+    }
+
+    request.id = ReadUint32(frame + LENGTH_SIZE);
+    request.type = static_cast<RequestType>(frame[LENGTH_SIZE + 4]);
+    const int size = frame[LENGTH_SIZE + 5];
+    if (size == 0 || size > GridBoard::MAX_SIZE || frameSize != HEADER_SIZE + size * size + size)
+    {
+        return false;
+    }
+    if (request.type != RequestType::SOLVE && request.type != RequestType::HINT && request.type != RequestType::VALIDATE)
+    {
+        return false;
+    }
+
+    board.size = size;
+    const uint8_t* regions = frame + HEADER_SIZE;
+    for (int row = 0; row < size; row++)
+    {
+        for (int column = 0; column < size; column++)
+        {
+            const uint8_t region = regions[row * size + column];
+            if (region >= size)
+            {
+                return false;
+            }
+            board.regions[row][column] = region;
+        }
+    }
+
+    const uint8_t* queens = regions + size * size;
+    for (int row = 0; row < size; row++)
+    {
+        if (queens[row] != NO_QUEEN && queens[row] >= size)
+        {
+            return false;
+        }
+        board.queens[row] = queens[row] == NO_QUEEN ? -1 : static_cast<int8_t>(queens[row]);
+    }
+
+    return true;
+}
+
+void EncodeRequest(const Request& request, const GridBoard& board, std::vector<uint8_t>& output)
+{
+    const size_t size = static_cast<size_t>(board.size);
+    const size_t frameStart = output.size();
+    output.resize(frameStart + HEADER_SIZE + size * size + size);
+
+    uint8_t* frame = output.data() + frameStart;
+    WriteUint32(frame, static_cast<uint32_t>(HEADER_SIZE - LENGTH_SIZE + size * size + size));
+    WriteUint32(frame + LENGTH_SIZE, request.id);
+    frame[LENGTH_SIZE + 4] = static_cast<uint8_t>(request.type);
+    frame[LENGTH_SIZE + 5] = static_cast<uint8_t>(size);
+
+    uint8_t* regions = frame + HEADER_SIZE;
+    for (size_t row = 0; row < size; row++)
+    {
+        std::memcpy(regions + row * size, board.regions[row].data(), size);
+    }
+
+    uint8_t* queens = regions + size * size;
+    for (size_t row = 0; row < size; row++)
+    {
+        queens[row] = board.queens[row] < 0 ? NO_QUEEN : static_cast<uint8_t>(board.queens[row]);
+    }
+}
+
+void EncodeResponse(uint32_t id, ResponseStatus status, uint8_t boardSize, const uint8_t* body, size_t bodySize, std::vector<uint8_t>& output)
+{
+    const size_t frameStart = output.size();
+    output.resize(frameStart + HEADER_SIZE + bodySize);
+
+    uint8_t* frame = output.data() + frameStart;
+    WriteUint32(frame, static_cast<uint32_t>(HEADER_SIZE - LENGTH_SIZE + bodySize));
+    WriteUint32(frame + LENGTH_SIZE, id);
+    frame[LENGTH_SIZE + 4] = static_cast<uint8_t>(status);
+    frame[LENGTH_SIZE + 5] = boardSize;
+    if (bodySize > 0)
+    {
+        std::memcpy(frame + HEADER_SIZE, body, bodySize);
+    }
+}
+
+int Listen(const std::string& socketPath, int port)
+{
+    int fd = -1;
+    if (port != 0)
+    {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        const int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+    }
+    else
+    {
+        sockaddr_un address = {};
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            return -1;
+        }
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        // A socket file left behind by a previous run would make bind fail
+        unlink(socketPath.c_str());
+
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+    }
+
+    if (listen(fd, SOMAXCONN) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int Connect(const std::string& socketPath, int port)
+{
+    int fd = -1;
+    if (port != 0)
+    {
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+
+        // Small pipelined frames must not wait for more data to be sent
+        const int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+    else
+    {
+        sockaddr_un address = {};
+        if (socketPath.size() >= sizeof(address.sun_path))
+        {
+            return -1;
+        }
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+    }
+
+    return fd;
+}
+
+bool SetNonBlocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+} // namespace ServerProtocol
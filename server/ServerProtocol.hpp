@@ -0,0 +1,66 @@
+#ifndef SERVER_PROTOCOL_HPP
+#define SERVER_PROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "GridSolver.hpp"
+
+// Binary protocol of the solve server. Every message is a frame, integers are little-endian:
+// - request:  length (u32) | request id (u32) | type (u8) | board size N (u8) | N*N region ids (u8) | N queen columns (u8, 0xFF for none)
+// - response: length (u32) | request id (u32) | status (u8) | board size N (u8) | body
+//   - SOLVE: N queen columns, HINT: row and column of the next queen (2 x u8), VALIDATE: no body
+// The length counts the bytes which follow it. Requests can be pipelined; responses keep the order of the requests
+// of each connection.
+namespace ServerProtocol
+{
+enum class RequestType : uint8_t
+{
+    SOLVE = 1,
+    HINT = 2,
+    VALIDATE = 3
+};
+
+enum class ResponseStatus : uint8_t
+{
+    OK = 0,
+    UNSOLVABLE = 1, // SOLVE and HINT: the board has no solution
+    INVALID = 2, // VALIDATE: the queens do not complete the level. HINT: every queen is already placed
+    BAD_REQUEST = 3
+};
+
+const size_t LENGTH_SIZE = 4;
+const size_t HEADER_SIZE = LENGTH_SIZE + 4 + 1 + 1;
+const size_t MAX_FRAME_SIZE = HEADER_SIZE + GridBoard::MAX_SIZE * GridBoard::MAX_SIZE + GridBoard::MAX_SIZE;
+const uint8_t NO_QUEEN = 0xFF;
+
+const char DEFAULT_SOCKET_PATH[] = "/tmp/queens.sock";
+
+struct Request
+{
+    uint32_t id = 0;
+    RequestType type = RequestType::SOLVE;
+};
+
+void WriteUint32(uint8_t* data, uint32_t value);
+uint32_t ReadUint32(const uint8_t* data);
+
+// Returns the size of the frame at the start of `data` once it has been fully received, 0 otherwise
+size_t GetFrameSize(const uint8_t* data, size_t size);
+
+// Decodes a complete request frame, returns false if it is malformed
+bool DecodeRequest(const uint8_t* frame, size_t frameSize, Request& request, GridBoard& board);
+void EncodeRequest(const Request& request, const GridBoard& board, std::vector<uint8_t>& output);
+
+// `body` is appended after the header
+void EncodeResponse(uint32_t id, ResponseStatus status, uint8_t boardSize, const uint8_t* body, size_t bodySize, std::vector<uint8_t>& output);
+
+// Listens on (or connects to) a Unix socket path, or on localhost TCP when the port is not 0; returns -1 on failure
+int Listen(const std::string& socketPath, int port);
+int Connect(const std::string& socketPath, int port);
+bool SetNonBlocking(int fd);
+} // namespace ServerProtocol
+
+#endif // SERVER_PROTOCOL_HPP
@@ -0,0 +1,384 @@
+#include "SolveServer.hpp"
+
+#include <algorithm> // std::max
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+const int POLL_TIMEOUT_MS = 200; // how often idle threads check whether the server is stopping
+const size_t READ_CHUNK_SIZE = 64 * 1024;
+} // namespace
+
+SolveServer::SolveServer(const ServerOptions& options) : m_options(options)
+{
+}
+
+SolveServer::~SolveServer()
+{
+    Stop();
+}
+
+bool SolveServer::Start()
+{
+    m_listenFd = ServerProtocol::Listen(m_options.socketPath, m_options.port);
+    if (m_listenFd < 0)
+    {
+        return false;
+    }
+
+    const int numWorkers = m_options.numWorkers > 0 ? m_options.numWorkers : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    m_running = true;
+    for (int i = 0; i < numWorkers; i++)
+    {
+        m_workers.emplace_back(std::make_unique<Worker>());
+        m_workers.back()->Start(m_running);
+    }
+    m_acceptThread = std::thread(&SolveServer::AcceptLoop, this);
+
+    return true;
+}
+
+void SolveServer::Stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    if (m_acceptThread.joinable())
+    {
+        m_acceptThread.join();
+    }
+    for (std::unique_ptr<Worker>& worker : m_workers)
+    {
+        worker->Join();
+    }
+    m_workers.clear();
+
+    close(m_listenFd);
+    m_listenFd = -1;
+    if (m_options.port == 0)
+    {
+        unlink(m_options.socketPath.c_str());
+    }
+}
+
+uint64_t SolveServer::GetNumRequests() const
+{
+    uint64_t numRequests = 0;
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+    {
+        numRequests += worker->GetNumRequests();
+    }
+
+    return numRequests;
+}
+
+uint64_t SolveServer::GetNumBatches() const
+{
+    uint64_t numBatches = 0;
+    for (const std::unique_ptr<Worker>& worker : m_workers)
+    {
+        numBatches += worker->GetNumBatches();
+    }
+
+    return numBatches;
+}
+
+void SolveServer::AcceptLoop()
+{
+    size_t nextWorker = 0;
+    while (m_running)
+    {
+        pollfd listenPollFd = {m_listenFd, POLLIN, 0};
+        if (poll(&listenPollFd, 1, POLL_TIMEOUT_MS) <= 0)
+        {
+            continue;
+        }
+
+        const int fd = accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            continue;
+        }
+
+        // Connections are spread evenly, each worker then serves its own without any locking
+        m_workers[nextWorker]->AddConnection(fd);
+        nextWorker = (nextWorker + 1) % m_workers.size();
+    }
+}
+
+// -------
+
+SolveServer::Worker::Worker()
+{
+    if (pipe(m_wakePipe) == 0)
+    {
+        ServerProtocol::SetNonBlocking(m_wakePipe[0]);
+        ServerProtocol::SetNonBlocking(m_wakePipe[1]);
+    }
+}
+
+SolveServer::Worker::~Worker()
+{
+    Join();
+
+    for (Connection& connection : m_connections)
+    {
+        close(connection.fd);
+    }
+    for (const int fd : m_pendingFds)
+    {
+        close(fd);
+    }
+    close(m_wakePipe[0]);
+    close(m_wakePipe[1]);
+}
+
+void SolveServer::Worker::Start(const std::atomic<bool>& running)
+{
+    m_thread = std::thread(&SolveServer::Worker::Loop, this, std::cref(running));
+}
+
+void SolveServer::Worker::Join()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void SolveServer::Worker::AddConnection(int fd)
+{
+    ServerProtocol::SetNonBlocking(fd);
+
+    {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pendingFds.emplace_back(fd);
+    }
+
+    const char wake = 1;
+    (void)write(m_wakePipe[1], &wake, 1);
+}
+
+void SolveServer::Worker::Loop(const std::atomic<bool>& running)
+{
+    while (running)
+    {
+        // The wake pipe comes first, then every connection (waiting to write too if a previous write was partial)
+        m_pollFds.clear();
+        m_pollFds.push_back({m_wakePipe[0], POLLIN, 0});
+        for (const Connection& connection : m_connections)
+        {
+            const short events = connection.outputSent < connection.output.size() ? (POLLIN | POLLOUT) : POLLIN;
+            m_pollFds.push_back({connection.fd, events, 0});
+        }
+
+        if (poll(m_pollFds.data(), m_pollFds.size(), POLL_TIMEOUT_MS) <= 0)
+        {
+            continue;
+        }
+
+        // Read from every ready connection first, then answer everything received in one batch, then write
+        const size_t numConnections = m_connections.size();
+        for (size_t i = 0; i < numConnections; i++)
+        {
+            const short revents = m_pollFds[i + 1].revents;
+            if (revents & (POLLIN | POLLHUP | POLLERR))
+            {
+                ReadConnection(m_connections[i]);
+            }
+        }
+
+        size_t numRequests = 0;
+        for (Connection& connection : m_connections)
+        {
+            numRequests += ProcessRequests(connection);
+        }
+        if (numRequests > 0)
+        {
+            m_numRequests.fetch_add(numRequests, std::memory_order_relaxed);
+            m_numBatches.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        for (Connection& connection : m_connections)
+        {
+            WriteConnection(connection);
+        }
+
+        // Forget the closed connections
+        for (size_t i = m_connections.size(); i-- > 0;)
+        {
+            if (m_connections[i].isClosed)
+            {
+                close(m_connections[i].fd);
+                m_connections[i] = std::move(m_connections.back());
+                m_connections.pop_back();
+            }
+        }
+
+        if (m_pollFds[0].revents & POLLIN)
+        {
+            AdoptPendingConnections();
+        }
+    }
+}
+
+void SolveServer::Worker::AdoptPendingConnections()
+{
+    char wake[64];
+    while (read(m_wakePipe[0], wake, sizeof(wake)) > 0)
+    {
+    }
+
+    std::lock_guard<std::mutex> lock(m_pendingMutex);
+    for (const int fd : m_pendingFds)
+    {
+        Connection connection;
+        connection.fd = fd;
+        m_connections.emplace_back(std::move(connection));
+    }
+    m_pendingFds.clear();
+}
+
+void SolveServer::Worker::ReadConnection(Connection& connection)
+{
+    for (;;)
+    {
+        const size_t previousSize = connection.input.size();
+        connection.input.resize(previousSize + READ_CHUNK_SIZE);
+
+        const ssize_t numRead = read(connection.fd, connection.input.data() + previousSize, READ_CHUNK_SIZE);
+        connection.input.resize(previousSize + (numRead > 0 ? static_cast<size_t>(numRead) : 0));
+
+        if (numRead > 0)
+        {
+            continue;
+        }
+        if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            return;
+        }
+
+        // End of stream or error
+        connection.isClosed = true;
+        return;
+    }
+}
+
+size_t SolveServer::Worker::ProcessRequests(Connection& connection)
+{
+    size_t numRequests = 0;
+    size_t offset = 0;
+    for (;;)
+    {
+        const uint8_t* data = connection.input.data() + offset;
+        const size_t available = connection.input.size() - offset;
+
+        // A frame bigger than any valid request means the stream cannot be trusted anymore
+        if (available >= ServerProtocol::LENGTH_SIZE && ServerProtocol::LENGTH_SIZE + ServerProtocol::ReadUint32(data) > ServerProtocol::MAX_FRAME_SIZE)
+        {
+            connection.isClosed = true;
+            break;
+        }
+
+        const size_t frameSize = ServerProtocol::GetFrameSize(data, available);
+        if (frameSize == 0)
+        {
+            break;
+        }
+
+        HandleRequest(data, frameSize, connection.output);
+        offset += frameSize;
+        numRequests++;
+    }
+
+    // Keep the start of an incomplete frame for the next round
+    connection.input.erase(connection.input.begin(), connection.input.begin() + offset);
+
+    return numRequests;
+}
+
+void SolveServer::Worker::WriteConnection(Connection& connection)
+{
+    while (connection.outputSent < connection.output.size() && !connection.isClosed)
+    {
+        const ssize_t numSent = send(connection.fd, connection.output.data() + connection.outputSent, connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (numSent > 0)
+        {
+            connection.outputSent += static_cast<size_t>(numSent);
+        }
+        else if (numSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            // The rest is sent once the socket is writable again
+            return;
+        }
+        else
+        {
+            connection.isClosed = true;
+        }
+    }
+
+    connection.output.clear();
+    connection.outputSent = 0;
+}
+
+void SolveServer::Worker::HandleRequest(const uint8_t* frame, size_t frameSize, std::vector<uint8_t>& output)
+{
+    ServerProtocol::Request request;
+    if (!ServerProtocol::DecodeRequest(frame, frameSize, request, m_board))
+    {
+        const uint32_t id = frameSize >= ServerProtocol::HEADER_SIZE ? ServerProtocol::ReadUint32(frame + ServerProtocol::LENGTH_SIZE) : 0;
+        ServerProtocol::EncodeResponse(id, ServerProtocol::ResponseStatus::BAD_REQUEST, 0, nullptr, 0, output);
+        return;
+    }
+
+    const uint8_t size = static_cast<uint8_t>(m_board.size);
+
+    if (request.type == ServerProtocol::RequestType::VALIDATE)
+    {
+        const bool isValid = GridSolver::Check(m_board).isValid;
+        ServerProtocol::EncodeResponse(request.id, isValid ? ServerProtocol::ResponseStatus::OK : ServerProtocol::ResponseStatus::INVALID, size, nullptr, 0, output);
+        return;
+    }
+
+    m_solver.SetBoard(m_board);
+    if (m_solver.Solve(1, &m_solution) == 0)
+    {
+        ServerProtocol::EncodeResponse(request.id, ServerProtocol::ResponseStatus::UNSOLVABLE, size, nullptr, 0, output);
+        return;
+    }
+
+    if (request.type == ServerProtocol::RequestType::SOLVE)
+    {
+        uint8_t queens[GridBoard::MAX_SIZE];
+        for (int row = 0; row < m_solution.size; row++)
+        {
+            queens[row] = static_cast<uint8_t>(m_solution.queens[row]);
+        }
+        ServerProtocol::EncodeResponse(request.id, ServerProtocol::ResponseStatus::OK, size, queens, size, output);
+        return;
+    }
+
+    // Hint: the first row whose queen is missing or misplaced
+    for (int row = 0; row < m_board.size; row++)
+    {
+        if (m_board.queens[row] != m_solution.queens[row])
+        {
+            const uint8_t hint[2] = {static_cast<uint8_t>(row), static_cast<uint8_t>(m_solution.queens[row])};
+            ServerProtocol::EncodeResponse(request.id, ServerProtocol::ResponseStatus::OK, size, hint, sizeof(hint), output);
+            return;
+        }
+    }
+    ServerProtocol::EncodeResponse(request.id, ServerProtocol::ResponseStatus::INVALID, size, nullptr, 0, output);
+}
@@ -0,0 +1,103 @@
+#ifndef SOLVE_SERVER_HPP
+#define SOLVE_SERVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+#include "GridSolver.hpp"
+#include "ServerProtocol.hpp"
+
+struct ServerOptions
+{
+    std::string socketPath = ServerProtocol::DEFAULT_SOCKET_PATH;
+    int port = 0; // localhost TCP instead of the Unix socket when not 0
+    int numWorkers = 0; // one per core when 0
+};
+
+// Long-running solve server. Every worker thread owns a share of the connections and handles them on its own:
+// each round it reads whatever every ready connection has sent, answers all the complete requests as one batch
+// with its preallocated scratch boards, then writes each connection's responses in a single call
+class SolveServer
+{
+public:
+    explicit SolveServer(const ServerOptions& options);
+    ~SolveServer();
+
+    bool Start();
+    void Stop();
+
+    uint64_t GetNumRequests() const;
+    uint64_t GetNumBatches() const;
+    size_t GetNumWorkers() const { return m_workers.size(); }
+
+    SolveServer(const SolveServer&) = delete;
+    SolveServer& operator =(const SolveServer&) = delete;
+
+private:
+    class Worker
+    {
+    public:
+        Worker();
+        ~Worker();
+
+        void Start(const std::atomic<bool>& running);
+        void Join();
+
+        // Called from the accepting thread
+        void AddConnection(int fd);
+
+        uint64_t GetNumRequests() const { return m_numRequests.load(std::memory_order_relaxed); }
+        uint64_t GetNumBatches() const { return m_numBatches.load(std::memory_order_relaxed); }
+
+    private:
+        struct Connection
+        {
+            int fd = -1;
+            std::vector<uint8_t> input;
+            std::vector<uint8_t> output;
+            size_t outputSent = 0;
+            bool isClosed = false;
+        };
+
+        std::thread m_thread;
+        std::vector<Connection> m_connections;
+        std::vector<pollfd> m_pollFds;
+
+        // New connections are handed over through this list, and the worker is woken up through the pipe
+        std::mutex m_pendingMutex;
+        std::vector<int> m_pendingFds;
+        int m_wakePipe[2] = {-1, -1};
+
+        // Scratch state, reused by every request of this worker
+        GridBoard m_board;
+        GridBoard m_solution;
+        GridSolver m_solver;
+
+        std::atomic<uint64_t> m_numRequests{0};
+        std::atomic<uint64_t> m_numBatches{0};
+
+        void Loop(const std::atomic<bool>& running);
+        void AdoptPendingConnections();
+        void ReadConnection(Connection& connection);
+        size_t ProcessRequests(Connection& connection);
+        void WriteConnection(Connection& connection);
+        void HandleRequest(const uint8_t* frame, size_t frameSize, std::vector<uint8_t>& output);
+    };
+
+    ServerOptions m_options;
+    int m_listenFd = -1;
+    std::atomic<bool> m_running{false};
+    std::thread m_acceptThread;
+    std::vector<std::unique_ptr<Worker>> m_workers;
+
+    void AcceptLoop();
+};
+
+#endif // SOLVE_SERVER_HPP
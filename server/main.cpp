@@ -0,0 +1,134 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib> // std::atoi
+#include <cstring> // std::strcmp
+#include <thread>
+
+#include "SolveServer.hpp"
+
+namespace
+{
+const int STATS_INTERVAL_S = 5;
+
+std::atomic<bool> stopRequested{false};
+
+void HandleStopSignal(int)
+{
+    stopRequested = true;
+}
+
+void PrintUsage()
+{
+    std::fprintf(stderr,
+        "Usage: queens-server [options]\n"
+        "Answers solve, hint and validate requests (see ServerProtocol.hpp) until interrupted.\n"
+        "\n"
+        "Options:\n"
+        "  --socket PATH   Unix socket to listen on (default: %s)\n"
+        "  --port N        listen on localhost TCP port N instead\n"
+        "  --threads N     number of worker threads (default: one per core)\n",
+        ServerProtocol::DEFAULT_SOCKET_PATH);
+}
+
+bool ParseArguments(int argc, char* argv[], ServerOptions& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argument, "--socket") == 0 && hasValue)
+        {
+            options.socketPath = argv[++i];
+        }
+        else if (std::strcmp(argument, "--port") == 0 && hasValue)
+        {
+            options.port = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argument, "--threads") == 0 && hasValue)
+        {
+            options.numWorkers = std::atoi(argv[++i]);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    ServerOptions options;
+    if (!ParseArguments(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    SolveServer server(options);
+    if (!server.Start())
+    {
+        if (options.port != 0)
+        {
+            std::fprintf(stderr, "Could not listen on port %d\n", options.port);
+        }
+        else
+        {
+            std::fprintf(stderr, "Could not listen on %s\n", options.socketPath.c_str());
+        }
+        return 1;
+    }
+
+    if (options.port != 0)
+    {
+        std::printf("Listening on localhost:%d with %zu worker threads\n", options.port, server.GetNumWorkers());
+    }
+    else
+    {
+        std::printf("Listening on %s with %zu worker threads\n", options.socketPath.c_str(), server.GetNumWorkers());
+    }
+    std::fflush(stdout);
+
+    // Report the throughput, and how many requests were answered per batch, every few seconds
+    uint64_t lastRequests = 0;
+    uint64_t lastBatches = 0;
+    auto lastReport = std::chrono::steady_clock::now();
+    while (!stopRequested)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsedS = std::chrono::duration<double>(now - lastReport).count();
+        if (elapsedS < STATS_INTERVAL_S)
+        {
+            continue;
+        }
+
+        const uint64_t numRequests = server.GetNumRequests();
+        const uint64_t numBatches = server.GetNumBatches();
+        if (numRequests != lastRequests)
+        {
+            std::printf("%.0f requests/s, %.1f requests per batch\n",
+                (numRequests - lastRequests) / elapsedS,
+                static_cast<double>(numRequests - lastRequests) / (numBatches - lastBatches));
+            std::fflush(stdout);
+        }
+
+        lastRequests = numRequests;
+        lastBatches = numBatches;
+        lastReport = now;
+    }
+
+    std::printf("Stopping after %llu requests\n", static_cast<unsigned long long>(server.GetNumRequests()));
+    server.Stop();
+
+    return 0;
+}
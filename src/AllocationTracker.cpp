@@ -0,0 +1,132 @@
+#include "AllocationTracker.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+const int NO_SCOPE = -1;
+
+struct AtomicCounters
+{
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> bytes{0};
+};
+
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+
+std::atomic<bool> isScopeTrackingEnabled{false};
+std::array<AtomicCounters, static_cast<size_t>(AllocationScope::COUNT)> scopeCounters;
+thread_local int currentScope = NO_SCOPE; // only set while scope tracking is enabled
+} // namespace
+
+namespace AllocationTracker
+{
+size_t GetAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+size_t GetAllocatedBytes()
+{
+    return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+bool IsScopeTrackingEnabled()
+{
+    return isScopeTrackingEnabled.load(std::memory_order_relaxed);
+}
+
+void SetScopeTrackingEnabled(bool enabled)
+{
+    isScopeTrackingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+AllocationCounters GetScopeCounters(AllocationScope scope)
+{
+    const AtomicCounters& counters = scopeCounters[static_cast<size_t>(scope)];
+
+    AllocationCounters result;
+    result.count = counters.count.load(std::memory_order_relaxed);
+    result.bytes = counters.bytes.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+void ResetScopeCounters()
+{
+    for (AtomicCounters& counters : scopeCounters)
+    {
+        counters.count = 0;
+        counters.bytes = 0;
+    }
+}
+
+const char* GetScopeName(AllocationScope scope)
+{
+    switch (scope)
+    {
+    case AllocationScope::LOAD:
+        return "Load";
+    case AllocationScope::CHECK:
+        return "Check";
+    case AllocationScope::SOLVE:
+        return "Solve";
+    case AllocationScope::HINT:
+        return "Hint";
+    case AllocationScope::RENDER:
+        return "Render";
+    default:
+        return "Unknown";
+    }
+}
+
+int EnterScope(AllocationScope scope)
+{
+    const int previousScope = currentScope;
+    if (IsScopeTrackingEnabled())
+    {
+        currentScope = static_cast<int>(scope);
+    }
+
+    return previousScope;
+}
+
+void LeaveScope(int previousScope)
+{
+    currentScope = previousScope;
+}
+} // namespace AllocationTracker
+
+// The array and nothrow forms of operator new/delete call these ones by default, so replacing them is enough
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (currentScope != NO_SCOPE)
+    {
+        AtomicCounters& counters = scopeCounters[currentScope];
+        counters.count.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    if (void* ptr = std::malloc(size > 0 ? size : 1))
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,56 @@
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <cstddef>
+
+// Parts of the program whose allocations can be counted on their own
+enum class AllocationScope
+{
+    LOAD,
+    CHECK,
+    SOLVE,
+    HINT,
+    RENDER,
+    COUNT
+};
+
+struct AllocationCounters
+{
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+// Process-wide heap allocation counters, fed by the replacement of the global operator new
+namespace AllocationTracker
+{
+size_t GetAllocationCount();
+size_t GetAllocatedBytes();
+
+// Per-scope counters, off by default: while enabled, the allocations made inside a ScopedAllocations are also counted
+// for its scope (the innermost one, e.g. the check which ends a solve step is counted as CHECK, not SOLVE)
+bool IsScopeTrackingEnabled();
+void SetScopeTrackingEnabled(bool enabled);
+AllocationCounters GetScopeCounters(AllocationScope scope);
+void ResetScopeCounters();
+const char* GetScopeName(AllocationScope scope);
+
+// Used by ScopedAllocations: makes `scope` the current scope of this thread, returns the previous one
+int EnterScope(AllocationScope scope);
+void LeaveScope(int previousScope);
+} // namespace AllocationTracker
+
+// Counts the allocations made in its scope; when scope tracking is disabled it only costs a relaxed atomic load
+class ScopedAllocations
+{
+public:
+    explicit ScopedAllocations(AllocationScope scope) : m_previousScope(AllocationTracker::EnterScope(scope)) {}
+    ~ScopedAllocations() { AllocationTracker::LeaveScope(m_previousScope); }
+
+    ScopedAllocations(const ScopedAllocations&) = delete;
+    ScopedAllocations& operator =(const ScopedAllocations&) = delete;
+
+private:
+    int m_previousScope;
+};
+
+#endif // ALLOCATION_TRACKER_HPP
@@ -0,0 +1,100 @@
+#include "BackgroundSolver.hpp"
+
+#include <chrono>
+#include <thread>
+
+#include "GlobalSettings.hpp"
+#include "Log.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+float ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+} // namespace
+
+BackgroundSolver::~BackgroundSolver()
+{
+    Cancel();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool BackgroundSolver::Start(const GridBoard& board, BackgroundSolveMode mode, uint64_t maxSolutions, int timeBudgetMs)
+{
+    if (IsRunning())
+    {
+        return false;
+    }
+
+    m_mode = mode;
+    m_isCancelRequested = false;
+    m_hasFinished = false;
+    m_progress.Reset(BackgroundSolveProgress());
+
+    const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeBudgetMs);
+    m_thread = std::thread(&BackgroundSolver::Run, this, board, mode == BackgroundSolveMode::SOLVE ? 1 : maxSolutions, deadline);
+
+    return true;
+}
+
+void BackgroundSolver::Cancel()
+{
+    m_isCancelRequested = true;
+}
+
+bool BackgroundSolver::TakeResult(BackgroundSolveResult& result)
+{
+    if (!m_hasFinished.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    m_thread.join();
+    m_hasFinished = false;
+    result = m_result;
+
+    return true;
+}
+
+void BackgroundSolver::Run(GridBoard board, uint64_t maxSolutions, Clock::time_point deadline)
+{
+    const Clock::time_point start = Clock::now();
+    bool hasTimedOut = false;
+
+    // Runs on the worker thread every few thousand placements: publish the progress, and stop if we have to
+    m_solver.SetProgressCallback([&](const GridSolverProgress& solverProgress) {
+        BackgroundSolveProgress& progress = m_progress.GetWriteBuffer();
+        progress.solver = solverProgress;
+        progress.elapsedMs = ElapsedMs(start);
+        m_progress.Publish();
+
+        hasTimedOut = Clock::now() >= deadline;
+        return !hasTimedOut && !m_isCancelRequested.load(std::memory_order_relaxed);
+    }, PROGRESS_INTERVAL_NODES);
+
+    board.ClearQueens();
+    m_solver.SetBoard(board);
+
+    m_result = BackgroundSolveResult();
+    m_result.mode = m_mode;
+    m_result.numSolutions = m_solver.Solve(maxSolutions, &m_result.solution);
+    m_result.stats = m_solver.GetStats();
+    m_result.elapsedMs = ElapsedMs(start);
+    if (m_solver.WasStopped())
+    {
+        m_result.outcome = hasTimedOut ? BackgroundSolveOutcome::TIMED_OUT : BackgroundSolveOutcome::CANCELLED;
+    }
+
+    LOG_INFO(SOLVE) << "Background solve ended after " << m_result.elapsedMs << " ms: " << m_result.numSolutions << " solution(s), " << m_result.stats.nodes << " nodes";
+
+    m_hasFinished.store(true, std::memory_order_release);
+
+    // The window may be waiting for input, wake it up so the result is applied right away
+    GlobalSettings::REDRAW_REQUESTED = true;
+}
@@ -0,0 +1,85 @@
+#ifndef BACKGROUND_SOLVER_HPP
+#define BACKGROUND_SOLVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "GridSolver.hpp"
+#include "TripleBuffer.hpp"
+
+enum class BackgroundSolveMode
+{
+    SOLVE, // find a solution
+    COUNT_SOLUTIONS // e.g. to know whether the solution is unique
+};
+
+enum class BackgroundSolveOutcome
+{
+    FINISHED, // the search went as far as it had to
+    CANCELLED,
+    TIMED_OUT
+};
+
+struct BackgroundSolveProgress
+{
+    GridSolverProgress solver;
+    float elapsedMs = 0.0f;
+};
+
+struct BackgroundSolveResult
+{
+    BackgroundSolveMode mode = BackgroundSolveMode::SOLVE;
+    BackgroundSolveOutcome outcome = BackgroundSolveOutcome::FINISHED;
+    uint64_t numSolutions = 0;
+    GridBoard solution; // the first one found, if any
+    GridSolverStats stats;
+    float elapsedMs = 0.0f;
+};
+
+// Runs the exhaustive solver on a worker thread, so long searches (big boards, counting solutions) never freeze the window.
+// The worker publishes its progress through a triple buffer, which the UI reads every frame without ever waiting,
+// and the result is handed over once the search has ended, to be applied on the main thread in one go.
+// Every member function is meant to be called from the main thread.
+class BackgroundSolver
+{
+public:
+    BackgroundSolver() = default;
+    ~BackgroundSolver();
+
+    BackgroundSolver(const BackgroundSolver&) = delete;
+    BackgroundSolver& operator =(const BackgroundSolver&) = delete;
+
+    // Returns false if a search is already running
+    bool Start(const GridBoard& board, BackgroundSolveMode mode, uint64_t maxSolutions, int timeBudgetMs);
+    void Cancel();
+
+    // Running, or finished with a result not taken yet
+    bool IsRunning() const { return m_thread.joinable(); }
+    BackgroundSolveMode GetMode() const { return m_mode; }
+
+    // Latest progress published by the worker
+    const BackgroundSolveProgress& GetProgress() { return m_progress.Read(); }
+
+    // Returns true, once, when the search has ended
+    bool TakeResult(BackgroundSolveResult& result);
+
+private:
+    static const uint64_t PROGRESS_INTERVAL_NODES = 16384;
+
+    std::thread m_thread;
+    BackgroundSolveMode m_mode = BackgroundSolveMode::SOLVE;
+    std::atomic<bool> m_isCancelRequested{false};
+    std::atomic<bool> m_hasFinished{false};
+
+    // Written by the worker only, read once m_hasFinished is set
+    GridSolver m_solver;
+    BackgroundSolveResult m_result;
+
+    TripleBuffer<BackgroundSolveProgress> m_progress;
+
+    void Run(GridBoard board, uint64_t maxSolutions, std::chrono::steady_clock::time_point deadline);
+};
+
+#endif // BACKGROUND_SOLVER_HPP
@@ -0,0 +1,289 @@
+#include "BoardFormat.hpp"
+
+#include <fstream>
+#include <istream>
+#include <string>
+
+namespace
+{
+bool ParsePacked(const std::string& line, GridBoard& board, std::string& error)
+{
+    const size_t sizeEnd = line.find(':');
+
+    int size = 0;
+    for (size_t i = 0; i < sizeEnd; i++)
+    {
+        if (line[i] < '0' || line[i] > '9' || size > GridBoard::MAX_SIZE)
+        {
+            error = "invalid board size";
+            return false;
+        }
+        size = size * 10 + (line[i] - '0');
+    }
+    if (size <= 0 || size > GridBoard::MAX_SIZE)
+    {
+        error = "invalid board size";
+        return false;
+    }
+
+    const size_t regionsStart = sizeEnd + 1;
+    size_t regionsEnd = line.find(':', regionsStart);
+    if (regionsEnd == std::string::npos)
+    {
+        regionsEnd = line.size();
+    }
+    if (regionsEnd - regionsStart != static_cast<size_t>(size * size))
+    {
+        error = "expected " + std::to_string(size * size) + " regions";
+        return false;
+    }
+
+    board.size = size;
+    board.ClearQueens();
+    for (int row = 0; row < size; row++)
+    {
+        for (int column = 0; column < size; column++)
+        {
+            const int region = BoardFormat::CharToRegion(line[regionsStart + row * size + column]);
+            if (region < 0 || region >= size)
+            {
+                error = "invalid region";
+                return false;
+            }
+            board.regions[row][column] = static_cast<uint8_t>(region);
+        }
+    }
+
+    if (regionsEnd == line.size())
+    {
+        return true;
+    }
+
+    const size_t queensStart = regionsEnd + 1;
+    if (line.size() - queensStart != static_cast<size_t>(size))
+    {
+        error = "expected " + std::to_string(size) + " queen columns";
+        return false;
+    }
+    for (int row = 0; row < size; row++)
+    {
+        const char character = line[queensStart + row];
+        if (character == '-')
+        {
+            continue;
+        }
+
+        const int column = BoardFormat::CharToRegion(character);
+        if (column < 0 || column >= size)
+        {
+            error = "invalid queen column";
+            return false;
+        }
+        board.queens[row] = static_cast<int8_t>(column);
+    }
+
+    return true;
+}
+
+bool ParseTextRow(const std::string& line, int row, GridBoard& board, std::string& error)
+{
+    const size_t regionsEnd = line.find(' ');
+    const size_t numRegions = regionsEnd == std::string::npos ? line.size() : regionsEnd;
+
+    // The first row gives the size of the board
+    if (row == 0)
+    {
+        if (numRegions == 0 || numRegions > static_cast<size_t>(GridBoard::MAX_SIZE))
+        {
+            error = "invalid board size";
+            return false;
+        }
+        board.size = static_cast<int>(numRegions);
+        board.ClearQueens();
+    }
+    if (numRegions != static_cast<size_t>(board.size))
+    {
+        error = "row " + std::to_string(row + 1) + " does not have " + std::to_string(board.size) + " regions";
+        return false;
+    }
+
+    for (int column = 0; column < board.size; column++)
+    {
+        const int region = BoardFormat::CharToRegion(line[column]);
+        if (region < 0 || region >= board.size)
+        {
+            error = "invalid region in row " + std::to_string(row + 1);
+            return false;
+        }
+        board.regions[row][column] = static_cast<uint8_t>(region);
+    }
+
+    if (regionsEnd == std::string::npos)
+    {
+        return true;
+    }
+
+    const size_t marksStart = regionsEnd + 1;
+    for (int column = 0; column < board.size && marksStart + column < line.size(); column++)
+    {
+        if (line[marksStart + column] == 'Q')
+        {
+            if (board.queens[row] >= 0)
+            {
+                // Boards have at most one queen per row in this representation
+                error = "two queens in row " + std::to_string(row + 1);
+                return false;
+            }
+            board.queens[row] = static_cast<int8_t>(column);
+        }
+    }
+
+    return true;
+}
+} // namespace
+
+namespace BoardFormat
+{
+bool ReadBoard(std::istream& input, std::string& line, GridBoard& board, std::string& error)
+{
+    error.clear();
+
+    int row = 0;
+    while (std::getline(input, line))
+    {
+        // Level files written on Windows
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        if (line.empty())
+        {
+            if (row == 0)
+            {
+                continue;
+            }
+            error = "board ended after " + std::to_string(row) + " rows";
+            return true;
+        }
+
+        if (row == 0 && line.find(':') != std::string::npos)
+        {
+            ParsePacked(line, board, error);
+            return true;
+        }
+
+        if (!ParseTextRow(line, row, board, error))
+        {
+            // Skip the rest of the board, so the next one can still be read
+            while (std::getline(input, line) && !line.empty() && line != "\r")
+            {
+            }
+            return true;
+        }
+
+        row++;
+        if (row == board.size)
+        {
+            return true;
+        }
+    }
+
+    if (row > 0)
+    {
+        error = "board ended after " + std::to_string(row) + " rows";
+        return true;
+    }
+
+    return false;
+}
+
+bool ReadBoardFile(const std::string& filePath, std::string& line, GridBoard& board, std::string& error)
+{
+    std::ifstream file(filePath);
+    if (!file.is_open())
+    {
+        error = "could not be opened";
+        return false;
+    }
+
+    if (!ReadBoard(file, line, board, error))
+    {
+        error = "no board";
+        return false;
+    }
+
+    return error.empty();
+}
+
+void WriteBoard(const GridBoard& board, Format format, std::string& output)
+{
+    const bool hasQueens = board.GetNumQueens() > 0;
+
+    if (format == Format::PACKED)
+    {
+        output += std::to_string(board.size);
+        output += ':';
+        for (int row = 0; row < board.size; row++)
+        {
+            for (int column = 0; column < board.size; column++)
+            {
+                output += RegionToChar(board.regions[row][column]);
+            }
+        }
+        if (hasQueens)
+        {
+            output += ':';
+            for (int row = 0; row < board.size; row++)
+            {
+                output += board.queens[row] >= 0 ? RegionToChar(board.queens[row]) : '-';
+            }
+        }
+        output += '\n';
+
+        return;
+    }
+
+    for (int row = 0; row < board.size; row++)
+    {
+        for (int column = 0; column < board.size; column++)
+        {
+            output += RegionToChar(board.regions[row][column]);
+        }
+        if (hasQueens)
+        {
+            output += ' ';
+            for (int column = 0; column < board.size; column++)
+            {
+                output += board.queens[row] == column ? 'Q' : '.';
+            }
+        }
+        output += '\n';
+    }
+    // Boards are separated by a blank line
+    output += '\n';
+}
+
+int CharToRegion(char character)
+{
+    if (character >= '0' && character <= '9')
+    {
+        return character - '0';
+    }
+    if (character >= 'A' && character <= 'Z')
+    {
+        return 10 + (character - 'A');
+    }
+    if (character >= 'a' && character <= 'z')
+    {
+        return 10 + (character - 'a');
+    }
+
+    return -1;
+}
+
+char RegionToChar(int region)
+{
+    return static_cast<char>(region < 10 ? '0' + region : 'A' + (region - 10));
+}
+} // namespace BoardFormat
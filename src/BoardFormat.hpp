@@ -0,0 +1,37 @@
+#ifndef BOARD_FORMAT_HPP
+#define BOARD_FORMAT_HPP
+
+#include <istream>
+#include <string>
+
+#include "GridSolver.hpp"
+
+// Boards can be written in two formats, each region id being a single base 36 character (0-9, then A-Z):
+// - text: the format of the level files, one line per row, optionally followed by a space and the marks of the row
+//   ('Q' for a queen, '.' otherwise), e.g. "00110222 ..Q....."
+// - packed: a whole board in a single line, "<size>:<regions row by row>[:<queen column of each row, '-' for none>]"
+//   e.g. "4:0012012203330333:1302"
+namespace BoardFormat
+{
+enum class Format
+{
+    TEXT,
+    PACKED
+};
+
+// Reads the next board, whatever its format (blank lines between boards are skipped).
+// Returns false at the end of the input, or with `error` set if the board is malformed.
+// `line` is only a buffer, passed in so reading many boards does not allocate.
+bool ReadBoard(std::istream& input, std::string& line, GridBoard& board, std::string& error);
+// Reads the board of a level file, the one loader of the game, its level index and its thumbnails, so they always
+// agree. Returns false with `error` set if the file cannot be opened or has no valid board.
+bool ReadBoardFile(const std::string& filePath, std::string& line, GridBoard& board, std::string& error);
+
+// Appends the board to `output`, with its queens if it has any
+void WriteBoard(const GridBoard& board, Format format, std::string& output);
+
+int CharToRegion(char character); // -1 if it is not a region character
+char RegionToChar(int region);
+} // namespace BoardFormat
+
+#endif // BOARD_FORMAT_HPP
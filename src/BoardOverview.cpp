@@ -0,0 +1,282 @@
+#include "BoardOverview.hpp"
+
+#include <algorithm> // std::min, std::max
+#include <cmath> // std::floor
+
+#include "SFML/Graphics/Rect.hpp"
+#include "SFML/Graphics/VertexArray.hpp"
+
+#include "GlobalSettings.hpp"
+#include "Level.hpp"
+#include "Profiler.hpp"
+#include "ResourceManager.hpp"
+
+namespace
+{
+// A mark quad per tile, then the progress bar
+size_t GetNumBoardVertices(int size)
+{
+    return (static_cast<size_t>(size) * size + 1) * 4;
+}
+
+void SetQuad(sf::Vertex* quad, const sf::FloatRect& rect, const sf::IntRect& textureRect, const sf::Color& color)
+{
+    const float textureLeft = static_cast<float>(textureRect.left);
+    const float textureTop = static_cast<float>(textureRect.top);
+    const float textureRight = static_cast<float>(textureRect.left + textureRect.width);
+    const float textureBottom = static_cast<float>(textureRect.top + textureRect.height);
+
+    quad[0] = sf::Vertex({rect.left, rect.top}, color, {textureLeft, textureTop});
+    quad[1] = sf::Vertex({rect.left + rect.width, rect.top}, color, {textureRight, textureTop});
+    quad[2] = sf::Vertex({rect.left + rect.width, rect.top + rect.height}, color, {textureRight, textureBottom});
+    quad[3] = sf::Vertex({rect.left, rect.top + rect.height}, color, {textureLeft, textureBottom});
+}
+
+void AppendQuad(sf::VertexArray& vertices, const sf::FloatRect& rect, const sf::Color& color)
+{
+    vertices.append(sf::Vertex({rect.left, rect.top}, color));
+    vertices.append(sf::Vertex({rect.left + rect.width, rect.top}, color));
+    vertices.append(sf::Vertex({rect.left + rect.width, rect.top + rect.height}, color));
+    vertices.append(sf::Vertex({rect.left, rect.top + rect.height}, color));
+}
+} // namespace
+
+void BoardOverview::SetSessions(const std::vector<const GameSession*>& sessions)
+{
+    m_sessions = sessions;
+    m_isLayoutDirty = true;
+}
+
+void BoardOverview::InvalidateLayout()
+{
+    m_isLayoutDirty = true;
+}
+
+void BoardOverview::Draw(sf::RenderTarget& target)
+{
+    if (m_sessions.empty())
+    {
+        return;
+    }
+
+    const sf::Vector2u targetSize = target.getSize();
+    if (m_isLayoutDirty || targetSize != m_layoutSize)
+    {
+        UpdateLayout(targetSize);
+        BuildStaticLayer();
+    }
+
+    UpdateDynamicVertices();
+
+    const sf::Texture& atlasTexture = ResourceManager::getInstance().getAtlasTexture();
+    target.draw(m_staticLayerSprite);
+    if (sf::VertexBuffer::isAvailable())
+    {
+        // Only the slices of the boards which changed are uploaded, unless the whole buffer is new
+        if (m_isDynamicBufferDirty)
+        {
+            m_dynamicBuffer.create(m_dynamicVertices.size());
+            m_dynamicBuffer.update(m_dynamicVertices.data());
+            m_isDynamicBufferDirty = false;
+        }
+        else
+        {
+            for (const size_t board : m_updatedBoards)
+            {
+                const BoardLayout& layout = m_layouts[board];
+                m_dynamicBuffer.update(&m_dynamicVertices[layout.firstVertex], GetNumBoardVertices(m_sessions[board]->GetLevel().size), static_cast<unsigned int>(layout.firstVertex));
+            }
+        }
+        target.draw(m_dynamicBuffer, &atlasTexture);
+    }
+    else
+    {
+        target.draw(m_dynamicVertices.data(), m_dynamicVertices.size(), sf::Quads, &atlasTexture);
+    }
+    Profiler::getInstance().AddDrawCalls(2);
+}
+
+void BoardOverview::UpdateLayout(const sf::Vector2u& targetSize)
+{
+    m_layoutSize = targetSize;
+    m_isLayoutDirty = false;
+    m_isDynamicBufferDirty = true;
+
+    const size_t numBoards = m_sessions.size();
+    m_layouts.assign(numBoards, BoardLayout());
+    m_updatedBoards.reserve(numBoards);
+    if (numBoards == 0)
+    {
+        m_dynamicVertices.clear();
+        return;
+    }
+
+    // Square cells on a grid, with as many columns as give the biggest cells
+    const float width = static_cast<float>(targetSize.x);
+    const float height = static_cast<float>(targetSize.y);
+    size_t numColumns = 1;
+    float cellSize = 0.0f;
+    for (size_t columns = 1; columns <= numBoards; columns++)
+    {
+        const size_t rows = (numBoards + columns - 1) / columns;
+        const float size = std::min(width / columns, height / rows);
+        if (size > cellSize)
+        {
+            cellSize = size;
+            numColumns = columns;
+        }
+    }
+    const size_t numRows = (numBoards + numColumns - 1) / numColumns;
+    const sf::Vector2f gridOrigin((width - numColumns * cellSize) / 2.0f, (height - numRows * cellSize) / 2.0f);
+
+    // Each cell holds a board and its progress bar, with whole pixels per tile when there is room for them
+    const float margin = GlobalSettings::OVERVIEW_BOARD_MARGIN;
+    const float boardSpace = std::max(1.0f, cellSize - 2.0f * margin - GlobalSettings::OVERVIEW_PROGRESS_BAR_HEIGHT - 1.0f);
+
+    size_t numVertices = 0;
+    for (size_t board = 0; board < numBoards; board++)
+    {
+        const int size = std::max(1, m_sessions[board]->GetLevel().size);
+        const float tileSize = boardSpace >= size ? std::floor(boardSpace / size) : boardSpace / size;
+        const sf::Vector2f cellOrigin(gridOrigin.x + (board % numColumns) * cellSize, gridOrigin.y + (board / numColumns) * cellSize);
+
+        BoardLayout& layout = m_layouts[board];
+        layout.position = {std::floor(cellOrigin.x + margin + (boardSpace - tileSize * size) / 2.0f), std::floor(cellOrigin.y + margin)};
+        layout.tileSize = tileSize;
+        layout.firstVertex = numVertices;
+
+        numVertices += GetNumBoardVertices(m_sessions[board]->GetLevel().size);
+    }
+
+    m_dynamicVertices.assign(numVertices, sf::Vertex());
+}
+
+void BoardOverview::BuildStaticLayer()
+{
+    sf::VertexArray vertices(sf::Quads);
+
+    std::vector<sf::Color> regionColors(GridBoard::MAX_SIZE);
+    for (int region = 0; region < GridBoard::MAX_SIZE; region++)
+    {
+        regionColors[region] = Level::GetRegionColor(region).second;
+    }
+
+    for (size_t board = 0; board < m_sessions.size(); board++)
+    {
+        const GridBoard& level = m_sessions[board]->GetLevel();
+        const BoardLayout& layout = m_layouts[board];
+        const float tileSize = layout.tileSize;
+        const float boardSize = tileSize * level.size;
+        const sf::Vector2f& position = layout.position;
+
+        // The border color shows through the gaps between the tiles as grid lines
+        AppendQuad(vertices, {position.x - 1.0f, position.y - 1.0f, boardSize + 2.0f, boardSize + 2.0f}, GlobalSettings::OVERVIEW_BORDER_COLOR);
+
+        const float gap = tileSize >= 6.0f ? 1.0f : 0.0f;
+        const float borderThickness = std::max(1.0f, std::floor(tileSize / 6.0f));
+        for (int row = 0; row < level.size; row++)
+        {
+            for (int column = 0; column < level.size; column++)
+            {
+                const int region = level.regions[row][column];
+                const float x = position.x + column * tileSize;
+                const float y = position.y + row * tileSize;
+                AppendQuad(vertices, {x, y, tileSize - gap, tileSize - gap}, regionColors[region % GridBoard::MAX_SIZE]);
+
+                if (column + 1 < level.size && level.regions[row][column + 1] != region)
+                {
+                    AppendQuad(vertices, {x + tileSize - borderThickness, y, borderThickness, tileSize}, GlobalSettings::OVERVIEW_BORDER_COLOR);
+                }
+                if (row + 1 < level.size && level.regions[row + 1][column] != region)
+                {
+                    AppendQuad(vertices, {x, y + tileSize - borderThickness, tileSize, borderThickness}, GlobalSettings::OVERVIEW_BORDER_COLOR);
+                }
+            }
+        }
+
+        // Track of the progress bar
+        AppendQuad(vertices, {position.x, position.y + boardSize + 2.0f, boardSize, GlobalSettings::OVERVIEW_PROGRESS_BAR_HEIGHT}, GlobalSettings::OVERVIEW_BORDER_COLOR);
+    }
+
+    m_staticLayer.create(m_layoutSize.x, m_layoutSize.y);
+    m_staticLayer.clear(sf::Color::Transparent);
+    m_staticLayer.draw(vertices);
+    m_staticLayer.display();
+    m_staticLayerSprite.setTexture(m_staticLayer.getTexture(), true);
+}
+
+size_t BoardOverview::UpdateDynamicVertices()
+{
+    // Only the boards whose session has changed since they were last written
+    m_updatedBoards.clear();
+    for (size_t board = 0; board < m_sessions.size(); board++)
+    {
+        const BoardLayout& layout = m_layouts[board];
+        if (!layout.hasBeenDrawn || layout.drawnRevision != m_sessions[board]->GetRevision())
+        {
+            WriteBoardVertices(board);
+            m_updatedBoards.emplace_back(board);
+        }
+    }
+    m_numBoardsUpdated = m_updatedBoards.size();
+
+    return m_numBoardsUpdated;
+}
+
+void BoardOverview::WriteBoardVertices(size_t board)
+{
+    const GameSession& session = *m_sessions[board];
+    const GridBoard& level = session.GetLevel();
+    BoardLayout& layout = m_layouts[board];
+
+    const ResourceManager& resourceManager = ResourceManager::getInstance();
+    const sf::IntRect& fillRect = resourceManager.getAtlasRect(AtlasRegion::FILL);
+    const sf::IntRect& xRect = resourceManager.getAtlasRect(AtlasRegion::X);
+    const sf::IntRect& queenRect = resourceManager.getAtlasRect(AtlasRegion::QUEEN);
+
+    const float tileSize = layout.tileSize;
+    const float markOffset = tileSize * 0.15f;
+    const float markSize = tileSize - 2.0f * markOffset;
+
+    sf::Vertex* vertices = &m_dynamicVertices[layout.firstVertex];
+    for (int row = 0; row < level.size; row++)
+    {
+        for (int column = 0; column < level.size; column++)
+        {
+            sf::Vertex* quad = &vertices[(row * level.size + column) * 4];
+            const sf::FloatRect markRect(layout.position.x + column * tileSize + markOffset, layout.position.y + row * tileSize + markOffset, markSize, markSize);
+
+            // Tiles without a mark get a zero-area quad, which costs nothing to rasterize
+            switch (session.GetMark(row, column))
+            {
+            case SessionMark::X:
+                SetQuad(quad, markRect, xRect, sf::Color::White);
+                break;
+            case SessionMark::QUEEN:
+                SetQuad(quad, markRect, queenRect, sf::Color::White);
+                break;
+            case SessionMark::EMPTY:
+            default:
+                SetQuad(quad, {markRect.left, markRect.top, 0.0f, 0.0f}, fillRect, sf::Color::Transparent);
+                break;
+            }
+        }
+    }
+
+    // Progress bar: queens placed, and whether the board is won or breaks the rules
+    sf::Color progressColor = GlobalSettings::OVERVIEW_PROGRESS_COLOR;
+    if (session.IsWon())
+    {
+        progressColor = GlobalSettings::OVERVIEW_WON_COLOR;
+    }
+    else if (session.GetNumConflicts() > 0)
+    {
+        progressColor = GlobalSettings::OVERVIEW_CONFLICT_COLOR;
+    }
+    const float boardSize = tileSize * level.size;
+    const float progress = level.size > 0 ? std::min(1.0f, static_cast<float>(session.GetNumQueens()) / level.size) : 0.0f;
+    SetQuad(&vertices[level.size * level.size * 4], {layout.position.x, layout.position.y + boardSize + 2.0f, boardSize * progress, GlobalSettings::OVERVIEW_PROGRESS_BAR_HEIGHT}, fillRect, progressColor);
+
+    layout.drawnRevision = session.GetRevision();
+    layout.hasBeenDrawn = true;
+}
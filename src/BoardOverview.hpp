@@ -0,0 +1,68 @@
+#ifndef BOARD_OVERVIEW_HPP
+#define BOARD_OVERVIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SFML/Graphics/RenderTarget.hpp"
+#include "SFML/Graphics/RenderTexture.hpp"
+#include "SFML/Graphics/Sprite.hpp"
+#include "SFML/Graphics/Vertex.hpp"
+#include "SFML/Graphics/VertexBuffer.hpp"
+#include "SFML/System/Vector2.hpp"
+
+#include "GameSession.hpp"
+
+// Draws many game sessions at once, tiled across the window, e.g. every player's board during a tournament.
+// Whatever the number of boards, it takes two draw calls: a texture with the fills and region borders of every board,
+// rendered again only when the layout changes, and a vertex buffer with the marks and progress bars, in which only
+// the boards whose session has changed since the last frame are rewritten.
+class BoardOverview
+{
+public:
+    BoardOverview() = default;
+    ~BoardOverview() = default;
+
+    // The sessions must outlive the overview, or be replaced before they are destroyed
+    void SetSessions(const std::vector<const GameSession*>& sessions);
+    void InvalidateLayout(); // e.g. when the window is resized
+
+    void Draw(sf::RenderTarget& target);
+
+    // Rendering helpers, also used on their own to benchmark vertex building
+    void UpdateLayout(const sf::Vector2u& targetSize);
+    size_t UpdateDynamicVertices(); // returns the number of boards rewritten
+
+    size_t GetNumBoards() const { return m_sessions.size(); }
+    size_t GetNumBoardsUpdated() const { return m_numBoardsUpdated; } // during the last frame
+
+private:
+    struct BoardLayout
+    {
+        sf::Vector2f position; // top left corner of the board
+        float tileSize = 0.0f;
+        size_t firstVertex = 0; // in the dynamic vertices
+        uint32_t drawnRevision = 0; // revision of the session when its vertices were last written
+        bool hasBeenDrawn = false;
+    };
+
+    std::vector<const GameSession*> m_sessions;
+    std::vector<BoardLayout> m_layouts;
+    sf::Vector2u m_layoutSize; // size of the target the layout was computed for
+    bool m_isLayoutDirty = true;
+
+    sf::RenderTexture m_staticLayer;
+    sf::Sprite m_staticLayerSprite;
+
+    std::vector<sf::Vertex> m_dynamicVertices; // for each board: a mark quad per tile, then its progress bar
+    sf::VertexBuffer m_dynamicBuffer{sf::Quads, sf::VertexBuffer::Dynamic};
+    bool m_isDynamicBufferDirty = true; // the whole buffer has to be uploaded again, e.g. after a layout change
+    std::vector<size_t> m_updatedBoards; // boards whose slice of the buffer has to be uploaded again
+    size_t m_numBoardsUpdated = 0;
+
+    void BuildStaticLayer();
+    void WriteBoardVertices(size_t board);
+};
+
+#endif // BOARD_OVERVIEW_HPP
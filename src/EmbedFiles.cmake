@@ -0,0 +1,31 @@
+# Writes the files of INPUTS into a C++ source file OUTPUT, as byte arrays in namespace NAMESPACE:
+# x_icon.png becomes `const unsigned char X_ICON_PNG[]` and `const size_t X_ICON_PNG_SIZE`, declared in HEADER.
+# Run as a script: cmake -DINPUTS=a;b -DOUTPUT=... -DNAMESPACE=... -DHEADER=... -P EmbedFiles.cmake
+
+set(content "// Generated by EmbedFiles.cmake, do not edit\n\n#include \"${HEADER}\"\n\nnamespace ${NAMESPACE}\n{\n")
+
+foreach(input ${INPUTS})
+  get_filename_component(fileName ${input} NAME)
+  string(MAKE_C_IDENTIFIER ${fileName} symbol)
+  string(TOUPPER ${symbol} symbol)
+
+  file(READ ${input} hex HEX)
+  string(LENGTH "${hex}" hexLength)
+  math(EXPR size "${hexLength} / 2")
+  # 16 bytes per line (CMake regular expressions have no {n} repetition)
+  string(REPEAT "[0-9a-f]" 32 line)
+  string(REGEX REPLACE "(${line})" "\\1\n    " hex "${hex}")
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+
+  string(APPEND content "const unsigned char ${symbol}[] = {\n    ${bytes}\n};\nconst size_t ${symbol}_SIZE = ${size};\n\n")
+endforeach()
+
+string(APPEND content "} // namespace ${NAMESPACE}\n")
+
+# Only touch the output when it changes, so the game is not relinked for nothing
+if(EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} previousContent)
+endif()
+if(NOT "${content}" STREQUAL "${previousContent}")
+  file(WRITE ${OUTPUT} "${content}")
+endif()
@@ -0,0 +1,15 @@
+#ifndef EMBEDDED_TEXTURES_HPP
+#define EMBEDDED_TEXTURES_HPP
+
+#include <cstddef>
+
+// The PNG files of src/textures/, compiled into the game by EmbedFiles.cmake (see src/CMakeLists.txt)
+namespace EmbeddedTextures
+{
+extern const unsigned char X_ICON_PNG[];
+extern const size_t X_ICON_PNG_SIZE;
+extern const unsigned char QUEEN_ICON_PNG[];
+extern const size_t QUEEN_ICON_PNG_SIZE;
+} // namespace EmbeddedTextures
+
+#endif // EMBEDDED_TEXTURES_HPP
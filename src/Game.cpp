@@ -1,9 +1,20 @@
 #include "Game.hpp"
 
+#include <algorithm> // std::min, std::clamp
+#include <cmath> // std::pow
+#include <string>
+
+#include "SFML/Graphics/View.hpp"
+#include "SFML/System/Sleep.hpp"
 #include "SFML/Window/Event.hpp"
 
+#include "BoardFormat.hpp"
 #include "GlobalSettings.hpp"
+#include "InputRecorder.hpp"
+#include "Log.hpp"
+#include "Profiler.hpp"
 #include "ResourceManager.hpp"
+#include "SolutionCache.hpp"
 #include "UiSettings.hpp"
 
 Game::Game()
@@ -14,57 +25,135 @@ Game::Game()
 
 void Game::Init()
 {
-    ResourceManager::getInstance().Load();
+    LOG_INFO(LOAD) << "Window created after " << m_startupClock.getElapsedTime().asMicroseconds() / 1000.0f << " ms";
+
+    // The textures are embedded in the game and decoded on first use, while building the first frame (ResourceManager)
+    SolutionCache::getInstance().Open(GlobalSettings::SOLUTION_CACHE_PATH);
+
+    m_window.setFramerateLimit(GlobalSettings::FRAME_RATE_LIMIT);
 
     m_uiManager.Init(m_window);
 
     // Load the first level
-    const std::vector<std::string> levelsToLoad = m_uiManager.getLevelsToLoad();
+    const std::vector<std::string>& levelsToLoad = m_uiManager.getLevelsToLoad();
     m_level.Init(levelsToLoad[0]);
+    m_level.UpdateCamera(m_window.getSize());
+
+    LOG_INFO(LOAD) << "Initialized after " << m_startupClock.getElapsedTime().asMicroseconds() / 1000.0f << " ms";
 }
 
 void Game::Run()
 {
-    sf::Clock clock = sf::Clock();
-    sf::Time previousTime = clock.getElapsedTime();
-    sf::Time currentTime;
-
     // Game loop
     while (m_window.isOpen())
     {
-        currentTime = clock.getElapsedTime();
-        const float fps = 1.0f / (currentTime.asSeconds() - previousTime.asSeconds());
-        previousTime = currentTime;
+        // When rendering on demand and nothing has changed, we block until an event arrives or a timer tick is due
+        if (!IsRedrawNeeded())
+        {
+            sf::Event event;
+            if (WaitEvent(event, GetIdleTimeout()))
+            {
+                HandleEvent(event);
+            }
+
+            continue;
+        }
 
-        CheckMouseHover();
+        GlobalSettings::REDRAW_REQUESTED = false;
+        m_lastDrawnElapsedSecond = GetElapsedSecondShown();
+        if (m_framesToRedraw > 0)
+        {
+            m_framesToRedraw--;
+        }
 
-        CheckEvents();
+        UpdateFps();
 
-        m_uiManager.Run(m_window, m_level, fps);
+        Profiler& profiler = Profiler::getInstance();
+        profiler.BeginFrame();
+
+        {
+            ScopedPhaseTimer timer(ProfilerPhase::MOUSE_HOVER);
+            CheckMouseHover();
+        }
+
+        {
+            ScopedPhaseTimer timer(ProfilerPhase::EVENTS);
+            CheckEvents();
+        }
+
+        {
+            ScopedPhaseTimer timer(ProfilerPhase::UI);
+            m_uiManager.Run(m_window, m_level, m_fps);
+        }
 
         m_window.clear(GlobalSettings::BACKGROUND_COLOR);
 
-        m_level.Update(m_window);
+        {
+            ScopedPhaseTimer timer(ProfilerPhase::LEVEL_UPDATE);
+            if (UiSettings::SHOW_OVERVIEW)
+            {
+                UpdateOverviewSessions();
+                SimulateOverviewMoves();
+                m_boardOverview.Draw(m_window);
+            }
+            else
+            {
+                m_level.Update(m_window);
+                m_overviewClock.restart(); // the simulated players only play while they are watched
+            }
+        }
+
+        {
+            ScopedPhaseTimer timer(ProfilerPhase::RENDER);
+            m_uiManager.Render(m_window);
+            m_window.display();
+        }
 
-        m_uiManager.Render(m_window);
+        profiler.EndFrame();
 
-        m_window.display();
+        if (!m_hasShownFirstFrame)
+        {
+            ReportStartup();
+        }
+    }
+}
+
+void Game::ReportStartup()
+{
+    m_hasShownFirstFrame = true;
+
+    const float startupMs = m_startupClock.getElapsedTime().asMicroseconds() / 1000.0f;
+    Profiler::getInstance().SetStartupMs(startupMs);
+    if (startupMs > GlobalSettings::STARTUP_TARGET_MS)
+    {
+        LOG_WARNING(LOAD) << "First frame shown after " << startupMs << " ms, the target is " << GlobalSettings::STARTUP_TARGET_MS << " ms";
+    }
+    else
+    {
+        LOG_INFO(LOAD) << "First frame shown after " << startupMs << " ms";
     }
 }
 
 void Game::Shutdown()
 {
+    InputRecorder::getInstance().StopRecording();
+    SolutionCache::getInstance().Close();
+
     m_uiManager.Shutdown();
 }
 
 void Game::CheckMouseHover()
 {
-    // We are only interested on hover events if the level has been loaded and has still not been completed
-    if (m_level.HasLoaded() && !UiSettings::LEVEL_COMPLETED)
+    // The level is hidden behind the overview
+    if (UiSettings::SHOW_OVERVIEW)
     {
-        const sf::Vector2i mousePos = sf::Mouse::getPosition(m_window);
-        m_level.ChangeHoveredTileColor(mousePos);
+        return;
     }
+
+    InputEvent hoverEvent;
+    hoverEvent.type = InputEventType::HOVER;
+    hoverEvent.mousePos = m_level.MapPixelToLevel(sf::Mouse::getPosition(m_window));
+    InputRecorder::getInstance().Dispatch(m_level, hoverEvent);
 }
 
 void Game::CheckEvents()
@@ -72,16 +161,282 @@ void Game::CheckEvents()
     sf::Event event;
     while (m_window.pollEvent(event))
     {
-        m_uiManager.ProcessEvent(event);
+        HandleEvent(event);
+    }
+}
+
+void Game::HandleEvent(const sf::Event& event)
+{
+    m_uiManager.ProcessEvent(event);
+
+    if (event.type == sf::Event::Closed || sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))
+    {
+        m_window.close();
+    }
+
+    if (event.type == sf::Event::Resized)
+    {
+        // Keep drawing at 1:1 scale instead of stretching the contents
+        m_window.setView(sf::View(sf::FloatRect(0.0f, 0.0f, static_cast<float>(event.size.width), static_cast<float>(event.size.height))));
+        m_level.UpdateCamera({event.size.width, event.size.height});
+        m_boardOverview.InvalidateLayout();
+    }
+
+    if (!UiSettings::SHOW_OVERVIEW)
+    {
+        HandleCameraEvent(event);
+    }
+
+    if (event.type == sf::Event::MouseButtonPressed && !UiSettings::SHOW_OVERVIEW)
+    {
+        // The position stored in the event is where the click happened, even if the mouse has moved since
+        InputEvent clickEvent;
+        clickEvent.type = InputEventType::CLICK;
+        clickEvent.mousePos = m_level.MapPixelToLevel({event.mouseButton.x, event.mouseButton.y});
+        clickEvent.button = event.mouseButton.button;
+        InputRecorder::getInstance().Dispatch(m_level, clickEvent);
+    }
+
+    // Any input may change what is shown, either in the level or in the UI
+    m_framesToRedraw = GlobalSettings::REDRAW_FRAMES_AFTER_INPUT;
+}
+
+void Game::HandleCameraEvent(const sf::Event& event)
+{
+    // The mouse wheel zooms around the cursor, unless it is scrolling the UI
+    if (event.type == sf::Event::MouseWheelScrolled && !m_uiManager.IsCapturingMouse())
+    {
+        const float factor = std::pow(GlobalSettings::CAMERA_ZOOM_STEP, event.mouseWheelScroll.delta);
+        m_level.ZoomCamera({event.mouseWheelScroll.x, event.mouseWheelScroll.y}, factor);
+    }
+
+    const bool isButtonEvent = event.type == sf::Event::MouseButtonPressed || event.type == sf::Event::MouseButtonReleased;
+    const bool isPanButton = isButtonEvent && (event.mouseButton.button == sf::Mouse::Right || event.mouseButton.button == sf::Mouse::Middle);
+    if (event.type == sf::Event::MouseButtonPressed && isPanButton && !m_uiManager.IsCapturingMouse())
+    {
+        m_isPanning = true;
+        m_panLastPixel = {event.mouseButton.x, event.mouseButton.y};
+    }
+    else if (event.type == sf::Event::MouseButtonReleased && isPanButton)
+    {
+        m_isPanning = false;
+    }
+    else if (event.type == sf::Event::MouseMoved && m_isPanning)
+    {
+        const sf::Vector2i pixel(event.mouseMove.x, event.mouseMove.y);
+        m_level.PanCamera(pixel - m_panLastPixel);
+        m_panLastPixel = pixel;
+    }
+}
 
-        if (event.type == sf::Event::Closed || sf::Keyboard::isKeyPressed(sf::Keyboard::Escape))
+bool Game::IsRedrawNeeded() const
+{
+    if (!GlobalSettings::RENDER_ON_DEMAND)
+    {
+        return true;
+    }
+
+    // clang-format off
+    const bool inputPending      = m_framesToRedraw > 0;
+    const bool redrawRequested   = GlobalSettings::REDRAW_REQUESTED;
+    const bool uiIsAnimating     = m_uiManager.IsAnimating();
+    const bool elapsedTimeTicked = GetElapsedSecondShown() != m_lastDrawnElapsedSecond;
+    const bool overviewIsPlaying = UiSettings::SHOW_OVERVIEW && UiSettings::OVERVIEW_MOVES_PER_SECOND > 0;
+    // clang-format on
+
+    return inputPending || redrawRequested || uiIsAnimating || elapsedTimeTicked || overviewIsPlaying;
+}
+
+int Game::GetElapsedSecondShown() const
+{
+    // The elapsed time text only changes while the level is being played
+    if (m_level.HasLoaded() && !m_level.IsCompleted())
+    {
+        return static_cast<int>(m_level.GetClock().getElapsedTime().asSeconds());
+    }
+
+    return -1;
+}
+
+sf::Time Game::GetIdleTimeout() const
+{
+    int timeoutMs = GlobalSettings::IDLE_WAIT_TIMEOUT_MS;
+
+    // Wake up in time for the next tick of the elapsed time text
+    if (GetElapsedSecondShown() >= 0)
+    {
+        const int elapsedMs = m_level.GetClock().getElapsedTime().asMilliseconds();
+        timeoutMs = std::min(timeoutMs, 1000 - (elapsedMs % 1000));
+    }
+
+    return sf::milliseconds(timeoutMs);
+}
+
+bool Game::WaitEvent(sf::Event& event, sf::Time timeout)
+{
+    // sf::Window::waitEvent cannot time out in SFML 2.5, so we do what it does internally
+    // (poll and sleep in small slices) but give up once the timeout has expired
+    const sf::Time sleepSlice = sf::milliseconds(10);
+
+    sf::Clock waitClock;
+    while (waitClock.getElapsedTime() < timeout)
+    {
+        if (m_window.pollEvent(event))
+        {
+            return true;
+        }
+
+        if (GlobalSettings::REDRAW_REQUESTED)
+        {
+            return false;
+        }
+
+        sf::sleep(sleepSlice);
+    }
+
+    return false;
+}
+
+void Game::UpdateFps()
+{
+    m_framesSinceFpsUpdate++;
+
+    const sf::Time elapsed = m_fpsClock.getElapsedTime();
+    if (elapsed >= sf::milliseconds(500))
+    {
+        m_fps = m_framesSinceFpsUpdate / elapsed.asSeconds();
+
+        m_framesSinceFpsUpdate = 0;
+        m_fpsClock.restart();
+    }
+}
+
+void Game::LoadOverviewLevels()
+{
+    m_hasLoadedOverviewLevels = true;
+
+    // Hard or huge levels are given up on quickly, rather than freezing the window
+    GridSolver solver;
+    solver.SetProgressCallback([](const GridSolverProgress& progress) {
+        return progress.stats.nodes < GlobalSettings::OVERVIEW_MAX_SOLVE_NODES;
+    });
+
+    // Only levels with a solution, so the simulated players can win them
+    std::string line;
+    std::string error;
+    GridBoard level;
+    GridBoard solution;
+    const std::vector<std::string>& levelFileNames = m_uiManager.getLevelsToLoad();
+    const size_t numLevelFiles = std::min(levelFileNames.size(), GlobalSettings::OVERVIEW_MAX_LEVEL_FILES);
+    for (size_t i = 0; i < numLevelFiles && m_overviewSessions.GetNumLevels() < GlobalSettings::OVERVIEW_MAX_LEVELS; i++)
+    {
+        if (!BoardFormat::ReadBoardFile(std::string(GlobalSettings::LEVELS_PATH) + levelFileNames[i], line, level, error))
         {
-            m_window.close();
+            continue;
         }
+        level.ClearQueens();
+
+        solver.SetBoard(level);
+        if (solver.Solve(1, &solution) > 0)
+        {
+            m_overviewSessions.AddLevel(level);
+            m_overviewSolutions.emplace_back(solution);
+        }
+    }
 
-        if (event.type == sf::Event::MouseButtonPressed && !UiSettings::LEVEL_COMPLETED)
+    LOG_INFO(LOAD) << "Overview: " << m_overviewSessions.GetNumLevels() << " levels loaded";
+}
+
+void Game::UpdateOverviewSessions()
+{
+    if (!m_hasLoadedOverviewLevels)
+    {
+        LoadOverviewLevels();
+    }
+
+    const int numLevels = static_cast<int>(m_overviewSessions.GetNumLevels());
+    const size_t numBoards = static_cast<size_t>(std::clamp(UiSettings::OVERVIEW_NUM_BOARDS, 1, GlobalSettings::OVERVIEW_MAX_BOARDS));
+    if (numLevels == 0 || numBoards == m_overviewSessionIds.size())
+    {
+        return;
+    }
+
+    // The levels are dealt round robin, and the boards removed last are the ones added last
+    while (m_overviewSessionIds.size() < numBoards)
+    {
+        const int levelId = static_cast<int>(m_overviewSessionIds.size() % numLevels);
+        m_overviewSessionIds.emplace_back(m_overviewSessions.CreateSession(levelId));
+        m_overviewSessionLevels.emplace_back(levelId);
+    }
+    while (m_overviewSessionIds.size() > numBoards)
+    {
+        m_overviewSessions.DestroySession(m_overviewSessionIds.back());
+        m_overviewSessionIds.pop_back();
+        m_overviewSessionLevels.pop_back();
+    }
+
+    std::vector<const GameSession*> sessions;
+    sessions.reserve(m_overviewSessionIds.size());
+    for (const SessionId id : m_overviewSessionIds)
+    {
+        sessions.emplace_back(m_overviewSessions.GetSession(id));
+    }
+    m_boardOverview.SetSessions(sessions);
+}
+
+void Game::SimulateOverviewMoves()
+{
+    // Frames are not evenly spaced, so the moves are spread over the time elapsed, and a long stall only costs a second of moves
+    const float elapsedSeconds = std::min(m_overviewClock.restart().asSeconds(), 1.0f);
+    m_overviewMovesDue += elapsedSeconds * UiSettings::OVERVIEW_MOVES_PER_SECOND;
+    const int numMoves = static_cast<int>(m_overviewMovesDue);
+    m_overviewMovesDue -= numMoves;
+
+    if (m_overviewSessionIds.empty())
+    {
+        return;
+    }
+
+    // Same mix as the session benchmark: mostly queens of the solution and X marks, with some mistakes and undos
+    std::uniform_int_distribution<size_t> sessionDistribution(0, m_overviewSessionIds.size() - 1);
+    std::uniform_int_distribution<int> percentDistribution(0, 99);
+    for (int i = 0; i < numMoves; i++)
+    {
+        const size_t sessionIndex = sessionDistribution(m_overviewRandom);
+        GameSession& session = *m_overviewSessions.GetSession(m_overviewSessionIds[sessionIndex]);
+
+        // Won boards stay on screen until their player is picked again
+        if (session.IsWon())
+        {
+            session.Restart();
+            continue;
+        }
+
+        const int size = session.GetLevel().size;
+        std::uniform_int_distribution<int> tileDistribution(0, size - 1);
+        const int row = tileDistribution(m_overviewRandom);
+        const int column = tileDistribution(m_overviewRandom);
+
+        const int percent = percentDistribution(m_overviewRandom);
+        if (percent < 50)
+        {
+            session.ApplyMove(row, m_overviewSolutions[m_overviewSessionLevels[sessionIndex]].queens[row], SessionMark::QUEEN);
+        }
+        else if (percent < 75)
+        {
+            session.ApplyMove(row, column, SessionMark::X);
+        }
+        else if (percent < 85)
+        {
+            session.ApplyMove(row, column, SessionMark::QUEEN);
+        }
+        else if (percent < 95)
+        {
+            session.ApplyMove(row, column, SessionMark::EMPTY);
+        }
+        else
         {
-            m_level.MouseDetection(event.mouseButton.button, sf::Mouse::getPosition(m_window));
+            session.Undo();
         }
     }
 }
@@ -1,9 +1,18 @@
 #ifndef GAME_HPP
 #define GAME_HPP
 
+#include <random>
+#include <vector>
+
 #include "SFML/Graphics/RenderWindow.hpp"
+#include "SFML/System/Clock.hpp"
+#include "SFML/System/Time.hpp"
+#include "SFML/Window/Event.hpp"
 
+#include "BoardOverview.hpp"
+#include "GlobalSettings.hpp"
 #include "Level.hpp"
+#include "SessionManager.hpp"
 #include "UiManager.hpp"
 
 class Game
@@ -17,6 +26,11 @@ public:
     void Shutdown();
 
 private:
+    // Cold start, from the construction of the game at the top of main() to the first frame shown.
+    // Declared before the window, so it also counts the creation of the window.
+    sf::Clock m_startupClock;
+    bool m_hasShownFirstFrame = false;
+
     sf::RenderWindow m_window;
 
     UiManager m_uiManager;
@@ -24,8 +38,46 @@ private:
 
     bool m_mouseHasBeenPressed = false;
 
+    // Dragging with the right or middle button pans the level camera
+    bool m_isPanning = false;
+    sf::Vector2i m_panLastPixel;
+
+    // Overview: every level file played at once by simulated players, standing in for the sessions of a server
+    BoardOverview m_boardOverview;
+    bool m_hasLoadedOverviewLevels = false;
+    SessionManager m_overviewSessions;
+    std::vector<GridBoard> m_overviewSolutions; // [level id]
+    std::vector<SessionId> m_overviewSessionIds;
+    std::vector<int> m_overviewSessionLevels; // level id of each session
+    std::mt19937 m_overviewRandom;
+    sf::Clock m_overviewClock;
+    float m_overviewMovesDue = 0.0f; // fractional moves carried over to the next frame
+
+    // Render on demand
+    int m_framesToRedraw = GlobalSettings::REDRAW_FRAMES_AFTER_INPUT;
+    int m_lastDrawnElapsedSecond = -1;
+
+    // FPS, averaged over the frames rendered within the last measurement period
+    sf::Clock m_fpsClock;
+    int m_framesSinceFpsUpdate = 0;
+    float m_fps = 0.0f;
+
     void CheckMouseHover();
     void CheckEvents();
+    void HandleEvent(const sf::Event& event);
+    void HandleCameraEvent(const sf::Event& event);
+
+    bool IsRedrawNeeded() const;
+    int GetElapsedSecondShown() const;
+    sf::Time GetIdleTimeout() const;
+    bool WaitEvent(sf::Event& event, sf::Time timeout);
+
+    void UpdateFps();
+    void ReportStartup();
+
+    void LoadOverviewLevels();
+    void UpdateOverviewSessions();
+    void SimulateOverviewMoves();
 };
 
 #endif // GAME_HPP
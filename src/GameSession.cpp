@@ -0,0 +1,125 @@
+#include "GameSession.hpp"
+
+#include <algorithm> // std::fill
+#include <cstddef>
+#include <memory_resource>
+
+static_assert(12 * 12 * sizeof(SessionMark) + GameSession::INITIAL_HISTORY_CAPACITY * sizeof(SessionMove) <= GameSession::ARENA_SIZE, "the arena must hold a 12x12 level and the initial history");
+
+GameSession::GameSession(const GridBoard& level, std::pmr::memory_resource* upstream)
+    : m_level(level)
+    , m_size(level.size)
+    , m_arena(m_arenaBuffer, sizeof(m_arenaBuffer), upstream)
+    , m_marks(static_cast<size_t>(level.size) * level.size, SessionMark::EMPTY, &m_arena)
+    , m_history(&m_arena)
+{
+    m_history.reserve(INITIAL_HISTORY_CAPACITY);
+}
+
+bool GameSession::ApplyMove(int row, int column, SessionMark mark)
+{
+    if (row < 0 || row >= m_size || column < 0 || column >= m_size)
+    {
+        return false;
+    }
+
+    const SessionMark previousMark = GetMark(row, column);
+    if (previousMark == mark)
+    {
+        return false;
+    }
+
+    SetMark(row, column, mark);
+
+    SessionMove move;
+    move.row = static_cast<uint8_t>(row);
+    move.column = static_cast<uint8_t>(column);
+    move.mark = mark;
+    move.previousMark = previousMark;
+    m_history.push_back(move);
+
+    return true;
+}
+
+bool GameSession::Undo()
+{
+    if (m_history.empty())
+    {
+        return false;
+    }
+
+    const SessionMove& move = m_history.back();
+    SetMark(move.row, move.column, move.previousMark);
+    m_history.pop_back();
+
+    return true;
+}
+
+void GameSession::Restart()
+{
+    // The history keeps its capacity, so a restarted game does not allocate again
+    std::fill(m_marks.begin(), m_marks.end(), SessionMark::EMPTY);
+    m_history.clear();
+
+    m_rowQueens.fill(0);
+    m_columnQueens.fill(0);
+    m_regionQueens.fill(0);
+    m_numQueens = 0;
+    m_numConflicts = 0;
+    m_revision++;
+}
+
+void GameSession::SetMark(int row, int column, SessionMark mark)
+{
+    SessionMark& tileMark = m_marks[row * m_size + column];
+    if (tileMark == SessionMark::QUEEN)
+    {
+        RemoveQueen(row, column);
+    }
+
+    tileMark = mark;
+
+    if (mark == SessionMark::QUEEN)
+    {
+        AddQueen(row, column);
+    }
+
+    m_revision++;
+}
+
+void GameSession::AddQueen(int row, int column)
+{
+    const int region = m_level.regions[row][column];
+
+    // Every queen beyond the first one of a row, column or region is a conflict
+    m_numConflicts += (m_rowQueens[row]++ > 0 ? 1 : 0) + (m_columnQueens[column]++ > 0 ? 1 : 0) + (m_regionQueens[region]++ > 0 ? 1 : 0);
+    m_numConflicts += CountTouchingQueens(row, column);
+    m_numQueens++;
+}
+
+void GameSession::RemoveQueen(int row, int column)
+{
+    const int region = m_level.regions[row][column];
+
+    m_numConflicts -= (--m_rowQueens[row] > 0 ? 1 : 0) + (--m_columnQueens[column] > 0 ? 1 : 0) + (--m_regionQueens[region] > 0 ? 1 : 0);
+    m_numConflicts -= CountTouchingQueens(row, column);
+    m_numQueens--;
+}
+
+int GameSession::CountTouchingQueens(int row, int column) const
+{
+    // Only the diagonal neighbours: the others share a row or a column, which is already a conflict
+    int numTouching = 0;
+    for (const int neighbourRow : {row - 1, row + 1})
+    {
+        for (const int neighbourColumn : {column - 1, column + 1})
+        {
+            if (neighbourRow >= 0 && neighbourRow < m_size && neighbourColumn >= 0 && neighbourColumn < m_size && GetMark(neighbourRow, neighbourColumn) == SessionMark::QUEEN)
+            {
+                numTouching++;
+            }
+        }
+    }
+
+    return numTouching;
+}
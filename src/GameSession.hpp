@@ -0,0 +1,83 @@
+#ifndef GAME_SESSION_HPP
+#define GAME_SESSION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "GridSolver.hpp"
+
+// Same marks as the tiles of the game
+enum class SessionMark : uint8_t
+{
+    EMPTY,
+    X,
+    QUEEN
+};
+
+struct SessionMove
+{
+    uint8_t row = 0;
+    uint8_t column = 0;
+    SessionMark mark = SessionMark::EMPTY;
+    SessionMark previousMark = SessionMark::EMPTY; // to undo it
+};
+
+// Game state of one player on one level, without any SFML object nor global, so thousands can live side by side
+// (see SessionManager). Its marks and move history are allocated from its own arena: a small buffer inside the
+// session itself, then blocks from the upstream resource if the history outgrows it, all released at once with the
+// session. Queens are counted per row, column and region, so moves, undos and the win check are all O(1).
+class GameSession
+{
+public:
+    static const size_t INITIAL_HISTORY_CAPACITY = 64; // moves reserved up front, a longer history grows upstream
+    static const size_t ARENA_SIZE = 512; // enough for the marks of a 12x12 level and the first 64 moves
+
+    // The level must outlive the session; it is only read, so sessions can share it
+    GameSession(const GridBoard& level, std::pmr::memory_resource* upstream);
+
+    GameSession(const GameSession&) = delete;
+    GameSession& operator =(const GameSession&) = delete;
+
+    // Sets the mark of a tile and records it in the history; returns false if it did not change anything
+    bool ApplyMove(int row, int column, SessionMark mark);
+    // Takes back the last move; returns false if there is none
+    bool Undo();
+    void Restart();
+
+    // Every row, column and region has exactly one queen and no two queens touch
+    bool IsWon() const { return m_numQueens == m_size && m_numConflicts == 0; }
+
+    SessionMark GetMark(int row, int column) const { return m_marks[row * m_size + column]; }
+    int GetNumQueens() const { return m_numQueens; }
+    int GetNumConflicts() const { return m_numConflicts; }
+    // Changes whenever a mark does, so views can tell when to redraw the board
+    uint32_t GetRevision() const { return m_revision; }
+    size_t GetNumMoves() const { return m_history.size(); }
+    const GridBoard& GetLevel() const { return m_level; }
+
+private:
+    const GridBoard& m_level;
+    int m_size = 0;
+
+    std::array<uint8_t, GridBoard::MAX_SIZE> m_rowQueens = {};
+    std::array<uint8_t, GridBoard::MAX_SIZE> m_columnQueens = {};
+    std::array<uint8_t, GridBoard::MAX_SIZE> m_regionQueens = {};
+    int m_numQueens = 0;
+    int m_numConflicts = 0; // extra queens in a row, column or region, plus pairs of diagonally touching queens
+    uint32_t m_revision = 0;
+
+    alignas(std::max_align_t) std::byte m_arenaBuffer[ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource m_arena;
+    std::pmr::vector<SessionMark> m_marks; // [row * size + column]
+    std::pmr::vector<SessionMove> m_history;
+
+    void SetMark(int row, int column, SessionMark mark);
+    void AddQueen(int row, int column);
+    void RemoveQueen(int row, int column);
+    int CountTouchingQueens(int row, int column) const;
+};
+
+#endif // GAME_SESSION_HPP
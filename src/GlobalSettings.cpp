@@ -1,3 +1,5 @@
+#include <atomic>
+
 #include "SFML/Graphics/Color.hpp"
 
 namespace GlobalSettings
@@ -6,4 +8,8 @@ char WINDOW_TITLE[255] = "Queens";
 
 sf::Color BACKGROUND_COLOR = {105, 105, 105};
 float BACKGROUND_COLOR_INPUT[3] = {0.41f, 0.41f, 0.41f};
+
+bool RENDER_ON_DEMAND = true;
+int FRAME_RATE_LIMIT = 60;
+std::atomic<bool> REDRAW_REQUESTED{false};
 } // namespace GlobalSettings
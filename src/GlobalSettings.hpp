@@ -1,6 +1,10 @@
 #ifndef GLOBAL_SETTINGS_HPP
 #define GLOBAL_SETTINGS_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 #include "SFML/Graphics/Color.hpp"
 
 namespace GlobalSettings
@@ -11,13 +15,57 @@ inline const int WINDOW_WIDTH = 1280;
 inline const int WINDOW_HEIGHT = 720;
 
 inline const char LEVELS_PATH[255] = "./src/levels/";
-inline const char TEXTURES_PATH[255] = "./src/textures/";
+inline const char SOLUTION_CACHE_PATH[255] = "./solutions.qcache";
+inline const char TRACE_EXPORT_PATH[255] = "./queens_trace.json";
+inline const char INPUT_RECORDING_PATH[255] = "./session.qrec";
 
 extern sf::Color BACKGROUND_COLOR;
 extern float BACKGROUND_COLOR_INPUT[3];
 
+// Rendering
+extern bool RENDER_ON_DEMAND; // only redraw after input, timer ticks or explicit requests
+extern int FRAME_RATE_LIMIT; // 0 means unlimited
+extern std::atomic<bool> REDRAW_REQUESTED; // can be set from any thread, e.g. when background work finishes
+
+inline const int IDLE_WAIT_TIMEOUT_MS = 250;
+inline const int STARTUP_TARGET_MS = 100; // from main() to the first frame shown, a warning is logged above it
+inline const int REDRAW_FRAMES_AFTER_INPUT = 3; // ImGui needs a few frames to settle after an interaction
+
+inline const uint64_t BACKGROUND_COUNT_MAX_SOLUTIONS = 1000000; // counting stops there
+
 inline const int TILE_SIZE = 64;
-inline const int TILE_DARK_FACTOR = 32;
+inline const float REGION_BORDER_THICKNESS = 3.0f;
+inline const sf::Color TILE_HOVER_TINT = {0, 0, 0, 40};
+inline const sf::Color TILE_CONFLICT_TINT = {255, 0, 0, 110};
+
+// Level camera
+inline const float CAMERA_MAX_ZOOM = 4.0f; // window pixels per level unit
+inline const float CAMERA_ZOOM_STEP = 1.15f; // per notch of the mouse wheel
+inline const float GLYPH_MAX_TILE_SIZE = 16.0f; // tiles smaller than this on screen (in pixels) show glyphs instead of icons
+inline const sf::Color QUEEN_GLYPH_COLOR = {30, 30, 30};
+inline const sf::Color X_GLYPH_COLOR = {0, 0, 0, 70};
+
+// Level picker, only the visible rows are laid out so it scales to any number of levels (see LevelIndex)
+inline const float LEVEL_PICKER_HEIGHT = 300.0f;
+
+// Thumbnails of the levels in the level picker (see ThumbnailRenderer)
+inline const int LEVEL_THUMBNAIL_TILE_SIZE = 5; // pixels per tile when rendering them
+inline const float LEVEL_THUMBNAIL_SIZE = 48.0f; // shown size, whatever the size of the level
+inline const size_t LEVEL_THUMBNAIL_CACHE_SIZE = 256; // textures kept, the least recently shown are released past this
+
+// Overview of many boards
+inline const int OVERVIEW_MAX_BOARDS = 1000;
+// The boards share a few levels, read and solved on the main thread when the overview first opens, so that stays
+// quick whatever the size of the catalogue
+inline const size_t OVERVIEW_MAX_LEVELS = 100;
+inline const size_t OVERVIEW_MAX_LEVEL_FILES = 400; // read at most, for when many levels cannot be used
+inline const uint64_t OVERVIEW_MAX_SOLVE_NODES = 100000; // levels the solver cannot solve within this are skipped
+inline const float OVERVIEW_BOARD_MARGIN = 4.0f; // around each board, in pixels
+inline const float OVERVIEW_PROGRESS_BAR_HEIGHT = 3.0f;
+inline const sf::Color OVERVIEW_BORDER_COLOR = {40, 40, 40};
+inline const sf::Color OVERVIEW_PROGRESS_COLOR = {90, 160, 230};
+inline const sf::Color OVERVIEW_WON_COLOR = {60, 200, 90};
+inline const sf::Color OVERVIEW_CONFLICT_COLOR = {230, 60, 60};
 } // namespace GlobalSettings
 
 #endif // GLOBAL_SETTINGS_HPP
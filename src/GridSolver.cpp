@@ -0,0 +1,634 @@
+#include "GridSolver.hpp"
+
+#include <algorithm> // std::min, std::max
+#include <array>
+#include <climits> // INT_MAX
+#include <cstdint>
+#include <utility> // std::move
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+int CountBits(uint64_t bits)
+{
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(bits));
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
+
+int GetLowestBit(uint64_t bits)
+{
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+uint64_t Bit(int index)
+{
+    return uint64_t(1) << index;
+}
+
+// Row or column at an offset from another one, wrapped around the board with toroidal rules, -1 if it is off the board
+template <typename Rules>
+int GetOffsetLine(int line, int offset, int size)
+{
+    int offsetLine = line + offset;
+    if constexpr (Rules::IS_TOROIDAL)
+    {
+        offsetLine = ((offsetLine % size) + size) % size;
+    }
+    else if (offsetLine < 0 || offsetLine >= size)
+    {
+        offsetLine = -1;
+    }
+
+    return offsetLine;
+}
+} // namespace
+
+int GridBoard::GetNumQueens() const
+{
+    int numQueens = 0;
+    for (int row = 0; row < size; row++)
+    {
+        if (queens[row] >= 0)
+        {
+            numQueens++;
+        }
+    }
+
+    return numQueens;
+}
+
+template <typename Rules>
+BasicGridSolver<Rules>::BasicGridSolver(const GridBoard& board)
+{
+    SetBoard(board);
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::SetBoard(const GridBoard& board)
+{
+    SetRegions(board.size, board.regions[0].data(), GridBoard::MAX_SIZE);
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::SetRegions(int size, const uint8_t* regions, size_t rowStride)
+{
+    // Only the masks of the previous board's regions can be set
+    for (int region = 0; region < m_numRegions; region++)
+    {
+        m_regionRowMasks[region].fill(0);
+    }
+    m_numRegions = 0;
+
+    m_size = std::max(0, std::min(size, static_cast<int>(GridBoard::MAX_SIZE)));
+    m_allColumns = Bit(m_size) - 1;
+    m_board.size = m_size;
+
+    for (int row = 0; row < m_size; row++)
+    {
+        const uint8_t* rowRegions = regions + row * rowStride;
+        for (int column = 0; column < m_size; column++)
+        {
+            const int region = rowRegions[column];
+            m_board.regions[row][column] = rowRegions[column];
+            if (region < GridBoard::MAX_SIZE)
+            {
+                m_regionRowMasks[region][row] |= Bit(column);
+                m_numRegions = std::max(m_numRegions, region + 1);
+            }
+        }
+    }
+
+    // Exclusions only depend on the size of the board (edges), so the search just looks them up
+    for (int rowOffset = -EXCLUSION_RADIUS; rowOffset <= EXCLUSION_RADIUS; rowOffset++)
+    {
+        for (int column = 0; column < m_size; column++)
+        {
+            uint64_t excludedColumns = 0;
+            for (int columnOffset = -EXCLUSION_RADIUS; columnOffset <= EXCLUSION_RADIUS; columnOffset++)
+            {
+                const int excludedColumn = GetOffsetLine<Rules>(column, columnOffset, m_size);
+                if ((rowOffset != 0 || columnOffset != 0) && Rules::IsExcluded(rowOffset, columnOffset) && excludedColumn >= 0)
+                {
+                    excludedColumns |= Bit(excludedColumn);
+                }
+            }
+            m_exclusionMasks[rowOffset + EXCLUSION_RADIUS][column] = excludedColumns;
+        }
+    }
+}
+
+template <typename Rules>
+uint64_t BasicGridSolver<Rules>::Solve(uint64_t maxSolutions, GridBoard* solution)
+{
+    m_rowQueens.fill(0);
+    m_fullRows = 0;
+    m_fullColumns = 0;
+    m_fullRegions = 0;
+    m_rowCounts.fill(0);
+    m_columnCounts.fill(0);
+    m_regionCounts.fill(0);
+    m_blockedByRegions.fill(0);
+    m_excludedTiles.fill(0);
+
+    m_maxSolutions = maxSolutions;
+    m_numSolutions = 0;
+    m_firstSolution.fill(-1);
+    m_firstSolutionQueens.fill(0);
+    m_stats = GridSolverStats();
+    m_maxDepth = 0;
+    m_nextProgressNodes = m_progressInterval;
+    m_isStopped = false;
+
+    // A level needs exactly one region per row (and column) to be solvable at all
+    if (m_size > 0 && m_numRegions == m_size && maxSolutions > 0)
+    {
+        Search(0);
+    }
+
+    for (int row = 0; row < m_size; row++)
+    {
+        if (m_firstSolutionQueens[row] != 0)
+        {
+            m_firstSolution[row] = static_cast<int8_t>(GetLowestBit(m_firstSolutionQueens[row]));
+        }
+    }
+
+    if (solution && m_numSolutions > 0)
+    {
+        *solution = m_board;
+        solution->queens = m_firstSolution;
+    }
+
+    return m_numSolutions;
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::SetProgressCallback(ProgressCallback callback, uint64_t intervalNodes)
+{
+    m_progressCallback = std::move(callback);
+    m_progressInterval = m_progressCallback ? std::max<uint64_t>(1, intervalNodes) : 0;
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::ReportProgress(int depth)
+{
+    m_nextProgressNodes = m_stats.nodes + m_progressInterval;
+
+    GridSolverProgress progress;
+    progress.stats = m_stats;
+    progress.depth = depth;
+    progress.maxDepth = m_maxDepth;
+    progress.numSolutions = m_numSolutions;
+    if (!m_progressCallback(progress))
+    {
+        m_isStopped = true;
+    }
+}
+
+template <typename Rules>
+uint64_t BasicGridSolver<Rules>::GetRowCandidates(int row) const
+{
+    if (m_fullRows & Bit(row))
+    {
+        return 0;
+    }
+
+    uint64_t candidates = m_allColumns & ~m_fullColumns & ~m_blockedByRegions[row] & ~m_rowQueens[row];
+    if constexpr (QUEENS_PER_LINE > 1)
+    {
+        candidates &= ~m_excludedTiles[row];
+    }
+
+    // Queens can only exclude tiles of a row from the rows within the exclusion radius (and from the row itself when
+    // it is not full, i.e. with several queens per line)
+    for (int rowOffset = -EXCLUSION_RADIUS; rowOffset <= EXCLUSION_RADIUS; rowOffset++)
+    {
+        if (QUEENS_PER_LINE == 1 && rowOffset == 0)
+        {
+            continue;
+        }
+
+        const int otherRow = GetOffsetLine<Rules>(row, rowOffset, m_size);
+        if (otherRow < 0)
+        {
+            continue;
+        }
+
+        for (uint64_t queens = m_rowQueens[otherRow]; queens != 0; queens &= queens - 1)
+        {
+            candidates &= ~m_exclusionMasks[EXCLUSION_RADIUS - rowOffset][GetLowestBit(queens)];
+        }
+    }
+
+    return candidates;
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::PlaceQueen(int row, int column)
+{
+    const int region = m_board.regions[row][column];
+
+    // With one queen per line, the first queen fills its row, column and region, so nothing needs to be counted
+    m_rowQueens[row] |= Bit(column);
+    if (QUEENS_PER_LINE == 1 || ++m_rowCounts[row] == QUEENS_PER_LINE)
+    {
+        m_fullRows |= Bit(row);
+    }
+    if (QUEENS_PER_LINE == 1 || ++m_columnCounts[column] == QUEENS_PER_LINE)
+    {
+        m_fullColumns |= Bit(column);
+    }
+    if (QUEENS_PER_LINE == 1 || ++m_regionCounts[region] == QUEENS_PER_LINE)
+    {
+        m_fullRegions |= Bit(region);
+        for (int i = 0; i < m_size; i++)
+        {
+            m_blockedByRegions[i] |= m_regionRowMasks[region][i];
+        }
+    }
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::RemoveQueen(int row, int column)
+{
+    const int region = m_board.regions[row][column];
+
+    // Regions never overlap, so their columns can simply be unblocked
+    m_rowQueens[row] &= ~Bit(column);
+    if (QUEENS_PER_LINE == 1 || m_rowCounts[row]-- == QUEENS_PER_LINE)
+    {
+        m_fullRows &= ~Bit(row);
+    }
+    if (QUEENS_PER_LINE == 1 || m_columnCounts[column]-- == QUEENS_PER_LINE)
+    {
+        m_fullColumns &= ~Bit(column);
+    }
+    if (QUEENS_PER_LINE == 1 || m_regionCounts[region]-- == QUEENS_PER_LINE)
+    {
+        m_fullRegions &= ~Bit(region);
+        for (int i = 0; i < m_size; i++)
+        {
+            m_blockedByRegions[i] &= ~m_regionRowMasks[region][i];
+        }
+    }
+}
+
+template <typename Rules>
+int BasicGridSolver<Rules>::GetMissingQueens(int count)
+{
+    // Lines are only counted with several queens per line, any other line still misses its queen
+    if constexpr (QUEENS_PER_LINE == 1)
+    {
+        return 1;
+    }
+    else
+    {
+        return QUEENS_PER_LINE - count;
+    }
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::PlaceAndSearch(int row, int column, int numPlaced)
+{
+    PlaceQueen(row, column);
+    m_stats.nodes++;
+    if (m_progressInterval > 0 && m_stats.nodes >= m_nextProgressNodes)
+    {
+        ReportProgress(numPlaced + 1);
+    }
+    if (!m_isStopped)
+    {
+        Search(numPlaced + 1);
+    }
+    RemoveQueen(row, column);
+}
+
+template <typename Rules>
+void BasicGridSolver<Rules>::Search(int numPlaced)
+{
+    if (numPlaced == m_size * QUEENS_PER_LINE)
+    {
+        m_numSolutions++;
+        if (m_numSolutions == 1)
+        {
+            m_firstSolutionQueens = m_rowQueens;
+        }
+        return;
+    }
+
+    // Candidate tiles of every row, and the unit (row, column or region) with the fewest of them left over once its
+    // missing queens are placed
+    std::array<uint64_t, GridBoard::MAX_SIZE> rowCandidates;
+    uint64_t coveredColumns = 0;
+    int bestSlack = INT_MAX;
+    std::array<uint64_t, GridBoard::MAX_SIZE> bestCandidates = {}; // [row]
+
+    for (int row = 0; row < m_size; row++)
+    {
+        rowCandidates[row] = GetRowCandidates(row);
+        if (m_fullRows & Bit(row))
+        {
+            continue;
+        }
+
+        const int slack = CountBits(rowCandidates[row]) - GetMissingQueens(m_rowCounts[row]);
+        if (slack < 0)
+        {
+            return;
+        }
+        if (slack < bestSlack)
+        {
+            bestSlack = slack;
+            bestCandidates.fill(0);
+            bestCandidates[row] = rowCandidates[row];
+        }
+        coveredColumns |= rowCandidates[row];
+    }
+
+    // Every column still missing queens needs candidate tiles
+    const uint64_t freeColumns = m_allColumns & ~m_fullColumns;
+    if ((freeColumns & ~coveredColumns) != 0)
+    {
+        return;
+    }
+
+    if (QUEENS_PER_LINE > 1 || bestSlack > 0)
+    {
+        for (uint64_t columns = freeColumns; columns != 0; columns &= columns - 1)
+        {
+            const uint64_t columnBit = columns & (~columns + 1);
+
+            int count = 0;
+            for (int row = 0; row < m_size; row++)
+            {
+                count += (rowCandidates[row] & columnBit) != 0 ? 1 : 0;
+            }
+            const int slack = count - GetMissingQueens(m_columnCounts[GetLowestBit(columnBit)]);
+            if (slack < 0)
+            {
+                return;
+            }
+            if (slack < bestSlack)
+            {
+                bestSlack = slack;
+                for (int row = 0; row < m_size; row++)
+                {
+                    bestCandidates[row] = rowCandidates[row] & columnBit;
+                }
+            }
+        }
+    }
+
+    // Every region still missing queens needs candidate tiles too
+    for (int region = 0; region < m_numRegions; region++)
+    {
+        if (m_fullRegions & Bit(region))
+        {
+            continue;
+        }
+
+        int count = 0;
+        for (int row = 0; row < m_size; row++)
+        {
+            count += CountBits(rowCandidates[row] & m_regionRowMasks[region][row]);
+        }
+        const int slack = count - GetMissingQueens(m_regionCounts[region]);
+        if (slack < 0)
+        {
+            return;
+        }
+        if (slack < bestSlack)
+        {
+            bestSlack = slack;
+            for (int row = 0; row < m_size; row++)
+            {
+                bestCandidates[row] = rowCandidates[row] & m_regionRowMasks[region][row];
+            }
+        }
+    }
+
+    if (bestSlack > 0)
+    {
+        m_stats.guesses++;
+    }
+    else
+    {
+        m_stats.forced++;
+    }
+    m_maxDepth = std::max(m_maxDepth, numPlaced + 1);
+
+    if constexpr (QUEENS_PER_LINE == 1)
+    {
+        // The unit gets exactly one of its candidates, so trying each of them covers every solution once
+        for (int row = 0; row < m_size; row++)
+        {
+            for (uint64_t columns = bestCandidates[row]; columns != 0; columns &= columns - 1)
+            {
+                PlaceAndSearch(row, GetLowestBit(columns), numPlaced);
+                if (m_numSolutions >= m_maxSolutions || m_isStopped)
+                {
+                    return;
+                }
+            }
+        }
+    }
+    else
+    {
+        // The unit gets several of its candidates, so trying each of them would find every solution several times:
+        // its first candidate either gets a queen, or is ruled out for the rest of that branch
+        int row = 0;
+        while (bestCandidates[row] == 0)
+        {
+            row++;
+        }
+        const int column = GetLowestBit(bestCandidates[row]);
+
+        PlaceAndSearch(row, column, numPlaced);
+        if (m_numSolutions >= m_maxSolutions || m_isStopped || bestSlack == 0)
+        {
+            return;
+        }
+
+        m_excludedTiles[row] |= Bit(column);
+        Search(numPlaced);
+        m_excludedTiles[row] &= ~Bit(column);
+    }
+}
+
+template <typename Rules>
+GridCheckResult BasicGridSolver<Rules>::Check(const GridBoard& board)
+{
+    return Check(board.size, board.regions[0].data(), GridBoard::MAX_SIZE, board.queens.data());
+}
+
+template <typename Rules>
+GridCheckResult BasicGridSolver<Rules>::Check(int size, const uint8_t* regions, size_t rowStride, const int8_t* queens)
+{
+    std::array<uint64_t, GridBoard::MAX_SIZE> rowQueens = {};
+    for (int row = 0; row < size && row < GridBoard::MAX_SIZE; row++)
+    {
+        if (queens[row] >= 0 && queens[row] < size)
+        {
+            rowQueens[row] = Bit(queens[row]);
+        }
+    }
+
+    return CheckQueens(size, regions, rowStride, rowQueens.data());
+}
+
+template <typename Rules>
+GridCheckResult BasicGridSolver<Rules>::CheckQueens(int size, const uint8_t* regions, size_t rowStride, const uint64_t* rowQueens)
+{
+    constexpr bool isSingleQueen = QUEENS_PER_LINE == 1;
+    constexpr std::array<RuleOffset, GetNumExclusionOffsets<Rules>()> exclusionOffsets = GetExclusionOffsets<Rules>();
+
+    GridCheckResult result;
+    if (size < 0 || size > GridBoard::MAX_SIZE)
+    {
+        result.reason = "invalid size";
+        return result;
+    }
+
+    const uint64_t allColumns = Bit(size) - 1;
+    std::array<uint8_t, GridBoard::MAX_SIZE> columnCounts = {};
+    std::array<uint8_t, GridBoard::MAX_SIZE> regionCounts = {};
+    for (int row = 0; row < size; row++)
+    {
+        const uint64_t queens = rowQueens[row] & allColumns;
+        const int numQueens = CountBits(queens);
+        if (numQueens < QUEENS_PER_LINE)
+        {
+            result.reason = isSingleQueen ? "row without a queen" : "row without enough queens";
+            return result;
+        }
+        if (numQueens > QUEENS_PER_LINE)
+        {
+            result.reason = "too many queens in a row";
+            return result;
+        }
+
+        for (uint64_t columns = queens; columns != 0; columns &= columns - 1)
+        {
+            const int column = GetLowestBit(columns);
+
+            if (++columnCounts[column] > QUEENS_PER_LINE)
+            {
+                result.reason = isSingleQueen ? "two queens in a column" : "too many queens in a column";
+                return result;
+            }
+
+            const int region = regions[row * rowStride + column];
+            if (region >= GridBoard::MAX_SIZE)
+            {
+                result.reason = "invalid region";
+                return result;
+            }
+            if (++regionCounts[region] > QUEENS_PER_LINE)
+            {
+                result.reason = isSingleQueen ? "two queens in a region" : "too many queens in a region";
+                return result;
+            }
+
+            // Exclusions go both ways, so looking backwards (rows above, and tiles to the left) finds every pair once
+            for (const RuleOffset& offset : exclusionOffsets)
+            {
+                if (offset.row > 0 || (offset.row == 0 && offset.column > 0))
+                {
+                    continue;
+                }
+
+                const int otherRow = GetOffsetLine<Rules>(row, offset.row, size);
+                const int otherColumn = GetOffsetLine<Rules>(column, offset.column, size);
+                if (otherRow >= 0 && otherColumn >= 0 && (rowQueens[otherRow] & Bit(otherColumn)) != 0)
+                {
+                    result.reason = EXCLUSION_RADIUS == 1 ? "queens touching" : "queens too close";
+                    return result;
+                }
+            }
+        }
+    }
+
+    // As many queens per row as per region, with as many regions as rows, means every region got its queens
+    for (int row = 0; row < size; row++)
+    {
+        for (int column = 0; column < size; column++)
+        {
+            const int region = regions[row * rowStride + column];
+            if (region >= GridBoard::MAX_SIZE || regionCounts[region] < QUEENS_PER_LINE)
+            {
+                result.reason = isSingleQueen ? "region without a queen" : "region without enough queens";
+                return result;
+            }
+        }
+    }
+
+    result.isValid = true;
+
+    return result;
+}
+
+GridDifficulty RateGrid(GridSolver& solver, const GridBoard& board)
+{
+    solver.SetBoard(board);
+    const uint64_t numSolutions = solver.Solve(2);
+    const GridSolverStats& stats = solver.GetStats();
+
+    if (numSolutions == 0)
+    {
+        return GridDifficulty::UNSOLVABLE;
+    }
+    if (numSolutions > 1)
+    {
+        return GridDifficulty::AMBIGUOUS;
+    }
+
+    // Without guesses, always placing the only possible queen of some row, column or region is enough
+    if (stats.guesses == 0)
+    {
+        return GridDifficulty::EASY;
+    }
+    if (stats.guesses <= static_cast<uint64_t>(board.size))
+    {
+        return GridDifficulty::MEDIUM;
+    }
+
+    return GridDifficulty::HARD;
+}
+
+const char* GetDifficultyName(GridDifficulty difficulty)
+{
+    switch (difficulty)
+    {
+    case GridDifficulty::EASY:
+        return "easy";
+    case GridDifficulty::MEDIUM:
+        return "medium";
+    case GridDifficulty::HARD:
+        return "hard";
+    case GridDifficulty::AMBIGUOUS:
+        return "ambiguous";
+    case GridDifficulty::UNSOLVABLE:
+        return "unsolvable";
+    default:
+        return "unknown";
+    }
+}
+
+// Every variant of the rules the tools know about
+template class BasicGridSolver<StandardRules>;
+template class BasicGridSolver<RadiusTwoRules>;
+template class BasicGridSolver<KnightRules>;
+template class BasicGridSolver<TwoQueensRules>;
+template class BasicGridSolver<ToroidalRules>;
@@ -0,0 +1,144 @@
+#ifndef GRID_SOLVER_HPP
+#define GRID_SOLVER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "RulePolicies.hpp"
+
+// Plain board (regions and queens) independent from SFML, small enough to be copied around and never allocating
+struct GridBoard
+{
+    static const int MAX_SIZE = 36; // region ids are written as a single base 36 character
+
+    int size = 0;
+    std::array<std::array<uint8_t, MAX_SIZE>, MAX_SIZE> regions = {}; // region id of every tile, [row][column]
+    std::array<int8_t, MAX_SIZE> queens = {}; // column of the queen in each row, -1 if there is none
+
+    void ClearQueens() { queens.fill(-1); }
+    int GetNumQueens() const;
+};
+
+struct GridCheckResult
+{
+    bool isValid = false;
+    const char* reason = ""; // why the board is not valid
+};
+
+struct GridSolverStats
+{
+    uint64_t nodes = 0; // queens placed during the search
+    uint64_t guesses = 0; // placements which had alternatives, i.e. could not be deduced
+    uint64_t forced = 0; // placements which were the only candidate of a row, column or region, i.e. deductions
+};
+
+struct GridSolverProgress
+{
+    GridSolverStats stats;
+    int depth = 0; // queens placed on the current path of the search
+    int maxDepth = 0;
+    uint64_t numSolutions = 0;
+};
+
+// Exhaustive solver: depth-first search on bitmasks, always branching on the row, column or region with the fewest
+// candidate tiles left (so forced moves come first), with dead rows, columns and regions pruned early.
+// The rules are a compile-time policy (see RulePolicies.hpp), instantiated in GridSolver.cpp for every variant.
+template <typename Rules>
+class BasicGridSolver
+{
+public:
+    BasicGridSolver() = default;
+    explicit BasicGridSolver(const GridBoard& board);
+
+    // Lets a long-lived solver (e.g. one per thread) be reused for another board without being reconstructed
+    void SetBoard(const GridBoard& board);
+    // Same, reading the region ids straight from a row-major grid owned by the caller, `rowStride` bytes apart
+    void SetRegions(int size, const uint8_t* regions, size_t rowStride);
+
+    // Searches until `maxSolutions` have been found, returns how many were found; the first one is written to `solution`
+    // (only its first queen of each row when the rules have several per row)
+    uint64_t Solve(uint64_t maxSolutions, GridBoard* solution = nullptr);
+
+    // Called every `intervalNodes` placements during Solve(), e.g. to report progress; returning false stops the search
+    using ProgressCallback = std::function<bool(const GridSolverProgress&)>;
+    void SetProgressCallback(ProgressCallback callback, uint64_t intervalNodes = 4096);
+    // Whether the last Solve() was stopped by the progress callback before the search was over
+    bool WasStopped() const { return m_isStopped; }
+
+    const GridSolverStats& GetStats() const { return m_stats; }
+    // Queen column of each row in the first solution found by the last Solve() (the leftmost one with several per row)
+    const std::array<int8_t, GridBoard::MAX_SIZE>& GetFirstSolution() const { return m_firstSolution; }
+    // Columns of the queens of each row in the first solution found by the last Solve(), as bitmasks
+    const std::array<uint64_t, GridBoard::MAX_SIZE>& GetFirstSolutionQueens() const { return m_firstSolutionQueens; }
+
+    // Whether the queens of a board make a completed level
+    static GridCheckResult Check(const GridBoard& board);
+    static GridCheckResult Check(int size, const uint8_t* regions, size_t rowStride, const int8_t* queens);
+    // Same, with the columns of the queens of each row as bitmasks, for the rules with several queens per row
+    static GridCheckResult CheckQueens(int size, const uint8_t* regions, size_t rowStride, const uint64_t* rowQueens);
+
+private:
+    static const int QUEENS_PER_LINE = Rules::QUEENS_PER_LINE;
+    static const int EXCLUSION_RADIUS = Rules::EXCLUSION_RADIUS;
+
+    int m_size = 0;
+    int m_numRegions = 0;
+    uint64_t m_allColumns = 0;
+    std::array<std::array<uint64_t, GridBoard::MAX_SIZE>, GridBoard::MAX_SIZE> m_regionRowMasks = {}; // [region][row], columns of the region in that row
+    // [row offset + radius][column], columns excluded by a queen in that column, in the row at that offset
+    std::array<std::array<uint64_t, GridBoard::MAX_SIZE>, 2 * EXCLUSION_RADIUS + 1> m_exclusionMasks = {};
+
+    // Search state
+    std::array<uint64_t, GridBoard::MAX_SIZE> m_rowQueens = {}; // [row], columns of the queens
+    uint64_t m_fullRows = 0;
+    uint64_t m_fullColumns = 0;
+    uint64_t m_fullRegions = 0;
+    std::array<uint8_t, GridBoard::MAX_SIZE> m_rowCounts = {}; // queens per row, column and region, only kept with several per line
+    std::array<uint8_t, GridBoard::MAX_SIZE> m_columnCounts = {};
+    std::array<uint8_t, GridBoard::MAX_SIZE> m_regionCounts = {};
+    std::array<uint64_t, GridBoard::MAX_SIZE> m_blockedByRegions = {}; // [row], columns belonging to regions which already have all their queens
+    std::array<uint64_t, GridBoard::MAX_SIZE> m_excludedTiles = {}; // [row], columns ruled out by the branches taken, only with several queens per line
+
+    uint64_t m_maxSolutions = 0;
+    uint64_t m_numSolutions = 0;
+    std::array<int8_t, GridBoard::MAX_SIZE> m_firstSolution = {};
+    std::array<uint64_t, GridBoard::MAX_SIZE> m_firstSolutionQueens = {};
+    GridBoard m_board;
+    GridSolverStats m_stats;
+    int m_maxDepth = 0;
+
+    ProgressCallback m_progressCallback;
+    uint64_t m_progressInterval = 0;
+    uint64_t m_nextProgressNodes = 0;
+    bool m_isStopped = false;
+
+    uint64_t GetRowCandidates(int row) const;
+    void PlaceQueen(int row, int column);
+    void RemoveQueen(int row, int column);
+    void Search(int numPlaced);
+    static int GetMissingQueens(int count);
+    void PlaceAndSearch(int row, int column, int numPlaced);
+    void ReportProgress(int depth);
+};
+
+// The rules of the game, which the tools and the game itself use
+using GridSolver = BasicGridSolver<StandardRules>;
+
+enum class GridDifficulty
+{
+    EASY, // every queen can be deduced
+    MEDIUM, // at most as many guesses as the board has rows, in total
+    HARD,
+    AMBIGUOUS, // more than one solution
+    UNSOLVABLE,
+    COUNT
+};
+
+// Difficulty of a level for a player. Looking for a second solution proves the first one is unique, and its search tree
+// is what a player has to get through. `solver` is only reused (e.g. one per thread), its stats are those of the search.
+GridDifficulty RateGrid(GridSolver& solver, const GridBoard& board);
+const char* GetDifficultyName(GridDifficulty difficulty); // as written by queens-cli rate
+
+#endif // GRID_SOLVER_HPP
@@ -0,0 +1,292 @@
+#include "InputRecorder.hpp"
+
+#include <cstring> // std::memcmp
+#include <fstream>
+#include <iterator> // std::istreambuf_iterator
+#include <string>
+#include <vector>
+
+#include "Log.hpp"
+
+namespace
+{
+// File layout:
+// - header: magic (4 bytes)
+// - events: time since the previous event in ms (varint) | type (1 byte) | payload
+//   - HOVER: x, y (zigzag varints)
+//   - CLICK: x, y (zigzag varints) | button (1 byte)
+//   - LOAD_LEVEL: name length (varint) | name
+// Mouse moves, by far the most common events, usually take 4 or 5 bytes
+const char RECORDING_MAGIC[4] = {'Q', 'R', 'C', '1'};
+
+void WriteVarint(std::string& buffer, uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    buffer += static_cast<char>(value);
+}
+
+void WriteSignedVarint(std::string& buffer, int32_t value)
+{
+    WriteVarint(buffer, (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+}
+
+bool ReadVarint(const std::string& data, size_t& pos, uint32_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35 && pos < data.size(); shift += 7)
+    {
+        const uint8_t byte = static_cast<uint8_t>(data[pos++]);
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool ReadSignedVarint(const std::string& data, size_t& pos, int32_t& value)
+{
+    uint32_t zigzag = 0;
+    if (!ReadVarint(data, pos, zigzag))
+    {
+        return false;
+    }
+    value = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+
+    return true;
+}
+} // namespace
+
+bool InputRecorder::StartRecording(const std::string& filePath, Level& level)
+{
+    StopRecording();
+
+    m_file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open())
+    {
+        LOG_ERROR(GENERAL) << "Input recording: " << filePath << " could not be created";
+        return false;
+    }
+    m_file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+
+    m_clock.restart();
+    m_lastTimestampMs = 0;
+    m_numRecordedEvents = 0;
+    m_lastHoverPos = {-1, -1};
+
+    m_recordedLevel = &level;
+    m_wasSolutionCacheEnabled = level.IsSolutionCacheEnabled();
+    level.SetSolutionCacheEnabled(false);
+
+    LOG_INFO(GENERAL) << "Recording input to " << filePath;
+
+    return true;
+}
+
+void InputRecorder::StopRecording()
+{
+    if (m_file.is_open())
+    {
+        m_file.close();
+        LOG_INFO(GENERAL) << "Input recording stopped, " << m_numRecordedEvents << " events recorded";
+    }
+
+    if (m_recordedLevel)
+    {
+        m_recordedLevel->SetSolutionCacheEnabled(m_wasSolutionCacheEnabled);
+        m_recordedLevel = nullptr;
+    }
+}
+
+void InputRecorder::Dispatch(Level& level, const InputEvent& event)
+{
+    if (IsRecording())
+    {
+        Record(event);
+    }
+
+    Apply(level, event);
+}
+
+void InputRecorder::Record(const InputEvent& event)
+{
+    if (event.type == InputEventType::HOVER)
+    {
+        if (event.mousePos == m_lastHoverPos)
+        {
+            return;
+        }
+        m_lastHoverPos = event.mousePos;
+    }
+
+    const uint32_t timestampMs = static_cast<uint32_t>(m_clock.getElapsedTime().asMilliseconds());
+
+    std::string buffer;
+    WriteVarint(buffer, timestampMs - m_lastTimestampMs);
+    buffer += static_cast<char>(event.type);
+    switch (event.type)
+    {
+    case InputEventType::HOVER:
+    case InputEventType::CLICK:
+        WriteSignedVarint(buffer, event.mousePos.x);
+        WriteSignedVarint(buffer, event.mousePos.y);
+        if (event.type == InputEventType::CLICK)
+        {
+            buffer += static_cast<char>(event.button);
+        }
+        break;
+    case InputEventType::LOAD_LEVEL:
+        WriteVarint(buffer, static_cast<uint32_t>(event.levelFileName.size()));
+        buffer += event.levelFileName;
+        break;
+    default:
+        break;
+    }
+
+    m_file.write(buffer.data(), buffer.size());
+    m_lastTimestampMs = timestampMs;
+    m_numRecordedEvents++;
+}
+
+void InputRecorder::Apply(Level& level, const InputEvent& event)
+{
+    switch (event.type)
+    {
+    case InputEventType::HOVER:
+        // We are only interested on hover events if the level has been loaded and has still not been completed
+        if (level.HasLoaded() && !level.IsCompleted())
+        {
+            level.ChangeHoveredTileColor(event.mousePos);
+        }
+        break;
+    case InputEventType::CLICK:
+        if (!level.IsCompleted())
+        {
+            level.MouseDetection(event.button, event.mousePos);
+        }
+        break;
+    case InputEventType::LOAD_LEVEL:
+        level.Clear();
+        level.Load(event.levelFileName);
+        break;
+    case InputEventType::RESET:
+        level.Reset();
+        break;
+    case InputEventType::SOLVE:
+        level.Solve();
+        break;
+    case InputEventType::HINT:
+        level.Hint();
+        break;
+    case InputEventType::COUNT:
+    default:
+        break;
+    }
+}
+
+bool InputRecorder::ReadRecording(const std::string& filePath, std::vector<InputEvent>& events)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    const std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(RECORDING_MAGIC) || std::memcmp(data.data(), RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0)
+    {
+        return false;
+    }
+
+    events.clear();
+
+    size_t pos = sizeof(RECORDING_MAGIC);
+    uint32_t timestampMs = 0;
+    while (pos < data.size())
+    {
+        InputEvent event;
+
+        uint32_t deltaMs = 0;
+        if (!ReadVarint(data, pos, deltaMs) || pos >= data.size())
+        {
+            // Truncated event (e.g. the program was killed while writing it), keep what was read until then
+            break;
+        }
+        timestampMs += deltaMs;
+        event.timestampMs = timestampMs;
+
+        const uint8_t type = static_cast<uint8_t>(data[pos++]);
+        if (type >= static_cast<uint8_t>(InputEventType::COUNT))
+        {
+            return false;
+        }
+        event.type = static_cast<InputEventType>(type);
+
+        bool isComplete = true;
+        switch (event.type)
+        {
+        case InputEventType::HOVER:
+        case InputEventType::CLICK:
+            isComplete = ReadSignedVarint(data, pos, event.mousePos.x) && ReadSignedVarint(data, pos, event.mousePos.y);
+            if (isComplete && event.type == InputEventType::CLICK)
+            {
+                isComplete = pos < data.size();
+                if (isComplete)
+                {
+                    event.button = static_cast<sf::Mouse::Button>(data[pos++]);
+                }
+            }
+            break;
+        case InputEventType::LOAD_LEVEL:
+        {
+            uint32_t length = 0;
+            isComplete = ReadVarint(data, pos, length) && pos + length <= data.size();
+            if (isComplete)
+            {
+                event.levelFileName = data.substr(pos, length);
+                pos += length;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (!isComplete)
+        {
+            break;
+        }
+
+        events.emplace_back(event);
+    }
+
+    return true;
+}
+
+const char* InputRecorder::GetEventTypeName(InputEventType type)
+{
+    switch (type)
+    {
+    case InputEventType::HOVER:
+        return "hover";
+    case InputEventType::CLICK:
+        return "click";
+    case InputEventType::LOAD_LEVEL:
+        return "load";
+    case InputEventType::RESET:
+        return "reset";
+    case InputEventType::SOLVE:
+        return "solve";
+    case InputEventType::HINT:
+        return "hint";
+    case InputEventType::COUNT:
+    default:
+        return "";
+    }
+}
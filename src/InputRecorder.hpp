@@ -0,0 +1,83 @@
+#ifndef INPUT_RECORDER_HPP
+#define INPUT_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "SFML/System/Clock.hpp"
+#include "SFML/System/Vector2.hpp"
+#include "SFML/Window/Mouse.hpp"
+
+#include "Level.hpp"
+
+enum class InputEventType : uint8_t
+{
+    HOVER,
+    CLICK,
+    LOAD_LEVEL,
+    RESET,
+    SOLVE,
+    HINT,
+    COUNT
+};
+
+struct InputEvent
+{
+    InputEventType type = InputEventType::HOVER;
+    uint32_t timestampMs = 0; // since the recording started
+    sf::Vector2i mousePos; // HOVER and CLICK, in level coordinates (see Level::MapPixelToLevel)
+    sf::Mouse::Button button = sf::Mouse::Left; // CLICK
+    std::string levelFileName; // LOAD_LEVEL
+};
+
+// Every input which changes the level goes through Dispatch, which applies it and, while recording, appends it to a
+// compact binary file. Replaying a file through Apply then runs exactly the same game logic, without a window.
+// What the solution cache holds changes from one session to the next, so the level is recorded without it (and
+// replayed without it too): Solve(), Hint() and Check() then take the same paths in both.
+class InputRecorder
+{
+public:
+    // Static member function to get the instance
+    static InputRecorder& getInstance()
+    {
+        static InputRecorder instance; // Guaranteed to be initialized only once
+        return instance;
+    }
+
+    // The level keeps its solution cache disabled until the recording stops, then gets its previous setting back
+    bool StartRecording(const std::string& filePath, Level& level);
+    void StopRecording();
+    bool IsRecording() const { return m_file.is_open(); }
+    size_t GetNumRecordedEvents() const { return m_numRecordedEvents; }
+
+    void Dispatch(Level& level, const InputEvent& event);
+
+    static void Apply(Level& level, const InputEvent& event);
+    static bool ReadRecording(const std::string& filePath, std::vector<InputEvent>& events);
+
+    static const char* GetEventTypeName(InputEventType type);
+
+    InputRecorder(const InputRecorder&) = delete; // Delete copy constructor
+    InputRecorder& operator =(const InputRecorder&) = delete; // Delete copy assignment operator
+
+private:
+    InputRecorder() = default; // Private constructor to prevent instantation
+    ~InputRecorder() = default; // Default destructor
+
+    std::ofstream m_file;
+    sf::Clock m_clock;
+    uint32_t m_lastTimestampMs = 0;
+    size_t m_numRecordedEvents = 0;
+    Level* m_recordedLevel = nullptr;
+    bool m_wasSolutionCacheEnabled = true;
+
+    // The game reports the hovered position every frame, but it is only recorded when it changes
+    sf::Vector2i m_lastHoverPos = {-1, -1};
+
+    void Record(const InputEvent& event);
+};
+
+#endif // INPUT_RECORDER_HPP
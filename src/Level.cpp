@@ -1,45 +1,40 @@
 #include "Level.hpp"
 
-#include <algorithm> // std::all_of
-#include <fstream>
-#include <iostream>
+#include <algorithm> // std::all_of, std::none_of, std::clamp, std::max, std::min
+#include <cmath> // std::floor, std::ceil
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "AllocationTracker.hpp"
+#include "BoardFormat.hpp"
 #include "GlobalSettings.hpp"
-#include "Tile.hpp"
-#include "UiSettings.hpp"
-
-// clang-format off
-
-// Define and initialize the REGIONS_COLORS static member variable (https://loading.io/color/feature/Set3-10/)
-const std::vector<ColorInfo> Level::REGIONS_COLORS = {
-    {"Turquoise",    sf::Color(141, 211, 199)},
-    {"Light yellow", sf::Color(255, 255, 179)},
-    {"Lavender",     sf::Color(190, 186, 218)},
-    {"Salmon",       sf::Color(251, 128, 114)},
-    {"Sky blue",     sf::Color(128, 177, 211)},
-    {"Light orange", sf::Color(253, 180, 98)},
-    {"Light green",  sf::Color(179, 222, 105)},
-    {"Light pink",   sf::Color(252, 205, 229)},
-    {"Light grey",   sf::Color(217, 217, 217)},
-    {"Purple",       sf::Color(188, 128, 189)}
-};
-
-// Define and initialize the NEIGHBOURS_OFFSETS static member variable
-const std::vector<sf::Vector2i> Level::NEIGHBOURS_OFFSETS = {
-    {-1, -1}, // top left
-    {-1,  0}, // top center
-    {-1,  1}, // top right
-    { 0, -1}, // left
-    { 0,  1}, // right
-    { 1, -1}, // bottom left
-    { 1,  0}, // bottom center
-    { 1,  1}  // bottom right
-};
-
-// clang-format on
+#include "Log.hpp"
+#include "Profiler.hpp"
+#include "RegionPalette.hpp"
+#include "ResourceManager.hpp"
+#include "SolutionCache.hpp"
+#include "Trace.hpp"
+
+namespace
+{
+void AppendQuad(sf::VertexArray& vertices, const sf::FloatRect& rect, const sf::Color& color)
+{
+    // Plain colored quads sample the white block of the atlas
+    const sf::IntRect& fillRect = ResourceManager::getInstance().getAtlasRect(AtlasRegion::FILL);
+    const sf::Vector2f texCoords(static_cast<float>(fillRect.left), static_cast<float>(fillRect.top));
+
+    vertices.append(sf::Vertex({rect.left, rect.top}, color, texCoords));
+    vertices.append(sf::Vertex({rect.left + rect.width, rect.top}, color, texCoords));
+    vertices.append(sf::Vertex({rect.left + rect.width, rect.top + rect.height}, color, texCoords));
+    vertices.append(sf::Vertex({rect.left, rect.top + rect.height}, color, texCoords));
+}
+} // namespace
+
+ColorInfo Level::GetRegionColor(int colorId)
+{
+    const RegionColor color = RegionPalette::GetColor(colorId);
+    return {RegionPalette::GetName(colorId), sf::Color(color.r, color.g, color.b)};
+}
 
 void Level::Init(const std::string& levelFileName)
 {
@@ -51,191 +46,602 @@ void Level::InitTilesFromRepr(const std::vector<std::vector<int>>& repr)
 {
     Clear();
 
-    if (repr.size() > 0)
+    if (!m_model.Init(repr))
     {
-        UiSettings::LEVEL_COLS = repr.size();
-        UiSettings::LEVEL_ROWS = repr[0].size();
+        return;
     }
 
-    // Initialise tiles depending on representation
-    for (size_t i = 0; i < repr.size(); i++)
+    m_numRows = m_model.GetNumRows();
+    m_numColumns = m_model.GetNumColumns();
+    m_topology.Build(m_model);
+    for (int colorId = 0; colorId < m_topology.GetNumRegions(); colorId++)
     {
-        std::vector<Tile> tiles_row;
-        const int numColumns = repr[i].size();
-        for (size_t j = 0; j < numColumns; j++)
+        m_regionsColors.emplace_back(GetRegionColor(colorId));
+    }
+
+    m_view.Init(m_model.GetNumTiles());
+
+    // Scratch buffers big enough for any row, column or region, so checks and rules never grow them
+    for (std::vector<TileIndex>& scratchTiles : m_scratchTiles)
+    {
+        scratchTiles.reserve(m_topology.GetMaxListSize());
+    }
+    m_queensInRow.reserve(m_numRows);
+    m_queensInColumn.reserve(m_numColumns);
+    m_queensInRegion.reserve(m_topology.GetNumRegions());
+    m_queens.reserve(m_numRows);
+    m_solutionScratch.reserve(m_numRows);
+    m_layoutScratch.reserve(m_numRows);
+    m_dynamicVertices = sf::VertexArray(sf::Quads, m_model.GetNumTiles() * LevelView::DYNAMIC_VERTICES_PER_TILE);
+
+    InvalidateStaticLayer();
+}
+
+bool Level::HasLoaded() const
+{
+    return !m_model.IsEmpty();
+}
+
+void Level::Clear()
+{
+    Reset();
+
+    m_model.Clear();
+    m_view.Clear();
+    m_topology.Clear();
+    m_numRows = 0;
+    m_numColumns = 0;
+    m_regionsColors.clear();
+    m_staticVertices.clear();
+    m_staticBorderRowStarts.clear();
+    m_dynamicVertices.clear();
+    m_hoveredTileCoords = {-1, -1};
+    m_visibleTiles = sf::IntRect();
+    m_isCameraFitPending = true;
+}
+
+void Level::Update(sf::RenderWindow& window)
+{
+    if (!HasLoaded())
+    {
+        return;
+    }
+
+    ScopedAllocations allocations(AllocationScope::RENDER);
+
+    UpdateCamera(window.getSize());
+    if (UpdateVisibleDynamicVertices() == 0)
+    {
+        return;
+    }
+
+    // The static layer is built lazily, so that loading a level does not require a graphics context
+    if (m_isStaticLayerDirty)
+    {
+        BuildStaticLayer();
+    }
+
+    // The static layer already covers the window as the camera sees it, while the marks are drawn through the camera
+    window.draw(m_staticLayerSprite);
+    Profiler::getInstance().AddDrawCalls(1);
+
+    const sf::View windowView = window.getView();
+    window.setView(m_camera);
+    DrawTileRange(window, m_dynamicVertices, LevelView::DYNAMIC_VERTICES_PER_TILE, sf::RenderStates(&ResourceManager::getInstance().getAtlasTexture()));
+    window.setView(windowView);
+}
+
+void Level::InvalidateStaticLayer()
+{
+    m_isStaticLayerDirty = true;
+}
+
+void Level::BuildStaticLayer()
+{
+    if (m_viewportSize.x == 0 || m_viewportSize.y == 0)
+    {
+        return;
+    }
+
+    if (m_staticVertices.getVertexCount() == 0)
+    {
+        BuildStaticVertices(m_staticVertices, m_staticBorderRowStarts);
+    }
+
+    // The layer is the size of the window, whatever the size of the level
+    if (m_staticLayer.getSize() != m_viewportSize)
+    {
+        m_staticLayer.create(m_viewportSize.x, m_viewportSize.y);
+        m_staticLayerSprite.setTexture(m_staticLayer.getTexture(), true);
+    }
+    m_staticLayer.setView(m_camera);
+    m_staticLayer.clear(sf::Color::Transparent);
+
+    const sf::RenderStates states(&ResourceManager::getInstance().getAtlasTexture());
+    DrawTileRange(m_staticLayer, m_staticVertices, LevelView::STATIC_VERTICES_PER_TILE, states);
+
+    // Region borders of the rows shown, then the frame around the level
+    const size_t firstBorderVertex = m_staticBorderRowStarts[m_visibleTiles.top];
+    const size_t frameFirstVertex = m_staticBorderRowStarts[m_numRows];
+    const size_t lastBorderVertex = m_staticBorderRowStarts[m_visibleTiles.top + m_visibleTiles.height];
+    if (lastBorderVertex > firstBorderVertex)
+    {
+        m_staticLayer.draw(&m_staticVertices[firstBorderVertex], lastBorderVertex - firstBorderVertex, sf::Quads, states);
+    }
+    m_staticLayer.draw(&m_staticVertices[frameFirstVertex], m_staticVertices.getVertexCount() - frameFirstVertex, sf::Quads, states);
+    m_staticLayer.display();
+    Profiler::getInstance().AddDrawCalls(2);
+
+    m_isStaticLayerDirty = false;
+}
+
+void Level::BuildStaticVertices(sf::VertexArray& vertices, std::vector<size_t>& borderRowStarts) const
+{
+    vertices.setPrimitiveType(sf::Quads);
+    vertices.resize(m_model.GetNumTiles() * LevelView::STATIC_VERTICES_PER_TILE);
+    for (int i = 0; i < m_numRows; i++)
+    {
+        for (int j = 0; j < m_numColumns; j++)
+        {
+            const TileIndex tile = m_model.GetIndex(i, j);
+            const sf::Color& color = m_regionsColors[m_model.GetRegion(tile)].second;
+            LevelView::WriteStaticVertices(LevelView::GetTilePosition(i, j), color, &vertices[tile * LevelView::STATIC_VERTICES_PER_TILE]);
+        }
+    }
+    AppendRegionBorders(vertices, borderRowStarts);
+}
+
+void Level::AppendRegionBorders(sf::VertexArray& vertices, std::vector<size_t>& borderRowStarts) const
+{
+    const float tileSize = static_cast<float>(GlobalSettings::TILE_SIZE);
+    const float border = GlobalSettings::REGION_BORDER_THICKNESS;
+
+    // Thick lines between tiles of different regions, grouped by row so the rows shown can be drawn on their own
+    borderRowStarts.assign(m_numRows + 1, 0);
+    for (int i = 0; i < m_numRows; i++)
+    {
+        borderRowStarts[i] = vertices.getVertexCount();
+        for (int j = 0; j < m_numColumns; j++)
         {
-            // id
-            const int id = (i * numColumns) + j;
+            const int region = m_model.GetRegion(i, j);
+            const sf::Vector2f pos = LevelView::GetTilePosition(i, j);
 
-            // colorId
-            const int colorId = repr[i][j];
-            if (colorId > Level::REGIONS_COLORS.size())
+            if (j + 1 < m_numColumns && m_model.GetRegion(i, j + 1) != region)
             {
-                std::cerr << "Levels with more than " << Level::REGIONS_COLORS.size() << " colors are not supported." << std::endl;
-                return;
+                AppendQuad(vertices, {pos.x + tileSize - border / 2, pos.y - border / 2, border, tileSize + border}, sf::Color::Black);
             }
-            const ColorInfo color = Level::REGIONS_COLORS[colorId % Level::REGIONS_COLORS.size()];
-            m_regionsColors[colorId] = color; // add color to the set, associated to its colorId
-            
-            // coords
-            const sf::Vector2i coords(i, j);
-            
-            // pos
-            const sf::Vector2f pos((j + 1) * GlobalSettings::TILE_SIZE, (i + 1) * GlobalSettings::TILE_SIZE);
+            if (i + 1 < m_numRows && m_model.GetRegion(i + 1, j) != region)
+            {
+                AppendQuad(vertices, {pos.x - border / 2, pos.y + tileSize - border / 2, tileSize + border, border}, sf::Color::Black);
+            }
+        }
+    }
+    borderRowStarts[m_numRows] = vertices.getVertexCount();
+
+    // Frame around the whole level
+    const sf::FloatRect& bounds = m_globalBounds;
+    AppendQuad(vertices, {bounds.left - border, bounds.top - border, bounds.width + 2 * border, border}, sf::Color::Black);
+    AppendQuad(vertices, {bounds.left - border, bounds.top + bounds.height, bounds.width + 2 * border, border}, sf::Color::Black);
+    AppendQuad(vertices, {bounds.left - border, bounds.top, border, bounds.height}, sf::Color::Black);
+    AppendQuad(vertices, {bounds.left + bounds.width, bounds.top, border, bounds.height}, sf::Color::Black);
+}
 
-            Tile tile(id, colorId, color.second, coords, pos);
-            tile.Init();
+void Level::DrawTileRange(sf::RenderTarget& target, const sf::VertexArray& vertices, size_t verticesPerTile, const sf::RenderStates& states) const
+{
+    const sf::IntRect& tiles = m_visibleTiles;
+    if (tiles.width <= 0 || tiles.height <= 0)
+    {
+        return;
+    }
 
-            tiles_row.emplace_back(tile);
-        }
+    // Tiles are stored row by row, so whole rows are a single range, and otherwise each row shown is a range of its own
+    if (tiles.width == m_numColumns)
+    {
+        const size_t firstVertex = static_cast<size_t>(tiles.top) * m_numColumns * verticesPerTile;
+        target.draw(&vertices[firstVertex], static_cast<size_t>(tiles.height) * m_numColumns * verticesPerTile, sf::Quads, states);
+        Profiler::getInstance().AddDrawCalls(1);
+        return;
+    }
 
-        m_tiles.emplace_back(tiles_row);
+    for (int row = tiles.top; row < tiles.top + tiles.height; row++)
+    {
+        const size_t firstVertex = (static_cast<size_t>(row) * m_numColumns + tiles.left) * verticesPerTile;
+        target.draw(&vertices[firstVertex], static_cast<size_t>(tiles.width) * verticesPerTile, sf::Quads, states);
     }
+    Profiler::getInstance().AddDrawCalls(tiles.height);
 }
 
-bool Level::HasLoaded()
+void Level::UpdateDynamicVertices()
 {
-    return m_tiles.size() > 0;
+    UpdateDynamicVertices(sf::IntRect(0, 0, m_numColumns, m_numRows));
 }
 
-void Level::Clear()
+size_t Level::UpdateVisibleDynamicVertices()
 {
-    Reset();
+    m_visibleTiles = GetVisibleTiles();
 
-    m_tiles.clear();
-    m_regionsColors.clear();
+    // Icons only a few pixels wide can not be told apart (and shimmer while zooming), so every mark switches to glyphs
+    const bool areTilesSmall = m_cameraZoom * GlobalSettings::TILE_SIZE < GlobalSettings::GLYPH_MAX_TILE_SIZE;
+    const TileDetail detail = areTilesSmall ? TileDetail::GLYPH : TileDetail::ICON;
+    if (detail != m_tileDetail)
+    {
+        m_tileDetail = detail;
+        m_view.InvalidateAll();
+    }
+
+    UpdateDynamicVertices(m_visibleTiles);
+
+    return static_cast<size_t>(m_visibleTiles.width) * m_visibleTiles.height;
 }
 
-void Level::Update(sf::RenderWindow& window)
+void Level::UpdateDynamicVertices(const sf::IntRect& tiles)
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    // Only the tiles whose mark or tint have changed since they were last written get their vertices rewritten.
+    // Tiles out of sight stay dirty until they are shown.
+    for (int i = tiles.top; i < tiles.top + tiles.height; i++)
     {
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
+        for (int j = tiles.left; j < tiles.left + tiles.width; j++)
         {
-            m_tiles[i][j].Draw(window);
+            const TileIndex tile = m_model.GetIndex(i, j);
+            if (m_view.IsDirty(tile))
+            {
+                sf::Vertex* vertices = &m_dynamicVertices[static_cast<size_t>(tile) * LevelView::DYNAMIC_VERTICES_PER_TILE];
+                m_view.WriteDynamicVertices(tile, LevelView::GetTilePosition(i, j), m_model.GetMark(tile), m_tileDetail, vertices);
+            }
         }
     }
 }
 
+void Level::UpdateCamera(const sf::Vector2u& viewportSize)
+{
+    if (viewportSize == m_viewportSize && !m_isCameraFitPending)
+    {
+        return;
+    }
+
+    m_viewportSize = viewportSize;
+    if (m_isCameraFitPending && HasLoaded())
+    {
+        FitCamera();
+    }
+    else
+    {
+        ApplyCamera();
+    }
+}
+
+void Level::FitCamera()
+{
+    m_isCameraFitPending = false;
+
+    // Levels which fit in the window stay where they have always been, at 1:1 scale
+    const float fitZoom = GetFitCameraZoom();
+    if (fitZoom >= 1.0f)
+    {
+        m_cameraZoom = 1.0f;
+        m_cameraCenter = sf::Vector2f(m_viewportSize.x / 2.0f, m_viewportSize.y / 2.0f);
+    }
+    else
+    {
+        m_cameraZoom = fitZoom;
+        m_cameraCenter = sf::Vector2f(m_globalBounds.left + m_globalBounds.width / 2.0f, m_globalBounds.top + m_globalBounds.height / 2.0f);
+    }
+
+    ApplyCamera();
+}
+
+void Level::ZoomCamera(const sf::Vector2i& pixel, float factor)
+{
+    const sf::Vector2f pixelOffset(pixel.x - m_viewportSize.x / 2.0f, pixel.y - m_viewportSize.y / 2.0f);
+    const sf::Vector2f levelPos = m_cameraCenter + pixelOffset / m_cameraZoom;
+
+    m_cameraZoom = std::clamp(m_cameraZoom * factor, std::min(1.0f, GetFitCameraZoom()), GlobalSettings::CAMERA_MAX_ZOOM);
+    m_cameraCenter = levelPos - pixelOffset / m_cameraZoom;
+
+    ApplyCamera();
+}
+
+void Level::PanCamera(const sf::Vector2i& pixelOffset)
+{
+    m_cameraCenter -= sf::Vector2f(static_cast<float>(pixelOffset.x), static_cast<float>(pixelOffset.y)) / m_cameraZoom;
+
+    ApplyCamera();
+}
+
+sf::Vector2i Level::MapPixelToLevel(const sf::Vector2i& pixel) const
+{
+    // Until the camera knows the size of the window, pixels and level coordinates are the same
+    if (m_viewportSize.x == 0 || m_viewportSize.y == 0)
+    {
+        return pixel;
+    }
+
+    const sf::Vector2f pixelOffset(pixel.x - m_viewportSize.x / 2.0f, pixel.y - m_viewportSize.y / 2.0f);
+    const sf::Vector2f levelPos = m_cameraCenter + pixelOffset / m_cameraZoom;
+
+    return sf::Vector2i(static_cast<int>(std::floor(levelPos.x)), static_cast<int>(std::floor(levelPos.y)));
+}
+
+void Level::ApplyCamera()
+{
+    const sf::Vector2f halfSize(m_viewportSize.x / 2.0f / m_cameraZoom, m_viewportSize.y / 2.0f / m_cameraZoom);
+
+    // At least a tile of the level always stays in sight
+    if (HasLoaded())
+    {
+        const float tileSize = static_cast<float>(GlobalSettings::TILE_SIZE);
+        const sf::FloatRect& bounds = m_globalBounds;
+        m_cameraCenter.x = std::clamp(m_cameraCenter.x, bounds.left + tileSize - halfSize.x, bounds.left + bounds.width - tileSize + halfSize.x);
+        m_cameraCenter.y = std::clamp(m_cameraCenter.y, bounds.top + tileSize - halfSize.y, bounds.top + bounds.height - tileSize + halfSize.y);
+    }
+
+    m_camera.setCenter(m_cameraCenter);
+    m_camera.setSize(halfSize * 2.0f);
+
+    InvalidateStaticLayer();
+}
+
+float Level::GetFitCameraZoom() const
+{
+    if (!HasLoaded() || m_viewportSize.x == 0 || m_viewportSize.y == 0)
+    {
+        return 1.0f;
+    }
+
+    // The whole level with a tile of margin around it
+    const float margin = 2.0f * GlobalSettings::TILE_SIZE;
+    return std::min(m_viewportSize.x / (m_globalBounds.width + margin), m_viewportSize.y / (m_globalBounds.height + margin));
+}
+
+sf::IntRect Level::GetVisibleTiles() const
+{
+    if (!HasLoaded() || m_viewportSize.x == 0 || m_viewportSize.y == 0)
+    {
+        return sf::IntRect();
+    }
+
+    const float tileSize = static_cast<float>(GlobalSettings::TILE_SIZE);
+    const sf::Vector2f halfSize(m_viewportSize.x / 2.0f / m_cameraZoom, m_viewportSize.y / 2.0f / m_cameraZoom);
+    const sf::Vector2f topLeft = m_cameraCenter - halfSize - sf::Vector2f(m_globalBounds.left, m_globalBounds.top);
+    const sf::Vector2f bottomRight = m_cameraCenter + halfSize - sf::Vector2f(m_globalBounds.left, m_globalBounds.top);
+
+    // One more tile on each side, as outlines and region borders overlap the neighbouring tiles
+    const int firstColumn = std::max(0, static_cast<int>(std::floor(topLeft.x / tileSize)) - 1);
+    const int firstRow = std::max(0, static_cast<int>(std::floor(topLeft.y / tileSize)) - 1);
+    const int endColumn = std::min(m_numColumns, static_cast<int>(std::ceil(bottomRight.x / tileSize)) + 1);
+    const int endRow = std::min(m_numRows, static_cast<int>(std::ceil(bottomRight.y / tileSize)) + 1);
+    if (endColumn <= firstColumn || endRow <= firstRow)
+    {
+        return sf::IntRect();
+    }
+
+    return sf::IntRect(firstColumn, firstRow, endColumn - firstColumn, endRow - firstRow);
+}
+
 void Level::InternalCheck()
 {
+    // Highlight the queens breaking the rules
+    UpdateConflicts();
+
     // Check if the level has been completed after each move
-    UiSettings::LEVEL_COMPLETED = Check();
-    if (UiSettings::LEVEL_COMPLETED && !UiSettings::POPUP_HAS_BEEN_CLOSED)
+    m_isCompleted = Check();
+    if (m_isCompleted && !m_hasCompletionPopupBeenClosed)
     {
         // If the level has been completed, we save the time it took to complete it
-        UiSettings::LEVEL_COMPLETED_TIME = static_cast<int>(m_clock.getElapsedTime().asSeconds());
+        m_completedTime = static_cast<int>(m_clock.getElapsedTime().asSeconds());
+    }
+
+    // Any completed board is a verified solution, so we keep it for the next time this level is played or solved
+    if (m_isCompleted && m_isSolutionCacheEnabled)
+    {
+        GetQueenLayout(m_layoutScratch);
+        SolutionCache::getInstance().Store(m_gridHash, m_layoutScratch);
     }
 }
 
-void Level::MouseDetection(sf::Mouse::Button mouseButton, const sf::Vector2i& mousePos)
+void Level::UpdateConflicts()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    if (!HasLoaded())
     {
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
+        return;
+    }
+
+    // Count the queens in each row, column and region...
+    std::vector<int>& queensInRow = m_queensInRow;
+    std::vector<int>& queensInColumn = m_queensInColumn;
+    std::vector<int>& queensInRegion = m_queensInRegion;
+    queensInRow.assign(m_numRows, 0);
+    queensInColumn.assign(m_numColumns, 0);
+    queensInRegion.assign(m_topology.GetNumRegions(), 0);
+    for (int i = 0; i < m_numRows; i++)
+    {
+        for (int j = 0; j < m_numColumns; j++)
         {
-            if (m_tiles[i][j].MouseDetection(mouseButton, mousePos))
+            const TileIndex tile = m_model.GetIndex(i, j);
+            if (IsQueen(tile))
             {
-                InternalCheck();
+                queensInRow[i]++;
+                queensInColumn[j]++;
+                queensInRegion[m_model.GetRegion(tile)]++;
+            }
+        }
+    }
+
+    // ... so a queen is in conflict if it shares any of them with another queen or if it touches another queen
+    for (int i = 0; i < m_numRows; i++)
+    {
+        for (int j = 0; j < m_numColumns; j++)
+        {
+            const TileIndex tile = m_model.GetIndex(i, j);
 
-                break;
+            bool isInConflict = false;
+            if (IsQueen(tile))
+            {
+                TileIndex neighbours[LevelTopology::MAX_NEIGHBOURS];
+                const int numNeighbours = m_topology.GetNeighbours(tile, neighbours);
+                isInConflict = queensInRow[i] > 1 || queensInColumn[j] > 1 || queensInRegion[m_model.GetRegion(tile)] > 1 ||
+                               GetNumberOfQueens(TileSpan(neighbours, neighbours + numNeighbours)) > 0;
             }
+
+            m_view.SetInConflict(tile, isInConflict);
         }
     }
 }
 
+void Level::MouseDetection(sf::Mouse::Button mouseButton, const sf::Vector2i& mousePos)
+{
+    sf::Vector2i coords;
+    if (!GetTileCoordsAtMousePos(mousePos, coords) || mouseButton != sf::Mouse::Button::Left)
+    {
+        return;
+    }
+
+    // Left clicks cycle through the marks: empty, X, queen and empty again
+    const TileIndex tile = m_model.GetIndex(coords.x, coords.y);
+    switch (m_model.GetMark(tile))
+    {
+    case Mark::EMPTY:
+        SetMark(tile, Mark::X);
+        break;
+    case Mark::X:
+        SetMark(tile, Mark::QUEEN);
+        break;
+    case Mark::QUEEN:
+    default:
+        SetMark(tile, Mark::EMPTY);
+        break;
+    }
+
+    InternalCheck();
+}
+
 bool Level::IsMousePosWithinLevelBounds(const sf::Vector2i& mousePos) const
 {
     return m_globalBounds.contains(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
 }
 
+bool Level::GetTileCoordsAtMousePos(const sf::Vector2i& mousePos, sf::Vector2i& coords) const
+{
+    if (!IsMousePosWithinLevelBounds(mousePos))
+    {
+        return false;
+    }
+
+    // Tiles are laid out in a regular grid starting at the top left corner of the level
+    const int column = static_cast<int>((mousePos.x - m_globalBounds.left) / GlobalSettings::TILE_SIZE);
+    const int row = static_cast<int>((mousePos.y - m_globalBounds.top) / GlobalSettings::TILE_SIZE);
+    coords = sf::Vector2i(row, column);
+
+    return IsCoordInBounds(coords);
+}
+
 void Level::ChangeHoveredTileColor(const sf::Vector2i& mousePos)
 {
-    if (IsMousePosWithinLevelBounds(mousePos))
+    sf::Vector2i coords;
+    const bool isOverTile = GetTileCoordsAtMousePos(mousePos, coords);
+    if (isOverTile && coords == m_hoveredTileCoords)
     {
-        for (size_t i = 0; i < m_tiles.size(); i++)
-        {
-            for (size_t j = 0; j < m_tiles[0].size(); j++)
-            {
-                if (m_tiles[i][j].MouseHover(mousePos))
-                {
-                    break;
-                }
-            }
-        }
+        return;
     }
-    // For the case that we are hovering over a tile but we go out of level bounds
-    // so the tile should reset its color
-    else
+
+    // The previously hovered tile (if any) gets its color back
+    if (m_hoveredTileCoords.x >= 0)
     {
-        for (size_t i = 0; i < m_tiles.size(); i++)
-        {
-            for (size_t j = 0; j < m_tiles[0].size(); j++)
-            {
-                if (m_tiles[i][j].WasBeingHovered())
-                {
-                    m_tiles[i][j].ResetColor();
-                    m_tiles[i][j].ResetHoverState();
+        m_view.SetHovered(m_model.GetIndex(m_hoveredTileCoords.x, m_hoveredTileCoords.y), false);
+    }
 
-                    break;
-                }
-            }
-        }
+    if (isOverTile)
+    {
+        m_view.SetHovered(m_model.GetIndex(coords.x, coords.y), true);
+        m_hoveredTileCoords = coords;
+    }
+    else
+    {
+        m_hoveredTileCoords = {-1, -1};
     }
 }
 
 void Level::PrintRepresentation()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (int i = 0; i < m_numRows; i++)
     {
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
+        std::string row;
+        for (int j = 0; j < m_numColumns; j++)
         {
-            std::cout << m_tiles[i][j].GetColorId();
+            row += std::to_string(m_model.GetRegion(i, j));
         }
-        std::cout << std::endl;
+        LOG_INFO(GENERAL) << row;
     }
 }
 
 void Level::Load(const std::string& levelFileName)
 {
+    TraceSpan span(TraceEvent::LOAD);
+    ScopedAllocations allocations(AllocationScope::LOAD);
+
     std::vector<std::vector<int>> repr;
+    if (!ReadRepr(std::string(GlobalSettings::LEVELS_PATH) + levelFileName, repr))
+    {
+        LOG_ERROR(LOAD) << "Level " << levelFileName << " could not be read";
+    }
+
+    LoadFromRepr(repr);
+    span.SetSuccess(HasLoaded());
+}
 
-    const std::string levelFilePath = std::string(GlobalSettings::LEVELS_PATH) + levelFileName;
-    std::ifstream levelFile(levelFilePath);
-    if (levelFile.is_open())
+bool Level::ReadRepr(const std::string& levelFilePath, std::vector<std::vector<int>>& repr)
+{
+    repr.clear();
+
+    std::string line;
+    std::string error;
+    GridBoard board;
+    if (!BoardFormat::ReadBoardFile(levelFilePath, line, board, error))
     {
-        std::string line;
-        while (getline(levelFile, line))
-        {
-            std::vector<int> row;
-            for (size_t i = 0; i < line.length(); i++)
-            {
-                const int tileNumber = static_cast<int>(line[i]) - 48; // 48 is the ASCII value of 0
-                row.emplace_back(tileNumber);
-            }
+        LOG_DEBUG(LOAD) << "Level " << levelFilePath << ": " << error;
+        return false;
+    }
 
-            repr.emplace_back(row);
+    repr.assign(board.size, std::vector<int>(board.size));
+    for (int i = 0; i < board.size; i++)
+    {
+        for (int j = 0; j < board.size; j++)
+        {
+            repr[i][j] = board.regions[i][j];
         }
-
-        levelFile.close();
     }
 
+    return true;
+}
+
+void Level::LoadFromRepr(const std::vector<std::vector<int>>& repr)
+{
     InitTilesFromRepr(repr);
 
+    m_gridHash = SolutionCache::HashGrid(repr);
+
     // Save level's coordinates
     if (HasLoaded())
     {
-        const Tile firstTile = m_tiles[0][0];
-        const sf::FloatRect firstTileGlobalBounds = firstTile.GetGlobalBounds();
-        const sf::Vector2f topLeftCoord = {firstTileGlobalBounds.top, firstTileGlobalBounds.left};
-        const sf::Vector2f sizeRect = sf::Vector2f(GlobalSettings::TILE_SIZE * m_tiles.size(), GlobalSettings::TILE_SIZE * m_tiles.size());
+        const sf::Vector2f topLeftCoord = LevelView::GetTilePosition(0, 0);
+        const sf::Vector2f sizeRect = sf::Vector2f(GlobalSettings::TILE_SIZE * m_numColumns, GlobalSettings::TILE_SIZE * m_numRows);
         m_globalBounds = sf::FloatRect(topLeftCoord, sizeRect);
     }
 }
 
 bool Level::Check()
 {
-    std::cout << "----- Checking start..." << std::endl;
+    TraceSpan span(TraceEvent::CHECK);
+    ScopedAllocations allocations(AllocationScope::CHECK);
+
+    // The rules decide, a known solution only gets there quicker: it obeys them (see IsSolution()), so a board with
+    // exactly its queens does too. Peeked, as Solve() and Hint() check the board right after their own lookup.
+    if (PeekSolution(m_layoutScratch) && MatchesSolution(m_layoutScratch))
+    {
+        return true;
+    }
+
+    LOG_DEBUG(CHECK) << "----- Checking start...";
     // 1 and only 1 Q in each row, column and colour region
     const bool rowsCheckSuccessful = CheckRows();
     const bool columnsCheckSuccessful = CheckColumns();
@@ -244,26 +650,29 @@ bool Level::Check()
     // 2 Qs cannot touch each other, not even diagonally
     const bool proximitiesCheckSuccessful = CheckProximities();
 
-    std::cout << "----- Checking end..." << std::endl;
+    LOG_DEBUG(CHECK) << "----- Checking end...";
 
-    return rowsCheckSuccessful && columnsCheckSuccessful && regionsCheckSuccessful && proximitiesCheckSuccessful;
+    const bool checkSuccessful = rowsCheckSuccessful && columnsCheckSuccessful && regionsCheckSuccessful && proximitiesCheckSuccessful;
+    span.SetSuccess(checkSuccessful);
+
+    return checkSuccessful;
 }
 
 bool Level::CheckRows()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (int i = 0; i < m_numRows; i++)
     {
-        const int numberOfQueensInRow = GetNumberOfQueensInVector(m_tiles[i]);
+        const int numberOfQueensInRow = GetNumberOfQueens(m_topology.GetRow(i));
         const int rowNumber = i + 1;
         if (numberOfQueensInRow == 0)
         {
-            std::cout << "No queen in row " << rowNumber << std::endl;
+            LOG_DEBUG(CHECK) << "No queen in row " << rowNumber;
 
             return false;
         }
         else if (numberOfQueensInRow > 1)
         {
-            std::cout << "More than 1 queen in row " << rowNumber << std::endl;
+            LOG_DEBUG(CHECK) << "More than 1 queen in row " << rowNumber;
 
             return false;
         }
@@ -274,27 +683,19 @@ bool Level::CheckRows()
 
 bool Level::CheckColumns()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (int i = 0; i < m_numColumns; i++)
     {
-        std::vector<Tile> column;
-        // Allocate the required memory for the vector in one go, so it avoids multiple allocations (which would involve copying the elements to a new memory location)
-        column.reserve(UiSettings::LEVEL_ROWS);
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
-        {
-            column.emplace_back(m_tiles[j][i]);
-        }
-
-        const int numberOfQueensInColumn = GetNumberOfQueensInVector(column);
+        const int numberOfQueensInColumn = GetNumberOfQueens(m_topology.GetColumn(i));
         const int columnNumber = i + 1;
         if (numberOfQueensInColumn == 0)
         {
-            std::cout << "No queen in column " << columnNumber << std::endl;
+            LOG_DEBUG(CHECK) << "No queen in column " << columnNumber;
 
             return false;
         }
         else if (numberOfQueensInColumn > 1)
         {
-            std::cout << "More than 1 queen in column " << columnNumber << std::endl;
+            LOG_DEBUG(CHECK) << "More than 1 queen in column " << columnNumber;
 
             return false;
         }
@@ -305,22 +706,25 @@ bool Level::CheckColumns()
 
 bool Level::CheckRegions()
 {
-    const size_t numRegions = m_regionsColors.size();
-    for (size_t i = 0; i < numRegions; i++)
+    for (int i = 0; i < m_topology.GetNumRegions(); i++)
     {
-        const std::vector<Tile>& regionTiles = GetTilesInRegion(m_regionsColors.at(i).first);
-        const int numberOfQueensInRegion = GetNumberOfQueensInVector(regionTiles);
-        const std::string colorStr = ColorIdToColorStr(i);
+        // Region ids which no tile uses are not regions
+        const TileSpan regionTiles = m_topology.GetRegion(i);
+        if (regionTiles.empty())
+        {
+            continue;
+        }
 
+        const int numberOfQueensInRegion = GetNumberOfQueens(regionTiles);
         if (numberOfQueensInRegion == 0)
         {
-            std::cout << "No queen in region " << colorStr << std::endl;
+            LOG_DEBUG(CHECK) << "No queen in region " << ColorIdToColorStr(i);
 
             return false;
         }
         else if (numberOfQueensInRegion > 1)
         {
-            std::cout << "More than 1 queen in region " << colorStr << std::endl;
+            LOG_DEBUG(CHECK) << "More than 1 queen in region " << ColorIdToColorStr(i);
 
             return false;
         }
@@ -331,27 +735,18 @@ bool Level::CheckRegions()
 
 bool Level::CheckProximities()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (TileIndex tile = 0; tile < m_model.GetNumTiles(); tile++)
     {
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
+        if (IsQueen(tile))
         {
-            if (m_tiles[i][j].isMarkQueen())
+            TileIndex neighbours[LevelTopology::MAX_NEIGHBOURS];
+            const int numNeighbours = m_topology.GetNeighbours(tile, neighbours);
+            const int numberOfQueensInProximity = GetNumberOfQueens(TileSpan(neighbours, neighbours + numNeighbours));
+            if (numberOfQueensInProximity > 0)
             {
-                const std::vector<Tile>& neighbours = GetNeighboursOfTile(m_tiles[i][j]);
-                int numberOfQueensInProximity = 0;
-                for (size_t k = 0; k < neighbours.size(); k++)
-                {
-                    if (neighbours[k].isMarkQueen())
-                    {
-                        numberOfQueensInProximity++;
-                    }
-                }
-                if (numberOfQueensInProximity > 0)
-                {
-                    std::cout << "Other queens in proximity of Queen in tile " << m_tiles[i][j].GetId() << std::endl;
+                LOG_DEBUG(CHECK) << "Other queens in proximity of Queen in tile " << tile;
 
-                    return false;
-                }
+                return false;
             }
         }
     }
@@ -359,46 +754,40 @@ bool Level::CheckProximities()
     return true;
 }
 
-std::vector<Tile> Level::GetNeighboursOfTile(const Tile& tile)
-{
-    std::vector<Tile> neighbours;
-
-    const sf::Vector2i& tileCoords = tile.GetCoords();
-    for (const sf::Vector2i& offset : Level::NEIGHBOURS_OFFSETS)
-    {
-        const sf::Vector2i& otherTileCoord = sf::Vector2i(tileCoords.x + offset.x, tileCoords.y + offset.y);
-        if (IsCoordInBounds(otherTileCoord))
-        {
-            const Tile& otherTile = m_tiles[otherTileCoord.x][otherTileCoord.y];
-            neighbours.emplace_back(otherTile);
-        }
-    }
-
-    return neighbours;
-}
-
-bool Level::IsCoordInBounds(const sf::Vector2i coord)
+bool Level::IsCoordInBounds(const sf::Vector2i coord) const
 {
     // clang-format off
     const bool xCoordIsNotNegative          = coord.x >= 0;
     const bool yCoordIsNotNegative          = coord.y >= 0;
-    const bool xCoordIsNotBiggerThanNumCols = coord.x < UiSettings::LEVEL_COLS;
-    const bool yCoordIsNotBiggerThanNumRows = coord.y < UiSettings::LEVEL_ROWS;
+    const bool xCoordIsNotBiggerThanNumRows = coord.x < m_numRows;
+    const bool yCoordIsNotBiggerThanNumCols = coord.y < m_numColumns;
     // clang-format on
 
     const bool isCoordInBounds =
-        xCoordIsNotNegative && yCoordIsNotNegative && xCoordIsNotBiggerThanNumCols && yCoordIsNotBiggerThanNumRows;
+        xCoordIsNotNegative && yCoordIsNotNegative && xCoordIsNotBiggerThanNumRows && yCoordIsNotBiggerThanNumCols;
 
     return isCoordInBounds;
 }
 
-int Level::GetNumberOfQueensInVector(const std::vector<Tile>& tiles) const
+void Level::SetMark(TileIndex tile, Mark mark)
+{
+    m_model.SetMark(tile, mark);
+    m_view.Invalidate(tile);
+}
+
+void Level::PlaceQueen(TileIndex tile)
+{
+    SetMark(tile, Mark::QUEEN);
+    m_queens.emplace_back(tile);
+}
+
+int Level::GetNumberOfQueens(TileSpan tiles) const
 {
     int numberOfQueens = 0;
 
-    for (size_t i = 0; i < tiles.size(); i++)
+    for (const TileIndex tile : tiles)
     {
-        if (tiles[i].isMarkQueen())
+        if (IsQueen(tile))
         {
             numberOfQueens++;
         }
@@ -407,54 +796,137 @@ int Level::GetNumberOfQueensInVector(const std::vector<Tile>& tiles) const
     return numberOfQueens;
 }
 
-std::vector<Tile> Level::GetEmptyTilesInVector(const std::vector<Tile>& tiles) const
+void Level::GetEmptyTiles(TileSpan tiles, std::vector<TileIndex>& emptyTiles) const
 {
-    std::vector<Tile> emptyTiles;
+    emptyTiles.clear();
 
-    for (size_t i = 0; i < tiles.size(); i++)
+    for (const TileIndex tile : tiles)
     {
-        if (tiles[i].isMarkEmpty())
+        if (IsEmpty(tile))
         {
-            emptyTiles.emplace_back(tiles[i]);
+            emptyTiles.emplace_back(tile);
         }
     }
-
-    return emptyTiles;
 }
 
 void Level::Reset()
 {
-    UiSettings::LEVEL_COMPLETED = false;
-    UiSettings::LEVEL_COMPLETED_TIME = INT_MAX;
-    UiSettings::POPUP_HAS_BEEN_CLOSED = false;
+    m_isCompleted = false;
+    m_completedTime = INT_MAX;
+    m_hasCompletionPopupBeenClosed = false;
+
+    m_model.ClearMarks();
+    for (TileIndex tile = 0; tile < m_model.GetNumTiles(); tile++)
+    {
+        m_view.SetInConflict(tile, false);
+    }
+    m_view.InvalidateAll();
+
+    m_queens.clear();
+
+    m_clock.restart();
+}
+
+bool Level::ToGridBoard(GridBoard& board) const
+{
+    if (!HasLoaded() || m_numRows != m_numColumns || m_numRows > GridBoard::MAX_SIZE)
+    {
+        return false;
+    }
 
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    board.size = m_numRows;
+    board.ClearQueens();
+    for (int i = 0; i < m_numRows; i++)
     {
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
+        for (int j = 0; j < m_numColumns; j++)
         {
-            m_tiles[i][j].ClearMark();
+            const TileIndex tile = m_model.GetIndex(i, j);
+            if (m_model.GetRegion(tile) >= GridBoard::MAX_SIZE)
+            {
+                return false;
+            }
+
+            board.regions[i][j] = static_cast<uint8_t>(m_model.GetRegion(tile));
+            if (IsQueen(tile))
+            {
+                board.queens[i] = static_cast<int8_t>(j);
+            }
         }
     }
 
+    return true;
+}
+
+void Level::PlaceSolution(const QueenLayout& solution)
+{
+    if (solution.size() != static_cast<size_t>(m_numRows))
+    {
+        return;
+    }
+
+    ApplySolution(solution);
+    InternalCheck();
+}
+
+std::vector<Mark> Level::GetMarks() const
+{
+    std::vector<Mark> marks;
+    marks.reserve(m_model.GetNumTiles());
+    for (TileIndex tile = 0; tile < m_model.GetNumTiles(); tile++)
+    {
+        marks.emplace_back(m_model.GetMark(tile));
+    }
+
+    return marks;
+}
+
+void Level::SetMarks(const std::vector<Mark>& marks)
+{
     m_queens.clear();
 
-    m_clock.restart();
+    for (TileIndex tile = 0; tile < m_model.GetNumTiles() && tile < marks.size(); tile++)
+    {
+        SetMark(tile, marks[tile]);
+        if (IsQueen(tile))
+        {
+            m_queens.emplace_back(tile);
+        }
+    }
 }
 
-void Level::Solve()
+bool Level::Solve()
 {
-    std::cout << "---------- Solving start..." << std::endl;
+    TraceSpan span(TraceEvent::SOLVE);
+    ScopedAllocations allocations(AllocationScope::SOLVE);
+
+    // If this level has already been solved before, we directly place the known solution
+    if (LookupSolution(m_solutionScratch))
+    {
+        ApplySolution(m_solutionScratch);
+        InternalCheck();
+        return true;
+    }
+
+    const bool moveDone = ApplyRules();
+    span.SetSuccess(moveDone);
+
+    return moveDone;
+}
+
+bool Level::ApplyRules()
+{
+    LOG_DEBUG(SOLVE) << "---------- Solving start...";
 
     // After each move, we will check if the level has been completed
     // also, we will only make 1 move at a time, so it is easy to track the changes
     bool moveDone = false;
 
     // 1 - For all queens, make sure all related crossing out has been done
-    moveDone = QueensCrossOutRelatedTiles();
+    moveDone = RunRule(TraceEvent::RULE_QUEENS_CROSS_OUT_RELATED_TILES);
     if (moveDone)
     {
         InternalCheck();
-        return;
+        return true;
     }
 
     // 2 - Check if there are regions with only 1 empty tile
@@ -462,39 +934,39 @@ void Level::Solve()
     //     - regions with exclusively only 1 tile
     //     - regions with more than 1 tile but only 1 empty one
     //     If so, mark it as a queen
-    moveDone = MarkQueenInRegionsWithOnlyOneEmptyTile();
+    moveDone = RunRule(TraceEvent::RULE_MARK_QUEEN_IN_REGIONS_WITH_ONLY_ONE_EMPTY_TILE);
     if (moveDone)
     {
         InternalCheck();
-        return;
+        return true;
     }
     
     // 3 - Check if there are any rows or columns with only 1 empty tile
     //     If so, mark it as a queen
-    moveDone = MarkQueenInRowsOrColumnsWithOnlyOneEmptyTile();
+    moveDone = RunRule(TraceEvent::RULE_MARK_QUEEN_IN_ROWS_OR_COLUMNS_WITH_ONLY_ONE_EMPTY_TILE);
     if (moveDone)
     {
         InternalCheck();
-        return;
+        return true;
     }
 
     // 4. Check if there are any rows or columns which are completely of the same colour
     //    If so, cross out the rest of the tiles in the region of that colour
     //    Edge case: if there's a row and a column of the same colour which coincide in a tile, mark it as a queen and cross out the rest of the tiles in the region
-    moveDone = CrossingOutTilesInRegionExceptRowOrColumn();
+    moveDone = RunRule(TraceEvent::RULE_CROSSING_OUT_TILES_IN_REGION_EXCEPT_ROW_OR_COLUMN);
     if (moveDone)
     {
         InternalCheck();
-        return;
+        return true;
     }
 
     // 5. Check if there any regions for which all its empty tiles are in the same row or column
     //    If so, cross out the rest of the tiles in the row or column which do not correspond to the region itself
-    moveDone = CrossOutRowOrColumnExceptRegion();
+    moveDone = RunRule(TraceEvent::RULE_CROSS_OUT_ROW_OR_COLUMN_EXCEPT_REGION);
     if (moveDone)
     {
         InternalCheck();
-        return;
+        return true;
     }
 
     // TODO
@@ -506,14 +978,74 @@ void Level::Solve()
     // 7 - Check if there any tiles that if marked as a queen, would make for a row, column or region to be completely crossed out
     //     if so, that tile should be crossed out because a queen cannot be placed there
 
-    std::cout << "---------- Solving end..." << std::endl;
+    // No rule could make any progress
+    LOG_DEBUG(SOLVE) << "---------- Solving end...";
+
+    return false;
+}
+
+void Level::Hint()
+{
+    ScopedAllocations allocations(AllocationScope::HINT);
+
+    QueenLayout& solution = m_solutionScratch;
+    if (!LookupSolution(solution))
+    {
+        // Without a known solution, the best hint we can give is the next deduction of the solver (the cache has just
+        // been looked up, so only the rules are left)
+        ApplyRules();
+        return;
+    }
+
+    // Place the first queen of the solution which is still missing
+    for (size_t i = 0; i < solution.size(); i++)
+    {
+        const TileIndex tile = m_model.GetIndex(static_cast<int>(i), solution[i]);
+        if (!IsQueen(tile))
+        {
+            PlaceQueen(tile);
+
+            InternalCheck();
+            return;
+        }
+    }
+}
+
+bool Level::RunRule(TraceEvent rule)
+{
+    TraceSpan span(rule);
+
+    bool moveDone = false;
+    switch (rule)
+    {
+    case TraceEvent::RULE_QUEENS_CROSS_OUT_RELATED_TILES:
+        moveDone = QueensCrossOutRelatedTiles();
+        break;
+    case TraceEvent::RULE_MARK_QUEEN_IN_REGIONS_WITH_ONLY_ONE_EMPTY_TILE:
+        moveDone = MarkQueenInRegionsWithOnlyOneEmptyTile();
+        break;
+    case TraceEvent::RULE_MARK_QUEEN_IN_ROWS_OR_COLUMNS_WITH_ONLY_ONE_EMPTY_TILE:
+        moveDone = MarkQueenInRowsOrColumnsWithOnlyOneEmptyTile();
+        break;
+    case TraceEvent::RULE_CROSSING_OUT_TILES_IN_REGION_EXCEPT_ROW_OR_COLUMN:
+        moveDone = CrossingOutTilesInRegionExceptRowOrColumn();
+        break;
+    case TraceEvent::RULE_CROSS_OUT_ROW_OR_COLUMN_EXCEPT_REGION:
+        moveDone = CrossOutRowOrColumnExceptRegion();
+        break;
+    default:
+        break;
+    }
+    span.SetSuccess(moveDone);
+
+    return moveDone;
 }
 
 bool Level::QueensCrossOutRelatedTiles()
 {
     bool crossedOutAnything = false;
     
-    for (const Tile& queen : m_queens)
+    for (const TileIndex queen : m_queens)
     {
         // clang-format off
         const bool crossedOutAnyTilesInRow       = CrossOutTilesInRow(queen);
@@ -528,26 +1060,27 @@ bool Level::QueensCrossOutRelatedTiles()
     return crossedOutAnything;
 }
 
-bool Level::CrossOutTilesInRow(const Tile& tile)
+bool Level::CrossOutTilesInRow(TileIndex tile)
 {
     bool crossedOutAny = false;
 
-    const sf::Vector2i& tileCoords = tile.GetCoords();
-    for (size_t j = 0; j < m_tiles.size(); j++)
+    const int row = m_model.GetRow(tile);
+    const int column = m_model.GetColumn(tile);
+    for (int j = 0; j < m_numColumns; j++)
     {
-        if (j != tileCoords.y)
+        if (j != column)
         {
-            Tile& tileCandidate = m_tiles[tileCoords.x][j];
+            const TileIndex tileCandidate = m_model.GetIndex(row, j);
             // Only if the tile has still not been marked as a Queen or X, i.e., it's empty
-            if (tileCandidate.isMarkEmpty())
+            if (IsEmpty(tileCandidate))
             {
-                tileCandidate.PlaceX();
+                SetMark(tileCandidate, Mark::X);
 
                 // We set the flag to true if we have crossed out any tile
                 if (!crossedOutAny)
                 {
                     // And log a message, but only once
-                    std::cout << "Crossing out tiles in row " << tileCoords.x << std::endl;
+                    LOG_INFO(SOLVE) << "Crossing out tiles in row " << row;
 
                     crossedOutAny = true;
                 }
@@ -558,26 +1091,27 @@ bool Level::CrossOutTilesInRow(const Tile& tile)
     return crossedOutAny;
 }
 
-bool Level::CrossOutTilesInColumn(const Tile& tile)
+bool Level::CrossOutTilesInColumn(TileIndex tile)
 {
     bool crossedOutAny = false;
 
-    const sf::Vector2i& tileCoords = tile.GetCoords();
-    for (size_t i = 0; i < m_tiles[0].size(); i++)
+    const int row = m_model.GetRow(tile);
+    const int column = m_model.GetColumn(tile);
+    for (int i = 0; i < m_numRows; i++)
     {
-        if (i != tileCoords.x)
+        if (i != row)
         {
-            Tile& tileCandidate = m_tiles[i][tileCoords.y];
+            const TileIndex tileCandidate = m_model.GetIndex(i, column);
             // Only if the tile has still not been marked as a Queen or X, i.e., it's empty
-            if (tileCandidate.isMarkEmpty())
+            if (IsEmpty(tileCandidate))
             {
-                tileCandidate.PlaceX();
+                SetMark(tileCandidate, Mark::X);
 
                 // We set the flag to true if we have crossed out any tile
                 if (!crossedOutAny)
                 {
                     // And log a message, but only once
-                    std::cout << "Crossing out tiles in column " << tileCoords.y << std::endl;
+                    LOG_INFO(SOLVE) << "Crossing out tiles in column " << column;
                     
                     crossedOutAny = true;
                 }
@@ -588,23 +1122,23 @@ bool Level::CrossOutTilesInColumn(const Tile& tile)
     return crossedOutAny;
 }
 
-bool Level::CrossOutTilesInProximity(const Tile& tile)
+bool Level::CrossOutTilesInProximity(TileIndex tile)
 {
     bool crossedOutAny = false;
 
-    const std::vector<Tile>& neighbours = GetNeighboursOfTile(tile);
-    for (const Tile& neighbour : neighbours)
+    TileIndex neighbours[LevelTopology::MAX_NEIGHBOURS];
+    const int numNeighbours = m_topology.GetNeighbours(tile, neighbours);
+    for (const TileIndex neighbour : TileSpan(neighbours, neighbours + numNeighbours))
     {
-        if (neighbour.isMarkEmpty())
+        if (IsEmpty(neighbour))
         {
-            const sf::Vector2i neighbourCoords = neighbour.GetCoords();
-            m_tiles[neighbourCoords.x][neighbourCoords.y].PlaceX();
+            SetMark(neighbour, Mark::X);
 
             // We set the flag to true if we have crossed out any tile
             if (!crossedOutAny)
             {
                 // And log a message, but only once
-                std::cout << "Crossing out tiles in proximity of tile " << tile.GetId() << std::endl;
+                LOG_INFO(SOLVE) << "Crossing out tiles in proximity of tile " << tile;
 
                 crossedOutAny = true;
             }
@@ -614,24 +1148,22 @@ bool Level::CrossOutTilesInProximity(const Tile& tile)
     return crossedOutAny;
 }
 
-bool Level::CrossOutTilesInRegion(const Tile& tile)
+bool Level::CrossOutTilesInRegion(TileIndex tile)
 {
     bool crossedOutAny = false;
 
-    const int tileColorId = tile.GetColorId();
-    const std::vector<Tile>& regionTiles = GetTilesInRegion(tileColorId);
-    for (const Tile& regionTile : regionTiles)
+    const int tileColorId = m_model.GetRegion(tile);
+    for (const TileIndex regionTile : m_topology.GetRegion(tileColorId))
     {
-        if (regionTile.isMarkEmpty())
+        if (IsEmpty(regionTile))
         {
-            const sf::Vector2i regionTileCoords = regionTile.GetCoords();
-            m_tiles[regionTileCoords.x][regionTileCoords.y].PlaceX();
+            SetMark(regionTile, Mark::X);
 
             // We set the flag to true if we have crossed out any tile
             if (!crossedOutAny)
             {
                 // And log a message, but only once
-                std::cout << "Crossing out tiles in region " << tileColorId << std::endl;
+                LOG_INFO(SOLVE) << "Crossing out tiles in region " << tileColorId;
 
                 crossedOutAny = true;
             }
@@ -643,23 +1175,20 @@ bool Level::CrossOutTilesInRegion(const Tile& tile)
 
 bool Level::MarkQueenInRegionsWithOnlyOneEmptyTile()
 {
-    const size_t numRegions = m_regionsColors.size();
-    for (size_t i = 0; i < numRegions; i++)
+    for (int i = 0; i < m_topology.GetNumRegions(); i++)
     {
-        const std::vector<Tile>& regionTiles = GetTilesInRegion(m_regionsColors.at(i).first);
-        const std::vector<Tile>& emptyTilesInRegion = GetEmptyTilesInVector(regionTiles);
+        std::vector<TileIndex>& emptyTilesInRegion = m_scratchTiles[0];
+        GetEmptyTiles(m_topology.GetRegion(i), emptyTilesInRegion);
 
         // If there is only 1 empty tile in the region
         if (emptyTilesInRegion.size() == 1)
         {
-            const Tile& tile = emptyTilesInRegion[0];
-            const sf::Vector2i& tileCoords = tile.GetCoords();
+            const TileIndex tile = emptyTilesInRegion[0];
             
             // We mark the tile as a queen
-            m_tiles[tileCoords.x][tileCoords.y].PlaceQueen();
-            m_queens.emplace_back(m_tiles[tileCoords.x][tileCoords.y]);
+            PlaceQueen(tile);
 
-            std::cout << "Region " << i + 1 << " has only 1 tile available, therefore marked it with a queen (coords.: [" << tileCoords.x << ", " << tileCoords.y << "])" << std::endl;
+            LOG_INFO(SOLVE) << "Region " << i + 1 << " has only 1 tile available, therefore marked it with a queen (coords.: [" << m_model.GetRow(tile) << ", " << m_model.GetColumn(tile) << "])";
             
             return true;
         }
@@ -670,42 +1199,34 @@ bool Level::MarkQueenInRegionsWithOnlyOneEmptyTile()
 
 bool Level::MarkQueenInRowsOrColumnsWithOnlyOneEmptyTile()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (int i = 0; i < m_numRows; i++)
     {
-        // Get the tiles in the row and column
-        const std::vector<Tile>& tilesInRow = GetTilesInRow(i);
-        const std::vector<Tile>& tilesInColumn = GetTilesInColumn(i);
-
         // Get the empty tiles in the row and column
-        const std::vector<Tile>& emptyTilesInRow = GetEmptyTilesInVector(tilesInRow);
-        const std::vector<Tile>& emptyTilesInColumn = GetEmptyTilesInVector(tilesInColumn);
+        std::vector<TileIndex>& emptyTilesInRow = m_scratchTiles[0];
+        std::vector<TileIndex>& emptyTilesInColumn = m_scratchTiles[1];
+        GetEmptyTiles(m_topology.GetRow(i), emptyTilesInRow);
+        GetEmptyTiles(m_topology.GetColumn(i), emptyTilesInColumn);
 
         // Select a tile from the row or column if any of them has only 1 empty tile
-
-        // This declares a pointer to a const Tile
-        // The pointer itself is not const, so it is posible to change what it points to
-        const Tile* tile = nullptr;
+        bool hasTile = false;
+        TileIndex tile = 0;
         if (emptyTilesInRow.size() == 1)
         {
-            // Here, we are changing the pointer to point to the first element of emptyTilesInRow. This is allowed because the pointer itself is not const
-            tile = &emptyTilesInRow[0];
+            tile = emptyTilesInRow[0];
+            hasTile = true;
         }
         else if (emptyTilesInColumn.size() == 1)
         {
-            // Similarly, we are changing the pointer to point to the first element of emptyTilesInColumn
-            tile = &emptyTilesInColumn[0];
+            tile = emptyTilesInColumn[0];
+            hasTile = true;
         }
         
-        if (tile)
+        if (hasTile)
         {
-            const sf::Vector2i& tileCoords = tile->GetCoords();
-            
             // We mark the tile as a queen
-            m_tiles[tileCoords.x][tileCoords.y].PlaceQueen();
-            m_queens.emplace_back(m_tiles[tileCoords.x][tileCoords.y]);
+            PlaceQueen(tile);
 
-            const std::string rowOrColumn = emptyTilesInRow.size() == 1 ? "Row" : "Column";
-            std::cout << rowOrColumn << " " << i + 1 << " has only 1 tile available, therefore marked it with a queen (coords.: [" << tileCoords.x << ", " << tileCoords.y << "])" << std::endl;
+            LOG_INFO(SOLVE) << (emptyTilesInRow.size() == 1 ? "Row" : "Column") << " " << i + 1 << " has only 1 tile available, therefore marked it with a queen (coords.: [" << m_model.GetRow(tile) << ", " << m_model.GetColumn(tile) << "])";
 
             return true;
         }
@@ -716,34 +1237,26 @@ bool Level::MarkQueenInRowsOrColumnsWithOnlyOneEmptyTile()
 
 bool Level::CrossingOutTilesInRegionExceptRowOrColumn()
 {
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (int i = 0; i < m_numRows; i++)
     {
-        for (size_t j = 0; j < m_tiles[0].size(); j++)
+        for (int j = 0; j < m_numColumns; j++)
         {
             // TODO: I'm pretty sure I'm over-checking here by going through all rows and columns...
             //       Try to come up with a better condition to optimise this
 
-            // Get the tiles in the row and the column
-            const std::vector<Tile>& tilesInRow = GetTilesInRow(i);
-            const std::vector<Tile>& tilesInColumn = GetTilesInColumn(j);
-
-            const int regionColorId = tilesInRow[0].GetColorId(); // or tilesInColumn[0].GetColorId(), it does not matter
+            const int regionColorId = m_model.GetRegion(i, 0); // the region of the first tile of the row
 
-            // Check if all tiles in the row or column belong to the same region
-            const bool tilesInRowBelongToTheSameRegion = std::all_of(tilesInRow.begin(), tilesInRow.end(), [&](const Tile& tile) {
-                return regionColorId == tile.GetColorId();
-            });
-            const bool tilesInColumnBelongToTheSameRegion = std::all_of(tilesInColumn.begin(), tilesInColumn.end(), [&](const Tile& tile) {
-                return regionColorId == tile.GetColorId();
-            });
+            // Check if all tiles in the row or column belong to that region
+            const bool tilesInRowBelongToTheSameRegion = m_topology.GetNumRegionsInRow(i) == 1;
+            const bool tilesInColumnBelongToTheSameRegion = m_topology.GetNumRegionsInColumn(j) == 1 && m_topology.DoesColumnCrossRegion(j, regionColorId);
 
             // Edge case: if there's a row and a column of the same colour which coincide in a tile, mark it as a queen
             if (tilesInRowBelongToTheSameRegion && tilesInColumnBelongToTheSameRegion)
             {
-                if (m_tiles[i][j].isMarkEmpty())
+                const TileIndex tile = m_model.GetIndex(i, j);
+                if (IsEmpty(tile))
                 {
-                    m_tiles[i][j].PlaceQueen();
-                    m_queens.emplace_back(m_tiles[i][j]);
+                    PlaceQueen(tile);
                     
                     return true;
                 }
@@ -751,30 +1264,33 @@ bool Level::CrossingOutTilesInRegionExceptRowOrColumn()
             else if (tilesInRowBelongToTheSameRegion)
             {
                 // Cross out all the other tiles in the region different that are not in this row and that are empty
-                const std::vector<Tile>& tilesInRegion = GetTilesInRegion(regionColorId);
-                for (const Tile& tile : tilesInRegion)
+                bool crossedOutAny = false;
+                for (const TileIndex tile : m_topology.GetRegion(regionColorId))
                 {
-                    if (tile.GetCoords().x != i && tile.isMarkEmpty())
+                    if (m_model.GetRow(tile) != i && IsEmpty(tile))
                     {
-                        m_tiles[tile.GetCoords().x][tile.GetCoords().y].PlaceX();
+                        SetMark(tile, Mark::X);
+                        crossedOutAny = true;
                     }
                 }
-                    
-                return true;
+
+                // Only a move if a tile was crossed out, otherwise the solver would keep running this rule
+                return crossedOutAny;
             }
             else if (tilesInColumnBelongToTheSameRegion)
             {
                 // Cross out all the other tiles in the region different that are not in this row and that are empty
-                const std::vector<Tile>& tilesInRegion = GetTilesInRegion(regionColorId);
-                for (const Tile& tile : tilesInRegion)
+                bool crossedOutAny = false;
+                for (const TileIndex tile : m_topology.GetRegion(regionColorId))
                 {
-                    if (tile.GetCoords().y != j && tile.isMarkEmpty())
+                    if (m_model.GetColumn(tile) != j && IsEmpty(tile))
                     {
-                        m_tiles[tile.GetCoords().x][tile.GetCoords().y].PlaceX();
+                        SetMark(tile, Mark::X);
+                        crossedOutAny = true;
                     }
                 }
 
-                return true;
+                return crossedOutAny;
             }
 
             return false;
@@ -786,56 +1302,52 @@ bool Level::CrossingOutTilesInRegionExceptRowOrColumn()
 
 bool Level::CrossOutRowOrColumnExceptRegion()
 {
-    const size_t numRegions = m_regionsColors.size();
-    for (size_t i = 0; i < numRegions; i++)
+    for (int i = 0; i < m_topology.GetNumRegions(); i++)
     {
-        const std::vector<Tile>& regionTiles = GetTilesInRegion(m_regionsColors.at(i).first);
-        const std::vector<Tile>& emptyTilesInRegion = GetEmptyTilesInVector(regionTiles);
+        std::vector<TileIndex>& emptyTilesInRegion = m_scratchTiles[0];
+        GetEmptyTiles(m_topology.GetRegion(i), emptyTilesInRegion);
 
         if (!emptyTilesInRegion.empty())
         {
-            const int rowCandidate = emptyTilesInRegion[0].GetCoords().x;
-            const int columnCandidate = emptyTilesInRegion[0].GetCoords().y;
+            const int rowCandidate = m_model.GetRow(emptyTilesInRegion[0]);
+            const int columnCandidate = m_model.GetColumn(emptyTilesInRegion[0]);
 
             // Check if all empty tiles in region are either in the same row or column
-            const bool allEmptyTilesInSameRow = std::all_of(emptyTilesInRegion.begin(), emptyTilesInRegion.end(), [&](const Tile& tile) {
-                return tile.GetCoords().x == rowCandidate;
+            const bool allEmptyTilesInSameRow = std::all_of(emptyTilesInRegion.begin(), emptyTilesInRegion.end(), [&](TileIndex tile) {
+                return m_model.GetRow(tile) == rowCandidate;
             });
-            const bool allEmptyTilesInSameColumn = std::all_of(emptyTilesInRegion.begin(), emptyTilesInRegion.end(), [&](const Tile& tile) {
-                return tile.GetCoords().y == columnCandidate;
+            const bool allEmptyTilesInSameColumn = std::all_of(emptyTilesInRegion.begin(), emptyTilesInRegion.end(), [&](TileIndex tile) {
+                return m_model.GetColumn(tile) == columnCandidate;
             });
 
             if (allEmptyTilesInSameRow || allEmptyTilesInSameColumn)
             {
                 // We get the rest of the tiles in the same row or column that do not belong to the region
-                const std::vector<Tile>& restOfTilesInSameRowOrColumn = allEmptyTilesInSameRow ? GetTilesInRow(rowCandidate) : GetTilesInColumn(columnCandidate);
-                std::vector<Tile> restOfTilesInSameRowOrColumnOfDifferentRegions;
-                for (const Tile& tile : restOfTilesInSameRowOrColumn)
+                const TileSpan restOfTilesInSameRowOrColumn = allEmptyTilesInSameRow ? m_topology.GetRow(rowCandidate) : m_topology.GetColumn(columnCandidate);
+                std::vector<TileIndex>& restOfTilesInSameRowOrColumnOfDifferentRegions = m_scratchTiles[1];
+                restOfTilesInSameRowOrColumnOfDifferentRegions.clear();
+                for (const TileIndex tile : restOfTilesInSameRowOrColumn)
                 {
-                    if (tile.GetColorId() != i)
+                    if (m_model.GetRegion(tile) != i)
                     {
                         restOfTilesInSameRowOrColumnOfDifferentRegions.emplace_back(tile);
                     }
                 }
-                const bool areRestOfTilesInSameRowOrColumnMarkedWithX = std::all_of(restOfTilesInSameRowOrColumnOfDifferentRegions.begin(), restOfTilesInSameRowOrColumnOfDifferentRegions.end(), [&](const Tile& tile) {
-                    return tile.isMarkX();
+                const bool areRestOfTilesInSameRowOrColumnMarked = std::none_of(restOfTilesInSameRowOrColumnOfDifferentRegions.begin(), restOfTilesInSameRowOrColumnOfDifferentRegions.end(), [&](TileIndex tile) {
+                    return IsEmpty(tile);
                 });
 
-                // If the rest of the tiles in the row or column are not marked with an X, we cross them out
+                // If some of the rest of the tiles in the row or column are still empty, we cross them out
                 // else, there's nothing else to do in this row
-                if (!areRestOfTilesInSameRowOrColumnMarkedWithX)
+                if (!areRestOfTilesInSameRowOrColumnMarked)
                 {
-                    const std::string rowOrColumn = allEmptyTilesInSameRow ? "row " + std::to_string(rowCandidate) : "column " + std::to_string(columnCandidate);
-                    std::cout << "Crossing out tiles in " << rowOrColumn << std::endl;
-                    for (size_t j = 0; j < m_tiles[0].size(); j++)
+                    LOG_INFO(SOLVE) << "Crossing out tiles in " << (allEmptyTilesInSameRow ? "row " : "column ") << (allEmptyTilesInSameRow ? rowCandidate : columnCandidate);
+                    for (const TileIndex tileCandidate : restOfTilesInSameRowOrColumnOfDifferentRegions)
                     {
-                        const sf::Vector2i& coords = allEmptyTilesInSameRow ? sf::Vector2i(rowCandidate, j) : sf::Vector2i(j, columnCandidate);
-                        const Tile& tileCandidate = m_tiles[coords.x][coords.y];
-
-                        // If the tile does not belong to the region and it is still empty, we cross it out
-                        if (tileCandidate.GetColorId() != i && tileCandidate.isMarkEmpty())
+                        // If the tile is still empty, we cross it out
+                        if (IsEmpty(tileCandidate))
                         {
-                            m_tiles[coords.x][coords.y].PlaceX();
+                            SetMark(tileCandidate, Mark::X);
                         }
                     }
 
@@ -848,76 +1360,116 @@ bool Level::CrossOutRowOrColumnExceptRegion()
     return false;
 }
 
-const std::vector<Tile>& Level::GetTilesInRow(int row) const
+bool Level::LookupSolution(QueenLayout& solution)
 {
-    return m_tiles[row];
+    if (!HasLoaded() || !m_isSolutionCacheEnabled)
+    {
+        return false;
+    }
+
+    return SolutionCache::getInstance().Lookup(m_gridHash, m_numRows, m_numColumns, solution) && IsSolution(solution);
 }
 
-std::vector<Tile> Level::GetTilesInColumn(int column) const
+bool Level::PeekSolution(QueenLayout& solution)
 {
-    std::vector<Tile> tiles;
-
-    for (size_t i = 0; i < m_tiles[0].size(); i++)
+    if (!HasLoaded() || !m_isSolutionCacheEnabled)
     {
-        tiles.emplace_back(m_tiles[i][column]);
+        return false;
     }
 
-    return tiles;
+    return SolutionCache::getInstance().Peek(m_gridHash, m_numRows, m_numColumns, solution) && IsSolution(solution);
 }
 
-std::vector<Tile> Level::GetTilesInRegion(int colorId) const
+bool Level::IsSolution(const QueenLayout& solution)
 {
-    std::vector<Tile> region;
+    if (solution.size() != static_cast<size_t>(m_numRows) || m_numRows != m_numColumns)
+    {
+        return false;
+    }
 
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    // 1 Q in each row by construction, then at most 1 in each column and region, and none touching the one of the row above
+    m_queensInColumn.assign(m_numColumns, 0);
+    m_queensInRegion.assign(m_topology.GetNumRegions(), 0);
+    for (int i = 0; i < m_numRows; i++)
     {
-        for (size_t j = 0; j < m_tiles[i].size(); j++)
+        const int column = solution[i];
+        if (column >= m_numColumns || ++m_queensInColumn[column] > 1 || ++m_queensInRegion[m_model.GetRegion(i, column)] > 1)
         {
-            const Tile& tileCandidate = m_tiles[i][j];
-            if (tileCandidate.GetColorId() == colorId)
-            {
-                region.emplace_back(tileCandidate);
-            }
+            return false;
+        }
+        if (i > 0 && column >= solution[i - 1] - 1 && column <= solution[i - 1] + 1)
+        {
+            return false;
+        }
+    }
+
+    // As many rows as columns, so every column has its queen: only the regions are left
+    for (int i = 0; i < m_topology.GetNumRegions(); i++)
+    {
+        if (m_queensInRegion[i] == 0 && !m_topology.GetRegion(i).empty())
+        {
+            return false;
         }
     }
 
-    return region;
+    return true;
 }
 
-std::vector<Tile> Level::GetTilesInRegion(const std::string& colorStr) const
+void Level::GetQueenLayout(QueenLayout& layout) const
 {
-    std::vector<Tile> region;
+    layout.assign(m_numRows, 0);
 
-    for (size_t i = 0; i < m_tiles.size(); i++)
+    for (int i = 0; i < m_numRows; i++)
     {
-        for (size_t j = 0; j < m_tiles[i].size(); j++)
+        for (int j = 0; j < m_numColumns; j++)
         {
-            const Tile& tileCandidate = m_tiles[i][j];
-            const int colorId = ColorStrToColorId(colorStr);
-            if (tileCandidate.GetColorId() == colorId)
+            if (IsQueen(m_model.GetIndex(i, j)))
             {
-                region.emplace_back(tileCandidate);
+                layout[i] = static_cast<uint16_t>(j);
             }
         }
     }
-
-    return region;
 }
 
-const std::string& Level::ColorIdToColorStr(int colorId) const
+bool Level::MatchesSolution(const QueenLayout& solution) const
 {
-    return m_regionsColors.at(colorId).first;
+    for (int i = 0; i < m_numRows; i++)
+    {
+        for (int j = 0; j < m_numColumns; j++)
+        {
+            // Every tile must be a queen if and only if the solution has a queen there
+            if (IsQueen(m_model.GetIndex(i, j)) != (solution[i] == j))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
 }
 
-int Level::ColorStrToColorId(const std::string& colorStr) const
+void Level::ApplySolution(const QueenLayout& solution)
 {
-    for (const auto& color : m_regionsColors)
+    m_queens.clear();
+
+    for (int i = 0; i < m_numRows; i++)
     {
-        if (color.second.first == colorStr)
+        for (int j = 0; j < m_numColumns; j++)
         {
-            return color.first;
+            const TileIndex tile = m_model.GetIndex(i, j);
+            if (solution[i] == j)
+            {
+                PlaceQueen(tile);
+            }
+            else if (m_model.GetMark(tile) != Mark::X)
+            {
+                SetMark(tile, Mark::X);
+            }
         }
     }
+}
 
-    return -1;
+const std::string& Level::ColorIdToColorStr(int colorId) const
+{
+    return m_regionsColors[colorId].first;
 }
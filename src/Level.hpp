@@ -1,15 +1,29 @@
 #ifndef LEVEL_HPP
 #define LEVEL_HPP
 
+#include <array>
+#include <climits> // INT_MAX
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "SFML/Graphics/Color.hpp"
 #include "SFML/Graphics/Rect.hpp"
+#include "SFML/Graphics/RenderTexture.hpp"
+#include "SFML/Graphics/RenderWindow.hpp"
+#include "SFML/Graphics/Sprite.hpp"
+#include "SFML/Graphics/VertexArray.hpp"
+#include "SFML/Graphics/View.hpp"
+#include "SFML/System/Clock.hpp"
 #include "SFML/System/Vector2.hpp"
+#include "SFML/Window/Mouse.hpp"
 
-#include "Tile.hpp"
+#include "GridSolver.hpp"
+#include "LevelModel.hpp"
+#include "LevelTopology.hpp"
+#include "LevelView.hpp"
+#include "SolutionCache.hpp"
+#include "Trace.hpp"
 
 using ColorInfo = std::pair<std::string, sf::Color>;
 
@@ -21,10 +35,22 @@ public:
 
     void Init(const std::string& levelFileName);
 
-    bool HasLoaded();
+    bool HasLoaded() const;
 
     void Clear();
     void Update(sf::RenderWindow& window);
+    void InvalidateStaticLayer();
+
+    // Camera: the level is drawn through a view which can be zoomed and panned, and only the tiles it shows are drawn.
+    // Mouse positions given to the level (hover, clicks) are in level coordinates, i.e. window pixels seen through it.
+    void UpdateCamera(const sf::Vector2u& viewportSize); // fits the level in the viewport after a load, keeps the zoom otherwise
+    void FitCamera();
+    void ZoomCamera(const sf::Vector2i& pixel, float factor); // the point under the pixel stays in place
+    void PanCamera(const sf::Vector2i& pixelOffset);
+    sf::Vector2i MapPixelToLevel(const sf::Vector2i& pixel) const;
+    const sf::View& GetCamera() const { return m_camera; }
+    float GetCameraZoom() const { return m_cameraZoom; } // window pixels per level unit
+
     void MouseDetection(sf::Mouse::Button mouseButton, const sf::Vector2i& mousePos);
 
     bool IsMousePosWithinLevelBounds(const sf::Vector2i& mousePos) const;
@@ -33,59 +59,153 @@ public:
     void PrintRepresentation();
 
     void Load(const std::string& levelFileName);
+    void LoadFromRepr(const std::vector<std::vector<int>>& repr);
+    // Region ids of a level file, row by row, as Load() reads them (e.g. to hash or rate levels without loading them)
+    static bool ReadRepr(const std::string& levelFilePath, std::vector<std::vector<int>>& repr);
 
     bool Check();
     void Reset();
-    void Solve();
+    bool Solve(); // returns whether a move could be made
+    void Hint();
+
+    // Regions and queens as a plain board, e.g. for the background solver; returns false if the level does not fit in one
+    bool ToGridBoard(GridBoard& board) const;
+    // Places a whole solution at once (queens and crosses), e.g. one found by the background solver
+    void PlaceSolution(const QueenLayout& solution);
+
+    // Marks of every tile, row by row, e.g. to save and restore the state of a board
+    std::vector<Mark> GetMarks() const;
+    void SetMarks(const std::vector<Mark>& marks);
+
+    // Applies a single deduction rule (one of the TraceEvent::RULE_* events), returns whether it made a move
+    bool RunRule(TraceEvent rule);
+
+    // Rendering helpers, also used on their own to benchmark vertex building.
+    // Static vertices are laid out tile by tile, row by row, then the region borders of each row start at
+    // borderRowStarts[row], and the frame around the level at borderRowStarts[numRows].
+    void BuildStaticVertices(sf::VertexArray& vertices, std::vector<size_t>& borderRowStarts) const;
+    void UpdateDynamicVertices(); // every dirty tile
+    size_t UpdateVisibleDynamicVertices(); // the dirty tiles the camera shows; returns the number of tiles it shows
 
     // Static variables
-    static const std::vector<ColorInfo> REGIONS_COLORS;
-    static const std::vector<sf::Vector2i> NEIGHBOURS_OFFSETS;
+    static ColorInfo GetRegionColor(int colorId); // see RegionPalette
 
     // Getters
     sf::Clock GetClock() const { return m_clock; }
+    uint64_t GetGridHash() const { return m_gridHash; }
+    int GetNumRows() const { return m_numRows; }
+    int GetNumColumns() const { return m_numColumns; }
+    bool IsCompleted() const { return m_isCompleted; }
+    int GetCompletedTime() const { return m_completedTime; } // in seconds, INT_MAX until the level is completed
+    bool HasCompletionPopupBeenClosed() const { return m_hasCompletionPopupBeenClosed; }
+    bool IsSolutionCacheEnabled() const { return m_isSolutionCacheEnabled; }
+
+    // Setters
+    void CloseCompletionPopup() { m_hasCompletionPopupBeenClosed = true; }
+    // Without the solution cache, checks and solves always go through the rules and never touch shared state
+    void SetSolutionCacheEnabled(bool enabled) { m_isSolutionCacheEnabled = enabled; }
 
 private:
-    std::vector<std::vector<Tile>> m_tiles;
-    std::unordered_map<int, ColorInfo> m_regionsColors;
+    // The game state (regions and marks) and the visual state (hover, conflicts, dirty vertices) of the tiles are kept
+    // apart, each as plain arrays of bytes indexed by TileIndex
+    LevelModel m_model;
+    LevelView m_view;
+    LevelTopology m_topology; // built once when the level is loaded
+
+    // Dimensions and completion state belong to each level, so several levels can be used at once (e.g. one per thread)
+    int m_numRows = 0;
+    int m_numColumns = 0;
+    bool m_isCompleted = false;
+    int m_completedTime = INT_MAX;
+    bool m_hasCompletionPopupBeenClosed = false;
+
+    // Rendering
+    sf::VertexArray m_staticVertices; // fills, grid lines and region borders, which never change once the level is loaded
+    std::vector<size_t> m_staticBorderRowStarts;
+    sf::RenderTexture m_staticLayer; // the static vertices the camera shows, rendered again only when the camera moves
+    sf::Sprite m_staticLayerSprite;
+    bool m_isStaticLayerDirty = true;
+    sf::VertexArray m_dynamicVertices; // tints and marks of all tiles, drawn on top of the static layer
+    TileDetail m_tileDetail = TileDetail::ICON;
+
+    // Camera
+    sf::View m_camera;
+    sf::Vector2f m_cameraCenter;
+    float m_cameraZoom = 1.0f;
+    sf::Vector2u m_viewportSize;
+    bool m_isCameraFitPending = true;
+    sf::IntRect m_visibleTiles; // columns (left, width) and rows (top, height) the camera shows
+    std::vector<ColorInfo> m_regionsColors; // [region]
     sf::FloatRect m_globalBounds;
+    sf::Vector2i m_hoveredTileCoords = {-1, -1}; // {-1, -1} when no tile is being hovered
     sf::Clock m_clock;
-    std::vector<Tile> m_queens; // helper member variable to keep track of queens
+    std::vector<TileIndex> m_queens; // helper member variable to keep track of queens
+
+    // Scratch buffers of the checks and the rules, sized when the level is loaded, so a solve step never allocates
+    std::array<std::vector<TileIndex>, 2> m_scratchTiles; // e.g. the empty tiles of a row and of a column
+    std::vector<int> m_queensInRow;
+    std::vector<int> m_queensInColumn;
+    std::vector<int> m_queensInRegion;
+    QueenLayout m_solutionScratch; // known solution, when solving or giving a hint
+    QueenLayout m_layoutScratch; // known solution when checking, then the queens of the completed level
+    uint64_t m_gridHash = 0; // key of the level in the solution cache
+    bool m_isSolutionCacheEnabled = true;
 
     // Helper functions
     void InitTilesFromRepr(const std::vector<std::vector<int>>& repr);
+    void BuildStaticLayer();
+    void AppendRegionBorders(sf::VertexArray& vertices, std::vector<size_t>& borderRowStarts) const;
+    void DrawTileRange(sf::RenderTarget& target, const sf::VertexArray& vertices, size_t verticesPerTile, const sf::RenderStates& states) const;
+
+    // 'Camera' helper functions
+    void ApplyCamera();
+    float GetFitCameraZoom() const;
+    sf::IntRect GetVisibleTiles() const;
+    void UpdateDynamicVertices(const sf::IntRect& tiles);
 
-    int GetNumberOfQueensInVector(const std::vector<Tile>& tiles) const;
-    std::vector<Tile> GetEmptyTilesInVector(const std::vector<Tile>& tiles) const;
+    bool GetTileCoordsAtMousePos(const sf::Vector2i& mousePos, sf::Vector2i& coords) const;
 
-    const std::vector<Tile>& GetTilesInRow(int row) const;
-    std::vector<Tile> GetTilesInColumn(int column) const;
+    // 'Tile' helper functions
+    bool IsQueen(TileIndex tile) const { return m_model.GetMark(tile) == Mark::QUEEN; }
+    bool IsEmpty(TileIndex tile) const { return m_model.GetMark(tile) == Mark::EMPTY; }
+    void SetMark(TileIndex tile, Mark mark);
+    void PlaceQueen(TileIndex tile);
 
-    std::vector<Tile> GetTilesInRegion(int colorId) const;
-    std::vector<Tile> GetTilesInRegion(const std::string& colorStr) const;
+    int GetNumberOfQueens(TileSpan tiles) const;
+    void GetEmptyTiles(TileSpan tiles, std::vector<TileIndex>& emptyTiles) const;
 
     // 'Check' helper functions
     void InternalCheck();
+    void UpdateConflicts();
     bool CheckRows();
     bool CheckColumns();
     bool CheckRegions();
     bool CheckProximities();
 
     // 'Proximity' helper functions
-    std::vector<Tile> GetNeighboursOfTile(const Tile& tile);
-    bool IsCoordInBounds(const sf::Vector2i coord);
+    bool IsCoordInBounds(const sf::Vector2i coord) const;
 
     // 'Cross out' helper functions
-    bool CrossOutTilesInRow(const Tile& tile);
-    bool CrossOutTilesInColumn(const Tile& tile);
-    bool CrossOutTilesInProximity(const Tile& tile);
-    bool CrossOutTilesInRegion(const Tile& tile);
+    bool CrossOutTilesInRow(TileIndex tile);
+    bool CrossOutTilesInColumn(TileIndex tile);
+    bool CrossOutTilesInProximity(TileIndex tile);
+    bool CrossOutTilesInRegion(TileIndex tile);
+
+    // 'Solution cache' helper functions
+    // The cached solution of this level, if it obeys the rules (a hash collision could give that of another grid).
+    // Peeking does not count as a lookup in the cache statistics.
+    bool LookupSolution(QueenLayout& solution);
+    bool PeekSolution(QueenLayout& solution);
+    bool IsSolution(const QueenLayout& solution);
+    void GetQueenLayout(QueenLayout& layout) const;
+    bool MatchesSolution(const QueenLayout& solution) const;
+    void ApplySolution(const QueenLayout& solution);
 
     // 'Color' helper functions
     const std::string& ColorIdToColorStr(int colorId) const;
-    int ColorStrToColorId(const std::string& colorStr) const;
 
     // 'Solve' helper functions
+    bool ApplyRules(); // the first move the rules can make, without looking up the solution
     /* 1 */ bool QueensCrossOutRelatedTiles();
     /* 2 */ bool MarkQueenInRegionsWithOnlyOneEmptyTile();
     /* 3 */ bool MarkQueenInRowsOrColumnsWithOnlyOneEmptyTile();
@@ -0,0 +1,287 @@
+#include "LevelIndex.hpp"
+
+#include <algorithm> // std::sort, std::lower_bound, std::partition_point, std::remove_if, std::min
+#include <cctype> // std::tolower
+#include <filesystem>
+#include <utility> // std::pair, std::move
+
+#include "Level.hpp"
+#include "Log.hpp"
+#include "SolutionCache.hpp"
+
+namespace
+{
+void ToLower(const std::string& text, std::string& lowerText)
+{
+    lowerText.resize(text.size());
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        lowerText[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+    }
+}
+
+bool StartsWith(const std::string& text, const std::string& prefix)
+{
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Back to the board Level::ReadRepr() read, for the solver
+bool ReprToBoard(const std::vector<std::vector<int>>& repr, GridBoard& board)
+{
+    const int size = static_cast<int>(repr.size());
+    if (size == 0 || size > GridBoard::MAX_SIZE)
+    {
+        return false;
+    }
+
+    board.size = size;
+    board.ClearQueens();
+    for (int row = 0; row < size; row++)
+    {
+        if (static_cast<int>(repr[row].size()) != size)
+        {
+            return false;
+        }
+        for (int column = 0; column < size; column++)
+        {
+            const int region = repr[row][column];
+            if (region < 0 || region >= GridBoard::MAX_SIZE)
+            {
+                return false;
+            }
+            board.regions[row][column] = static_cast<uint8_t>(region);
+        }
+    }
+
+    return true;
+}
+} // namespace
+
+LevelIndex::~LevelIndex()
+{
+    Stop();
+}
+
+void LevelIndex::Build(const std::string& directory)
+{
+    std::vector<std::string> names;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        const auto& path = entry.path();
+        if (path.extension() == ".txt")
+        {
+            names.emplace_back(path.filename().string());
+        }
+    }
+    if (error)
+    {
+        LOG_ERROR(LOAD) << "Levels directory " << directory << " could not be read: " << error.message();
+    }
+
+    Build(std::move(names), directory);
+}
+
+void LevelIndex::Build(std::vector<std::string> names, const std::string& directory)
+{
+    Stop();
+
+    m_directory = directory;
+
+    // Sorted without case, so a prefix matches a contiguous range of levels
+    std::vector<std::pair<std::string, std::string>> sortedNames(names.size());
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        ToLower(names[i], sortedNames[i].first);
+        sortedNames[i].second = std::move(names[i]);
+    }
+    std::sort(sortedNames.begin(), sortedNames.end());
+
+    m_names.resize(sortedNames.size());
+    m_searchNames.resize(sortedNames.size());
+    for (size_t i = 0; i < sortedNames.size(); i++)
+    {
+        m_searchNames[i] = std::move(sortedNames[i].first);
+        m_names[i] = std::move(sortedNames[i].second);
+    }
+    m_sizes.assign(m_names.size(), 0);
+    m_difficulties.assign(m_names.size(), UNKNOWN_DIFFICULTY);
+    m_isSolved.assign(m_names.size(), 0);
+    m_numRated = 0;
+    m_version++;
+    m_hasSearched = false;
+
+    if (!m_names.empty())
+    {
+        m_thread = std::thread(&LevelIndex::Run, this);
+    }
+}
+
+bool LevelIndex::Update()
+{
+    m_takenDetails.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_takenDetails.swap(m_publishedDetails);
+    }
+    if (m_takenDetails.empty())
+    {
+        return false;
+    }
+
+    const SolutionCache& solutionCache = SolutionCache::getInstance();
+    for (const LevelDetails& details : m_takenDetails)
+    {
+        m_sizes[details.level] = details.size;
+        m_difficulties[details.level] = details.difficulty;
+        m_isSolved[details.level] = solutionCache.Contains(details.gridHash) ? 1 : 0;
+    }
+    m_numRated += m_takenDetails.size();
+    m_version++;
+
+    if (!IsRating() && m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    return true;
+}
+
+int LevelIndex::FindLevel(const std::string& name) const
+{
+    std::string searchName;
+    ToLower(name, searchName);
+
+    const auto first = std::lower_bound(m_searchNames.begin(), m_searchNames.end(), searchName);
+    for (auto it = first; it != m_searchNames.end() && *it == searchName; ++it)
+    {
+        const size_t level = static_cast<size_t>(it - m_searchNames.begin());
+        if (m_names[level] == name)
+        {
+            return static_cast<int>(level);
+        }
+    }
+
+    return -1;
+}
+
+const std::vector<uint32_t>& LevelIndex::Search(const LevelFilter& filter)
+{
+    const bool hasSameFilters = m_hasSearched && filter.mode == m_lastFilter.mode && filter.size == m_lastFilter.size && filter.difficulty == m_lastFilter.difficulty && filter.solved == m_lastFilter.solved;
+    const bool hasSameDetails = !filter.UsesDetails() || m_version == m_lastVersion;
+    if (hasSameFilters && hasSameDetails && filter.query == m_lastFilter.query)
+    {
+        return m_matches;
+    }
+
+    const std::string previousQuery = m_query;
+    ToLower(filter.query, m_query);
+
+    if (hasSameFilters && hasSameDetails && m_query.size() > previousQuery.size() && StartsWith(m_query, previousQuery))
+    {
+        // Typing on: the matches can only be some of the previous ones
+        m_matches.erase(std::remove_if(m_matches.begin(), m_matches.end(), [&](uint32_t level) { return !Matches(level, filter, m_query); }), m_matches.end());
+    }
+    else
+    {
+        size_t first = 0;
+        size_t last = m_names.size();
+        if (filter.mode == LevelSearchMode::PREFIX)
+        {
+            const auto begin = std::lower_bound(m_searchNames.begin(), m_searchNames.end(), m_query);
+            const auto end = std::partition_point(begin, m_searchNames.end(), [&](const std::string& name) { return StartsWith(name, m_query); });
+            first = static_cast<size_t>(begin - m_searchNames.begin());
+            last = static_cast<size_t>(end - m_searchNames.begin());
+        }
+
+        m_matches.clear();
+        for (size_t level = first; level < last; level++)
+        {
+            if (Matches(level, filter, m_query))
+            {
+                m_matches.emplace_back(static_cast<uint32_t>(level));
+            }
+        }
+    }
+
+    m_lastFilter = filter;
+    m_lastVersion = m_version;
+    m_hasSearched = true;
+
+    return m_matches;
+}
+
+void LevelIndex::Stop()
+{
+    if (m_thread.joinable())
+    {
+        m_isCancelRequested = true;
+        m_thread.join();
+        m_isCancelRequested = false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_publishedDetails.clear();
+}
+
+void LevelIndex::Run()
+{
+    // Reused from level to level
+    std::vector<std::vector<int>> repr;
+    GridBoard board;
+    GridSolver solver;
+    std::vector<LevelDetails> batch;
+    batch.reserve(PUBLISH_BATCH_SIZE);
+
+    // A single rating can take long on a big or ambiguous level, so the search stops early when Stop() is waiting
+    solver.SetProgressCallback([this](const GridSolverProgress& progress) {
+        return !m_isCancelRequested && progress.stats.nodes < RATING_MAX_NODES;
+    }, RATING_PROGRESS_INTERVAL_NODES);
+
+    for (size_t level = 0; level < m_names.size() && !m_isCancelRequested; level++)
+    {
+        LevelDetails details;
+        details.level = static_cast<uint32_t>(level);
+        if (Level::ReadRepr(m_directory + m_names[level], repr))
+        {
+            details.size = static_cast<uint8_t>(std::min<size_t>(repr.size(), UINT8_MAX));
+            details.gridHash = SolutionCache::HashGrid(repr);
+            if (ReprToBoard(repr, board))
+            {
+                const GridDifficulty difficulty = RateGrid(solver, board);
+                if (!solver.WasStopped())
+                {
+                    details.difficulty = static_cast<uint8_t>(difficulty);
+                }
+            }
+        }
+        batch.emplace_back(details);
+
+        if (batch.size() == PUBLISH_BATCH_SIZE || level + 1 == m_names.size())
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_publishedDetails.insert(m_publishedDetails.end(), batch.begin(), batch.end());
+            batch.clear();
+        }
+    }
+}
+
+bool LevelIndex::Matches(size_t level, const LevelFilter& filter, const std::string& query) const
+{
+    if (filter.size != 0 && m_sizes[level] != filter.size)
+    {
+        return false;
+    }
+    if (filter.difficulty >= 0 && m_difficulties[level] != filter.difficulty)
+    {
+        return false;
+    }
+    if (filter.solved != LevelSolvedFilter::ANY && IsSolved(level) != (filter.solved == LevelSolvedFilter::SOLVED))
+    {
+        return false;
+    }
+
+    const std::string& name = m_searchNames[level];
+    return filter.mode == LevelSearchMode::PREFIX ? StartsWith(name, query) : name.find(query) != std::string::npos;
+}
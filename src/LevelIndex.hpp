@@ -0,0 +1,121 @@
+#ifndef LEVEL_INDEX_HPP
+#define LEVEL_INDEX_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GridSolver.hpp"
+
+enum class LevelSearchMode
+{
+    PREFIX, // names starting with the query
+    CONTAINS // names containing the query anywhere
+};
+
+enum class LevelSolvedFilter
+{
+    ANY,
+    SOLVED,
+    UNSOLVED
+};
+
+// What the level picker shows; the query is matched without case
+struct LevelFilter
+{
+    std::string query;
+    LevelSearchMode mode = LevelSearchMode::PREFIX;
+    int size = 0; // 0 for any size
+    int difficulty = -1; // a GridDifficulty, -1 for any
+    LevelSolvedFilter solved = LevelSolvedFilter::ANY;
+
+    bool UsesDetails() const { return size != 0 || difficulty >= 0 || solved != LevelSolvedFilter::ANY; }
+};
+
+// Every level file of the levels directory with what the picker filters them on: name, size, difficulty and whether
+// they have been solved. The names are listed right away, the rest is read and rated on a worker thread (a catalogue
+// of 100k levels takes seconds) and taken over by the main thread in batches.
+// Every member function is meant to be called from the main thread.
+class LevelIndex
+{
+public:
+    static constexpr uint8_t UNKNOWN_DIFFICULTY = 0xFF; // not rated yet, or too big or too hard to be rated
+
+    LevelIndex() = default;
+    ~LevelIndex();
+
+    LevelIndex(const LevelIndex&) = delete;
+    LevelIndex& operator =(const LevelIndex&) = delete;
+
+    // Lists the level files of the directory, or takes the given names (e.g. for the bench), and starts rating them
+    void Build(const std::string& directory);
+    void Build(std::vector<std::string> names, const std::string& directory);
+
+    // Takes the levels rated by the worker since the last call, returns true if there were any
+    bool Update();
+    bool IsRating() const { return m_numRated < m_names.size(); }
+
+    size_t GetNumLevels() const { return m_names.size(); }
+    size_t GetNumRated() const { return m_numRated; }
+    const std::vector<std::string>& GetNames() const { return m_names; } // sorted without case
+    int FindLevel(const std::string& name) const; // -1 if there is no such level
+
+    // Details of a level (size and difficulty are 0 and UNKNOWN_DIFFICULTY until it has been rated)
+    int GetSize(size_t level) const { return m_sizes[level]; }
+    uint8_t GetDifficulty(size_t level) const { return m_difficulties[level]; }
+    bool IsSolved(size_t level) const { return m_isSolved[level] != 0; }
+    void SetSolved(size_t level) { m_isSolved[level] = 1; m_version++; }
+
+    // Levels passing the filter, in name order. The result is kept: as long as neither the filter nor (when it uses them)
+    // the details change, this costs nothing, and a query typed on from the previous one only searches the previous matches.
+    const std::vector<uint32_t>& Search(const LevelFilter& filter);
+
+private:
+    // Rated by the worker, applied by Update()
+    struct LevelDetails
+    {
+        uint32_t level = 0;
+        uint8_t size = 0;
+        uint8_t difficulty = UNKNOWN_DIFFICULTY;
+        uint64_t gridHash = 0;
+    };
+
+    static constexpr size_t PUBLISH_BATCH_SIZE = 256;
+    // Levels the solver cannot rate within this many placements are left unknown, rather than holding up the others
+    static constexpr uint64_t RATING_MAX_NODES = 1000000;
+    static constexpr uint64_t RATING_PROGRESS_INTERVAL_NODES = 1024; // how often a rating checks for cancellation
+
+    std::string m_directory;
+
+    // One entry per level, as parallel arrays, sorted by m_searchNames
+    std::vector<std::string> m_names;
+    std::vector<std::string> m_searchNames; // lower case
+    std::vector<uint8_t> m_sizes;
+    std::vector<uint8_t> m_difficulties;
+    std::vector<uint8_t> m_isSolved;
+    size_t m_numRated = 0;
+    uint64_t m_version = 0; // incremented whenever details change
+
+    // Worker
+    std::thread m_thread;
+    std::atomic<bool> m_isCancelRequested{false};
+    std::mutex m_mutex;
+    std::vector<LevelDetails> m_publishedDetails; // guarded by m_mutex
+    std::vector<LevelDetails> m_takenDetails; // swapped with m_publishedDetails, so neither side allocates once warmed up
+
+    // Last search
+    LevelFilter m_lastFilter;
+    uint64_t m_lastVersion = 0;
+    bool m_hasSearched = false;
+    std::string m_query; // lower case
+    std::vector<uint32_t> m_matches;
+
+    void Stop();
+    void Run();
+    bool Matches(size_t level, const LevelFilter& filter, const std::string& query) const;
+};
+
+#endif // LEVEL_INDEX_HPP
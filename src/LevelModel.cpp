@@ -0,0 +1,58 @@
+#include "LevelModel.hpp"
+
+#include "Log.hpp"
+
+bool LevelModel::Init(const std::vector<std::vector<int>>& repr)
+{
+    Clear();
+
+    if (repr.empty() || repr[0].empty())
+    {
+        return false;
+    }
+
+    const int numRows = static_cast<int>(repr.size());
+    const int numColumns = static_cast<int>(repr[0].size());
+    m_regions.reserve(static_cast<size_t>(numRows) * numColumns);
+    for (int i = 0; i < numRows; i++)
+    {
+        if (static_cast<int>(repr[i].size()) != numColumns)
+        {
+            LOG_ERROR(LOAD) << "Row " << i + 1 << " has " << repr[i].size() << " tiles instead of " << numColumns;
+            Clear();
+            return false;
+        }
+
+        for (int j = 0; j < numColumns; j++)
+        {
+            const int region = repr[i][j];
+            if (region < 0 || region >= MAX_REGIONS)
+            {
+                LOG_ERROR(LOAD) << "Invalid region in row " << i + 1 << ", column " << j + 1;
+                Clear();
+                return false;
+            }
+
+            m_regions.emplace_back(static_cast<uint8_t>(region));
+        }
+    }
+
+    m_numRows = numRows;
+    m_numColumns = numColumns;
+    m_marks.assign(m_regions.size(), Mark::EMPTY);
+
+    return true;
+}
+
+void LevelModel::Clear()
+{
+    m_numRows = 0;
+    m_numColumns = 0;
+    m_regions.clear();
+    m_marks.clear();
+}
+
+void LevelModel::ClearMarks()
+{
+    m_marks.assign(m_marks.size(), Mark::EMPTY);
+}
@@ -0,0 +1,52 @@
+#ifndef LEVEL_MODEL_HPP
+#define LEVEL_MODEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class Mark : uint8_t
+{
+    EMPTY,
+    X,
+    QUEEN
+};
+
+using TileIndex = uint32_t; // row * numColumns + column
+
+// Game state of a level without anything visual (see LevelView): the region and the mark of every tile, row by row,
+// each in its own contiguous array of bytes. A whole row of marks is a cache line or two, whatever the size of the level.
+class LevelModel
+{
+public:
+    static const int MAX_REGIONS = 256; // region ids are stored as bytes
+
+    // Returns false, leaving the model empty, if the representation is not a rectangle of valid region ids
+    bool Init(const std::vector<std::vector<int>>& repr);
+    void Clear();
+    bool IsEmpty() const { return m_regions.empty(); }
+
+    int GetNumRows() const { return m_numRows; }
+    int GetNumColumns() const { return m_numColumns; }
+    size_t GetNumTiles() const { return m_regions.size(); }
+
+    TileIndex GetIndex(int row, int column) const { return static_cast<TileIndex>(row * m_numColumns + column); }
+    int GetRow(TileIndex index) const { return static_cast<int>(index) / m_numColumns; }
+    int GetColumn(TileIndex index) const { return static_cast<int>(index) % m_numColumns; }
+
+    int GetRegion(TileIndex index) const { return m_regions[index]; }
+    int GetRegion(int row, int column) const { return m_regions[GetIndex(row, column)]; }
+
+    Mark GetMark(TileIndex index) const { return m_marks[index]; }
+    Mark GetMark(int row, int column) const { return m_marks[GetIndex(row, column)]; }
+    void SetMark(TileIndex index, Mark mark) { m_marks[index] = mark; }
+    void ClearMarks();
+
+private:
+    int m_numRows = 0;
+    int m_numColumns = 0;
+    std::vector<uint8_t> m_regions; // [row * numColumns + column]
+    std::vector<Mark> m_marks; // [row * numColumns + column]
+};
+
+#endif // LEVEL_MODEL_HPP
@@ -0,0 +1,145 @@
+#include "LevelTopology.hpp"
+
+#include <algorithm> // std::max
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+// Fills CSR lists from the list of every tile, keeping the tiles of each list in order (a counting sort)
+template <typename GetList>
+void BuildLists(size_t numTiles, int numLists, GetList getList, std::vector<TileIndex>& tiles, std::vector<uint32_t>& starts)
+{
+    starts.assign(numLists + 1, 0);
+    for (TileIndex tile = 0; tile < numTiles; tile++)
+    {
+        starts[getList(tile) + 1]++;
+    }
+    for (int list = 0; list < numLists; list++)
+    {
+        starts[list + 1] += starts[list];
+    }
+
+    std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+    tiles.resize(numTiles);
+    for (TileIndex tile = 0; tile < numTiles; tile++)
+    {
+        tiles[next[getList(tile)]++] = tile;
+    }
+}
+
+int GetNumWords(int numBits)
+{
+    return (numBits + 63) / 64;
+}
+} // namespace
+
+void LevelTopology::Build(const LevelModel& model)
+{
+    Clear();
+
+    const int numRows = model.GetNumRows();
+    const int numColumns = model.GetNumColumns();
+    const size_t numTiles = model.GetNumTiles();
+    for (TileIndex tile = 0; tile < numTiles; tile++)
+    {
+        m_numRegions = std::max(m_numRegions, model.GetRegion(tile) + 1);
+    }
+
+    // Rows are already contiguous, but having them as lists too lets every line be read the same way
+    BuildLists(numTiles, numRows, [&](TileIndex tile) { return model.GetRow(tile); }, m_rowTiles, m_rowStarts);
+    BuildLists(numTiles, numColumns, [&](TileIndex tile) { return model.GetColumn(tile); }, m_columnTiles, m_columnStarts);
+    BuildLists(numTiles, m_numRegions, [&](TileIndex tile) { return model.GetRegion(tile); }, m_regionTiles, m_regionStarts);
+    m_maxListSize = std::max(numRows, numColumns);
+    for (int region = 0; region < m_numRegions; region++)
+    {
+        m_maxListSize = std::max(m_maxListSize, GetRegion(region).size());
+    }
+
+    m_regionWords = GetNumWords(m_numRegions);
+    m_rowRegions.assign(static_cast<size_t>(numRows) * m_regionWords, 0);
+    m_columnRegions.assign(static_cast<size_t>(numColumns) * m_regionWords, 0);
+    for (TileIndex tile = 0; tile < numTiles; tile++)
+    {
+        const int row = model.GetRow(tile);
+        const int column = model.GetColumn(tile);
+        const int region = model.GetRegion(tile);
+        SetBit(&m_rowRegions[row * m_regionWords], region);
+        SetBit(&m_columnRegions[column * m_regionWords], region);
+    }
+
+    // Neighbours: the bounds are checked once here, then each neighbour is a fixed index difference away
+    for (int i = 0; i < MAX_NEIGHBOURS; i++)
+    {
+        m_neighbourDeltas[i] = NEIGHBOURS_OFFSETS[i].row * numColumns + NEIGHBOURS_OFFSETS[i].column;
+    }
+    m_neighbourMasks.assign(numTiles, 0);
+    for (TileIndex tile = 0; tile < numTiles; tile++)
+    {
+        const int row = model.GetRow(tile);
+        const int column = model.GetColumn(tile);
+        for (int i = 0; i < MAX_NEIGHBOURS; i++)
+        {
+            const int neighbourRow = row + NEIGHBOURS_OFFSETS[i].row;
+            const int neighbourColumn = column + NEIGHBOURS_OFFSETS[i].column;
+            if (neighbourRow >= 0 && neighbourRow < numRows && neighbourColumn >= 0 && neighbourColumn < numColumns)
+            {
+                m_neighbourMasks[tile] |= static_cast<uint8_t>(1 << i);
+            }
+        }
+    }
+}
+
+void LevelTopology::Clear()
+{
+    m_numRegions = 0;
+    m_maxListSize = 0;
+    m_rowTiles.clear();
+    m_rowStarts.clear();
+    m_columnTiles.clear();
+    m_columnStarts.clear();
+    m_regionTiles.clear();
+    m_regionStarts.clear();
+    m_regionWords = 0;
+    m_rowRegions.clear();
+    m_columnRegions.clear();
+    m_neighbourMasks.clear();
+}
+
+int LevelTopology::GetNeighbours(TileIndex tile, TileIndex* neighbours) const
+{
+    int numNeighbours = 0;
+    const uint8_t mask = m_neighbourMasks[tile];
+    for (int i = 0; i < MAX_NEIGHBOURS; i++)
+    {
+        if ((mask >> i) & 1)
+        {
+            neighbours[numNeighbours++] = static_cast<TileIndex>(static_cast<int>(tile) + m_neighbourDeltas[i]);
+        }
+    }
+
+    return numNeighbours;
+}
+
+TileSpan LevelTopology::GetSpan(const std::vector<TileIndex>& tiles, const std::vector<uint32_t>& starts, int list)
+{
+    const TileIndex* first = tiles.data();
+    return TileSpan(first + starts[list], first + starts[list + 1]);
+}
+
+int LevelTopology::CountBits(const uint64_t* mask, int numWords)
+{
+    int numBits = 0;
+    for (int word = 0; word < numWords; word++)
+    {
+#ifdef _MSC_VER
+        numBits += static_cast<int>(__popcnt64(mask[word]));
+#else
+        numBits += __builtin_popcountll(mask[word]);
+#endif
+    }
+
+    return numBits;
+}
@@ -0,0 +1,87 @@
+#ifndef LEVEL_TOPOLOGY_HPP
+#define LEVEL_TOPOLOGY_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LevelModel.hpp"
+#include "RulePolicies.hpp"
+
+// Contiguous run of tile indices in one of the topology tables, e.g. the tiles of a region
+class TileSpan
+{
+public:
+    TileSpan() = default;
+    TileSpan(const TileIndex* first, const TileIndex* last) : m_first(first), m_last(last) {}
+
+    const TileIndex* begin() const { return m_first; }
+    const TileIndex* end() const { return m_last; }
+    size_t size() const { return static_cast<size_t>(m_last - m_first); }
+    bool empty() const { return m_first == m_last; }
+    TileIndex operator[](size_t i) const { return m_first[i]; }
+
+private:
+    const TileIndex* m_first = nullptr;
+    const TileIndex* m_last = nullptr;
+};
+
+// Geometry of a level which never changes once it is loaded, so the checks and the solver rules look it up instead of
+// working it out again on every call:
+// - the tiles of every row, column and region, as CSR-style lists (one array of tiles, and where each list starts)
+// - the regions each row and column crosses, as bitmasks
+// - the neighbours of every tile (under the rules of the game) as a bitmask of the exclusion offsets in bounds
+class LevelTopology
+{
+public:
+    // The tiles a queen excludes besides its row, column and region
+    static constexpr auto NEIGHBOURS_OFFSETS = GetExclusionOffsets<StandardRules>();
+    static const int MAX_NEIGHBOURS = static_cast<int>(NEIGHBOURS_OFFSETS.size());
+    static_assert(MAX_NEIGHBOURS <= 8, "neighbour masks are stored as bytes");
+
+    void Build(const LevelModel& model);
+    void Clear();
+
+    int GetNumRegions() const { return m_numRegions; } // the highest region id plus one, some regions may have no tiles
+    size_t GetMaxListSize() const { return m_maxListSize; } // tiles of the longest row, column or region, e.g. to size buffers
+
+    TileSpan GetRow(int row) const { return GetSpan(m_rowTiles, m_rowStarts, row); }
+    TileSpan GetColumn(int column) const { return GetSpan(m_columnTiles, m_columnStarts, column); }
+    TileSpan GetRegion(int region) const { return GetSpan(m_regionTiles, m_regionStarts, region); }
+
+    // Writes the neighbours of a tile (at most MAX_NEIGHBOURS) to `neighbours`, returns how many there are
+    int GetNeighbours(TileIndex tile, TileIndex* neighbours) const;
+
+    // Regions crossed by each row and column, one bit per region
+    int GetNumRegionsInRow(int row) const { return CountBits(&m_rowRegions[row * m_regionWords], m_regionWords); }
+    int GetNumRegionsInColumn(int column) const { return CountBits(&m_columnRegions[column * m_regionWords], m_regionWords); }
+    bool DoesColumnCrossRegion(int column, int region) const { return TestBit(&m_columnRegions[column * m_regionWords], region); }
+
+private:
+    int m_numRegions = 0;
+    size_t m_maxListSize = 0;
+
+    // CSR lists: the tiles of list i are tiles[starts[i]] to tiles[starts[i + 1]], row by row within each list
+    std::vector<TileIndex> m_rowTiles;
+    std::vector<uint32_t> m_rowStarts;
+    std::vector<TileIndex> m_columnTiles;
+    std::vector<uint32_t> m_columnStarts;
+    std::vector<TileIndex> m_regionTiles;
+    std::vector<uint32_t> m_regionStarts;
+
+    // Bitmasks of any number of regions, as 64-bit words one after the other: [row * m_regionWords + word]
+    int m_regionWords = 0;
+    std::vector<uint64_t> m_rowRegions;
+    std::vector<uint64_t> m_columnRegions;
+
+    std::vector<uint8_t> m_neighbourMasks; // [tile], bit i set if NEIGHBOURS_OFFSETS[i] is on the level
+    std::array<int, MAX_NEIGHBOURS> m_neighbourDeltas = {}; // TileIndex difference of each of NEIGHBOURS_OFFSETS
+
+    static TileSpan GetSpan(const std::vector<TileIndex>& tiles, const std::vector<uint32_t>& starts, int list);
+    static void SetBit(uint64_t* mask, int bit) { mask[bit / 64] |= uint64_t(1) << (bit % 64); }
+    static bool TestBit(const uint64_t* mask, int bit) { return (mask[bit / 64] >> (bit % 64)) & 1; }
+    static int CountBits(const uint64_t* mask, int numWords);
+};
+
+#endif // LEVEL_TOPOLOGY_HPP
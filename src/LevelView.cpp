@@ -0,0 +1,117 @@
+#include "LevelView.hpp"
+
+#include "SFML/Graphics/Rect.hpp"
+
+#include "GlobalSettings.hpp"
+#include "ResourceManager.hpp"
+
+namespace
+{
+void SetQuad(sf::Vertex* quad, const sf::FloatRect& rect, const sf::IntRect& textureRect, const sf::Color& color)
+{
+    const float textureLeft = static_cast<float>(textureRect.left);
+    const float textureTop = static_cast<float>(textureRect.top);
+    const float textureRight = static_cast<float>(textureRect.left + textureRect.width);
+    const float textureBottom = static_cast<float>(textureRect.top + textureRect.height);
+
+    quad[0] = sf::Vertex({rect.left, rect.top}, color, {textureLeft, textureTop});
+    quad[1] = sf::Vertex({rect.left + rect.width, rect.top}, color, {textureRight, textureTop});
+    quad[2] = sf::Vertex({rect.left + rect.width, rect.top + rect.height}, color, {textureRight, textureBottom});
+    quad[3] = sf::Vertex({rect.left, rect.top + rect.height}, color, {textureLeft, textureBottom});
+}
+} // namespace
+
+void LevelView::Init(size_t numTiles)
+{
+    m_flags.assign(numTiles, DIRTY);
+}
+
+void LevelView::Clear()
+{
+    m_flags.clear();
+}
+
+sf::Vector2f LevelView::GetTilePosition(int row, int column)
+{
+    // Tiles start one tile away from the top left corner of the window
+    return sf::Vector2f(static_cast<float>((column + 1) * GlobalSettings::TILE_SIZE), static_cast<float>((row + 1) * GlobalSettings::TILE_SIZE));
+}
+
+void LevelView::WriteStaticVertices(const sf::Vector2f& pos, const sf::Color& color, sf::Vertex* vertices)
+{
+    const sf::IntRect& fillRect = ResourceManager::getInstance().getAtlasRect(AtlasRegion::FILL);
+    const float tileSize = static_cast<float>(GlobalSettings::TILE_SIZE);
+    const float outlineThickness = 1.0f;
+
+    // Outline (a black quad slightly bigger than the tile, right below the fill)
+    const sf::FloatRect outlineRect(pos.x - outlineThickness, pos.y - outlineThickness, tileSize + 2 * outlineThickness, tileSize + 2 * outlineThickness);
+    SetQuad(&vertices[0], outlineRect, fillRect, sf::Color::Black);
+
+    // Fill
+    SetQuad(&vertices[4], {pos.x, pos.y, tileSize, tileSize}, fillRect, color);
+}
+
+void LevelView::WriteDynamicVertices(TileIndex index, const sf::Vector2f& pos, Mark mark, TileDetail detail, sf::Vertex* vertices)
+{
+    const ResourceManager& resourceManager = ResourceManager::getInstance();
+    const sf::IntRect& fillRect = resourceManager.getAtlasRect(AtlasRegion::FILL);
+    const float tileSize = static_cast<float>(GlobalSettings::TILE_SIZE);
+    const bool useGlyphs = detail == TileDetail::GLYPH;
+
+    // Tint (hover, conflict) over the fill of the static layer
+    SetQuad(&vertices[0], {pos.x, pos.y, tileSize, tileSize}, fillRect, GetTintColor(index));
+
+    // Mark (on top), collapsed into a zero-area quad when there is no mark.
+    // Glyphs are bigger than the icons, as they are only used when the tiles are small on screen.
+    if (mark == Mark::X)
+    {
+        const float size = useGlyphs ? tileSize / 3.0f : tileSize / 4.0f;
+        const float offset = (tileSize - size) / 2.0f;
+        const sf::IntRect& textureRect = useGlyphs ? fillRect : resourceManager.getAtlasRect(AtlasRegion::X);
+        SetQuad(&vertices[4], {pos.x + offset, pos.y + offset, size, size}, textureRect, useGlyphs ? GlobalSettings::X_GLYPH_COLOR : sf::Color::White);
+    }
+    else if (mark == Mark::QUEEN)
+    {
+        const float size = useGlyphs ? tileSize * 0.7f : tileSize / 2.0f;
+        const float offset = (tileSize - size) / 2.0f;
+        const sf::IntRect& textureRect = useGlyphs ? fillRect : resourceManager.getAtlasRect(AtlasRegion::QUEEN);
+        SetQuad(&vertices[4], {pos.x + offset, pos.y + offset, size, size}, textureRect, useGlyphs ? GlobalSettings::QUEEN_GLYPH_COLOR : sf::Color::White);
+    }
+    else
+    {
+        SetQuad(&vertices[4], {pos.x, pos.y, 0.0f, 0.0f}, fillRect, sf::Color::Transparent);
+    }
+
+    m_flags[index] &= ~DIRTY;
+}
+
+void LevelView::InvalidateAll()
+{
+    for (uint8_t& flags : m_flags)
+    {
+        flags |= DIRTY;
+    }
+}
+
+void LevelView::SetFlag(TileIndex index, uint8_t flag, bool value)
+{
+    const uint8_t flags = value ? (m_flags[index] | flag) : (m_flags[index] & ~flag);
+    if (flags != m_flags[index])
+    {
+        m_flags[index] = flags | DIRTY;
+    }
+}
+
+sf::Color LevelView::GetTintColor(TileIndex index) const
+{
+    if (IsInConflict(index))
+    {
+        return GlobalSettings::TILE_CONFLICT_TINT;
+    }
+    if ((m_flags[index] & HOVERED) != 0)
+    {
+        return GlobalSettings::TILE_HOVER_TINT;
+    }
+
+    return sf::Color::Transparent;
+}
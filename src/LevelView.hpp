@@ -0,0 +1,62 @@
+#ifndef LEVEL_VIEW_HPP
+#define LEVEL_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SFML/Graphics/Color.hpp"
+#include "SFML/Graphics/Vertex.hpp"
+#include "SFML/System/Vector2.hpp"
+
+#include "LevelModel.hpp"
+
+// How marks are drawn, depending on how big the tiles are on screen
+enum class TileDetail
+{
+    ICON, // the X and queen textures
+    GLYPH // plain squares, which stay readable when the tiles are only a few pixels wide
+};
+
+// Visual state of the tiles of a level, kept apart from the game state (see LevelModel): one byte of flags per tile,
+// for the hover and conflict tints and whether its vertices have to be written again. Positions follow from the
+// coordinates and colors from the regions, so nothing else is stored per tile.
+class LevelView
+{
+public:
+    // Number of vertices a tile takes in each of the level's layers
+    static const int STATIC_VERTICES_PER_TILE = 8; // outline and fill quads
+    static const int DYNAMIC_VERTICES_PER_TILE = 8; // tint and mark quads
+
+    void Init(size_t numTiles); // every tile starts dirty, neither hovered nor in conflict
+    void Clear();
+
+    // Top left corner of a tile, in level coordinates
+    static sf::Vector2f GetTilePosition(int row, int column);
+
+    static void WriteStaticVertices(const sf::Vector2f& pos, const sf::Color& color, sf::Vertex* vertices);
+    void WriteDynamicVertices(TileIndex index, const sf::Vector2f& pos, Mark mark, TileDetail detail, sf::Vertex* vertices);
+
+    bool IsDirty(TileIndex index) const { return (m_flags[index] & DIRTY) != 0; }
+    void Invalidate(TileIndex index) { m_flags[index] |= DIRTY; } // e.g. when its mark changes
+    void InvalidateAll(); // e.g. when the detail of the marks changes
+
+    void SetHovered(TileIndex index, bool isHovered) { SetFlag(index, HOVERED, isHovered); }
+    void SetInConflict(TileIndex index, bool isInConflict) { SetFlag(index, IN_CONFLICT, isInConflict); } // the tile holds a queen which breaks the rules
+    bool IsInConflict(TileIndex index) const { return (m_flags[index] & IN_CONFLICT) != 0; }
+
+private:
+    enum Flag : uint8_t
+    {
+        HOVERED = 1 << 0,
+        IN_CONFLICT = 1 << 1,
+        DIRTY = 1 << 2 // the mark or the tint have changed since the tile's dynamic vertices were last written
+    };
+
+    std::vector<uint8_t> m_flags; // [row * numColumns + column]
+
+    void SetFlag(TileIndex index, uint8_t flag, bool value);
+    sf::Color GetTintColor(TileIndex index) const;
+};
+
+#endif // LEVEL_VIEW_HPP
@@ -0,0 +1,275 @@
+#include "Log.hpp"
+
+#include <algorithm> // std::min
+#include <chrono>
+#include <cstdio>
+#include <cstring> // std::memcpy, std::strlen
+#include <string>
+#include <thread>
+
+Logger::Logger()
+{
+    for (size_t i = 0; i < QUEUE_CAPACITY; i++)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    m_writerThread = std::thread(&Logger::WriterLoop, this);
+}
+
+Logger::~Logger()
+{
+    // The writer drains the queue before exiting
+    m_running = false;
+    WakeWriter();
+    if (m_writerThread.joinable())
+    {
+        m_writerThread.join();
+    }
+}
+
+bool Logger::Enqueue(const LogEntry& entry)
+{
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = m_cells[pos & (QUEUE_CAPACITY - 1)];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (difference == 0)
+        {
+            // The cell is free, try to claim it
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.entry = entry;
+                // Sequentially consistent, as the flag of the writer: either it sees this entry before waiting, or we see it waiting
+                cell.sequence.store(pos + 1, std::memory_order_seq_cst);
+                if (m_isWriterWaiting.load(std::memory_order_seq_cst))
+                {
+                    WakeWriter();
+                }
+
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The queue is full: we never block the caller, the message is dropped instead
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+
+            return false;
+        }
+        else
+        {
+            // Another producer claimed the cell in the meantime
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Logger::Dequeue(LogEntry& entry)
+{
+    // Only the writer thread dequeues
+    const size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Cell& cell = m_cells[pos & (QUEUE_CAPACITY - 1)];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    if (sequence != pos + 1)
+    {
+        return false;
+    }
+
+    entry = cell.entry;
+    cell.sequence.store(pos + QUEUE_CAPACITY, std::memory_order_release);
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool Logger::IsEmpty() const
+{
+    const size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    return m_cells[pos & (QUEUE_CAPACITY - 1)].sequence.load(std::memory_order_seq_cst) != pos + 1;
+}
+
+void Logger::WakeWriter()
+{
+    // Under the mutex, so the writer cannot be between checking the queue and starting to wait
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wakeCondition.notify_one();
+}
+
+void Logger::Flush()
+{
+    const size_t enqueued = m_enqueuePos.load(std::memory_order_acquire);
+    while (m_writtenCount.load(std::memory_order_acquire) < enqueued && m_writerThread.joinable())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::WriterLoop()
+{
+    LogEntry entry;
+    for (;;)
+    {
+        bool wroteAny = false;
+        while (Dequeue(entry))
+        {
+            Write(entry);
+            m_writtenCount.fetch_add(1, std::memory_order_release);
+            wroteAny = true;
+        }
+
+        if (wroteAny)
+        {
+            std::fflush(stdout);
+        }
+        else if (!m_running)
+        {
+            break;
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_isWriterWaiting.store(true, std::memory_order_seq_cst);
+            m_wakeCondition.wait(lock, [this] { return !IsEmpty() || !m_running; });
+            m_isWriterWaiting.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::Write(const LogEntry& entry)
+{
+    // Warnings and errors go to stderr, like they did when they were written with std::cerr
+    FILE* stream = entry.severity >= LogSeverity::WARNING ? stderr : stdout;
+    std::fprintf(stream, "[%7u ms] [%s] [%s] %.*s\n", entry.timestampMs, GetSeverityName(entry.severity), GetCategoryName(entry.category), static_cast<int>(entry.length), entry.text);
+}
+
+uint32_t Logger::GetElapsedMs() const
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+}
+
+const char* Logger::GetSeverityName(LogSeverity severity)
+{
+    switch (severity)
+    {
+    case LogSeverity::DEBUG:
+        return "DEBUG";
+    case LogSeverity::INFO:
+        return "INFO";
+    case LogSeverity::WARNING:
+        return "WARNING";
+    case LogSeverity::ERROR:
+    default:
+        return "ERROR";
+    }
+}
+
+const char* Logger::GetCategoryName(LogCategory category)
+{
+    switch (category)
+    {
+    case LogCategory::CHECK:
+        return "check";
+    case LogCategory::SOLVE:
+        return "solve";
+    case LogCategory::LOAD:
+        return "load";
+    case LogCategory::RENDER:
+        return "render";
+    case LogCategory::GENERAL:
+    default:
+        return "general";
+    }
+}
+
+// -------
+
+LogMessage::LogMessage(LogSeverity severity, LogCategory category)
+{
+    m_entry.severity = severity;
+    m_entry.category = category;
+    m_entry.timestampMs = Logger::getInstance().GetElapsedMs();
+}
+
+LogMessage::~LogMessage()
+{
+    Logger::getInstance().Enqueue(m_entry);
+}
+
+void LogMessage::Append(const char* text, size_t length)
+{
+    // Messages longer than the entry are truncated
+    const size_t available = LogEntry::MAX_TEXT_LENGTH - m_entry.length;
+    const size_t copied = std::min(length, available);
+    std::memcpy(m_entry.text + m_entry.length, text, copied);
+    m_entry.length += static_cast<uint32_t>(copied);
+}
+
+LogMessage& LogMessage::operator<<(const char* text)
+{
+    Append(text, std::strlen(text));
+    return *this;
+}
+
+LogMessage& LogMessage::operator<<(const std::string& text)
+{
+    Append(text.data(), text.size());
+    return *this;
+}
+
+LogMessage& LogMessage::operator<<(char character)
+{
+    Append(&character, 1);
+    return *this;
+}
+
+LogMessage& LogMessage::operator<<(bool value)
+{
+    return *this << (value ? "true" : "false");
+}
+
+LogMessage& LogMessage::operator<<(int value)
+{
+    return *this << static_cast<long long>(value);
+}
+
+LogMessage& LogMessage::operator<<(unsigned int value)
+{
+    return *this << static_cast<unsigned long long>(value);
+}
+
+LogMessage& LogMessage::operator<<(long value)
+{
+    return *this << static_cast<long long>(value);
+}
+
+LogMessage& LogMessage::operator<<(unsigned long value)
+{
+    return *this << static_cast<unsigned long long>(value);
+}
+
+LogMessage& LogMessage::operator<<(long long value)
+{
+    char buffer[24];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%lld", value);
+    Append(buffer, static_cast<size_t>(length));
+    return *this;
+}
+
+LogMessage& LogMessage::operator<<(unsigned long long value)
+{
+    char buffer[24];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%llu", value);
+    Append(buffer, static_cast<size_t>(length));
+    return *this;
+}
+
+LogMessage& LogMessage::operator<<(double value)
+{
+    char buffer[32];
+    const int length = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    Append(buffer, static_cast<size_t>(length));
+    return *this;
+}
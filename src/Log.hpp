@@ -0,0 +1,157 @@
+#ifndef LOG_HPP
+#define LOG_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Minimum severity compiled in (0 = debug, 1 = info, 2 = warning, 3 = error, 4 = none), set by CMake
+#ifndef QUEENS_LOG_LEVEL
+#define QUEENS_LOG_LEVEL 1
+#endif
+
+enum class LogSeverity
+{
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR
+};
+
+enum class LogCategory
+{
+    GENERAL,
+    CHECK,
+    SOLVE,
+    LOAD,
+    RENDER
+};
+
+// Messages below the compile-time threshold are discarded statements, so they cost nothing at run time,
+// and messages below the run-time threshold are not even formatted:
+// LOG_DEBUG(SOLVE) << "Crossing out tiles in row " << row;
+#define QUEENS_LOG(severity, category)                                                \
+    if constexpr (static_cast<int>(LogSeverity::severity) < QUEENS_LOG_LEVEL)      \
+    {                                                                                 \
+    }                                                                                 \
+    else if (!Logger::getInstance().IsEnabled(LogSeverity::severity))                \
+    {                                                                                 \
+    }                                                                                 \
+    else                                                                              \
+        LogMessage(LogSeverity::severity, LogCategory::category)
+
+#define LOG_DEBUG(category) QUEENS_LOG(DEBUG, category)
+#define LOG_INFO(category) QUEENS_LOG(INFO, category)
+#define LOG_WARNING(category) QUEENS_LOG(WARNING, category)
+#define LOG_ERROR(category) QUEENS_LOG(ERROR, category)
+
+struct LogEntry
+{
+    static const size_t MAX_TEXT_LENGTH = 232;
+
+    LogSeverity severity = LogSeverity::INFO;
+    LogCategory category = LogCategory::GENERAL;
+    uint32_t timestampMs = 0;
+    uint32_t length = 0;
+    char text[MAX_TEXT_LENGTH];
+};
+
+// Receives log entries from any thread through a bounded lock-free queue, and writes them from a background thread,
+// so logging never waits on console I/O. The writer sleeps while there is nothing to write, and is only woken up by
+// the entry which finds it asleep.
+class Logger
+{
+public:
+    // Static member function to get the instance
+    static Logger& getInstance()
+    {
+        static Logger instance; // Guaranteed to be initialized only once
+        return instance;
+    }
+
+    // Returns false (and drops the entry) if the queue is full
+    bool Enqueue(const LogEntry& entry);
+    // Blocks until every entry enqueued so far has been written
+    void Flush();
+
+    // Run-time threshold on top of the compile-time one, e.g. to keep tools quiet
+    void SetMinSeverity(LogSeverity severity) { m_minSeverity.store(severity, std::memory_order_relaxed); }
+    bool IsEnabled(LogSeverity severity) const { return severity >= m_minSeverity.load(std::memory_order_relaxed); }
+
+    uint32_t GetElapsedMs() const;
+    size_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+    static const char* GetSeverityName(LogSeverity severity);
+    static const char* GetCategoryName(LogCategory category);
+
+    Logger(const Logger&) = delete; // Delete copy constructor
+    Logger& operator =(const Logger&) = delete; // Delete copy assignment operator
+
+private:
+    Logger(); // Private constructor to prevent instantation
+    ~Logger();
+
+    static const size_t QUEUE_CAPACITY = 1024; // must be a power of 2
+
+    // Bounded multi-producer queue (D. Vyukov): each cell's sequence tells whether it is ready to be written or read
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        LogEntry entry;
+    };
+    std::array<Cell, QUEUE_CAPACITY> m_cells;
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<size_t> m_dequeuePos{0};
+    std::atomic<size_t> m_writtenCount{0};
+    std::atomic<size_t> m_droppedCount{0};
+
+    std::atomic<LogSeverity> m_minSeverity{LogSeverity::DEBUG};
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_isWriterWaiting{false};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::thread m_writerThread;
+    const std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now();
+
+    bool Dequeue(LogEntry& entry);
+    bool IsEmpty() const;
+    void WakeWriter();
+    void WriterLoop();
+    void Write(const LogEntry& entry);
+};
+
+// Formats a message into a fixed-size buffer (no allocations) and hands it over to the logger when destroyed
+class LogMessage
+{
+public:
+    LogMessage(LogSeverity severity, LogCategory category);
+    ~LogMessage();
+
+    LogMessage(const LogMessage&) = delete;
+    LogMessage& operator =(const LogMessage&) = delete;
+
+    LogMessage& operator<<(const char* text);
+    LogMessage& operator<<(const std::string& text);
+    LogMessage& operator<<(char character);
+    LogMessage& operator<<(bool value);
+    LogMessage& operator<<(int value);
+    LogMessage& operator<<(unsigned int value);
+    LogMessage& operator<<(long value);
+    LogMessage& operator<<(unsigned long value);
+    LogMessage& operator<<(long long value);
+    LogMessage& operator<<(unsigned long long value);
+    LogMessage& operator<<(double value);
+
+private:
+    LogEntry m_entry;
+
+    void Append(const char* text, size_t length);
+};
+
+#endif // LOG_HPP
@@ -0,0 +1,111 @@
+#include "Profiler.hpp"
+
+#include <algorithm> // std::nth_element
+#include <cmath>
+
+#include "AllocationTracker.hpp"
+
+void Profiler::BeginFrame()
+{
+    m_currentSample = FrameSample();
+    m_frameStartAllocations = AllocationTracker::GetAllocationCount();
+    m_frameClock.restart();
+}
+
+void Profiler::EndFrame()
+{
+    m_currentSample.frameMs = m_frameClock.getElapsedTime().asMicroseconds() / 1000.0f;
+    m_currentSample.allocations = AllocationTracker::GetAllocationCount() - m_frameStartAllocations;
+
+    m_samples[m_nextSample] = m_currentSample;
+    m_nextSample = (m_nextSample + 1) % HISTORY_SIZE;
+    m_numSamples = std::min(m_numSamples + 1, HISTORY_SIZE);
+}
+
+void Profiler::AddPhaseTime(ProfilerPhase phase, float ms)
+{
+    m_currentSample.phaseMs[static_cast<size_t>(phase)] += ms;
+}
+
+void Profiler::AddDrawCalls(int drawCalls)
+{
+    m_currentSample.drawCalls += drawCalls;
+}
+
+const FrameSample& Profiler::GetSample(size_t age) const
+{
+    return m_samples[(m_nextSample + HISTORY_SIZE - 1 - age) % HISTORY_SIZE];
+}
+
+FrameSample Profiler::GetAverage() const
+{
+    FrameSample average;
+    if (m_numSamples == 0)
+    {
+        return average;
+    }
+
+    float drawCalls = 0.0f;
+    float allocations = 0.0f;
+    for (size_t age = 0; age < m_numSamples; age++)
+    {
+        const FrameSample& sample = GetSample(age);
+        for (size_t phase = 0; phase < sample.phaseMs.size(); phase++)
+        {
+            average.phaseMs[phase] += sample.phaseMs[phase] / m_numSamples;
+        }
+        average.frameMs += sample.frameMs / m_numSamples;
+        drawCalls += static_cast<float>(sample.drawCalls) / m_numSamples;
+        allocations += static_cast<float>(sample.allocations) / m_numSamples;
+    }
+    average.drawCalls = static_cast<int>(std::round(drawCalls));
+    average.allocations = static_cast<size_t>(std::round(allocations));
+
+    return average;
+}
+
+float Profiler::GetFrameTimePercentile(float percentile)
+{
+    if (m_numSamples == 0)
+    {
+        return 0.0f;
+    }
+
+    m_sortedFrameTimes = GetFrameTimes();
+
+    const size_t rank = std::min(m_numSamples - 1, static_cast<size_t>(percentile / 100.0f * m_numSamples));
+    std::nth_element(m_sortedFrameTimes.begin(), m_sortedFrameTimes.begin() + rank, m_sortedFrameTimes.end());
+
+    return m_sortedFrameTimes[rank];
+}
+
+const std::vector<float>& Profiler::GetFrameTimes()
+{
+    m_frameTimes.resize(m_numSamples);
+    for (size_t age = 0; age < m_numSamples; age++)
+    {
+        m_frameTimes[m_numSamples - 1 - age] = GetSample(age).frameMs;
+    }
+
+    return m_frameTimes;
+}
+
+const char* Profiler::GetPhaseName(ProfilerPhase phase)
+{
+    switch (phase)
+    {
+    case ProfilerPhase::MOUSE_HOVER:
+        return "Mouse hover";
+    case ProfilerPhase::EVENTS:
+        return "Events";
+    case ProfilerPhase::UI:
+        return "UI";
+    case ProfilerPhase::LEVEL_UPDATE:
+        return "Level update";
+    case ProfilerPhase::RENDER:
+        return "Render";
+    case ProfilerPhase::COUNT:
+    default:
+        return "";
+    }
+}
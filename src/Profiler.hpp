@@ -0,0 +1,100 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "SFML/System/Clock.hpp"
+
+enum class ProfilerPhase
+{
+    MOUSE_HOVER,
+    EVENTS,
+    UI,
+    LEVEL_UPDATE,
+    RENDER,
+    COUNT
+};
+
+struct FrameSample
+{
+    std::array<float, static_cast<size_t>(ProfilerPhase::COUNT)> phaseMs = {};
+    float frameMs = 0.0f;
+    int drawCalls = 0;
+    size_t allocations = 0;
+};
+
+// Keeps the timings of the last rendered frames, split by phase of the game loop
+class Profiler
+{
+public:
+    // Static member function to get the instance
+    static Profiler& getInstance()
+    {
+        static Profiler instance; // Guaranteed to be initialized only once
+        return instance;
+    }
+
+    static const size_t HISTORY_SIZE = 600;
+
+    void BeginFrame();
+    void EndFrame();
+
+    void AddPhaseTime(ProfilerPhase phase, float ms);
+    void AddDrawCalls(int drawCalls);
+
+    // Cold start, from main() to the first frame shown (0 until then)
+    void SetStartupMs(float ms) { m_startupMs = ms; }
+    float GetStartupMs() const { return m_startupMs; }
+
+    size_t GetNumSamples() const { return m_numSamples; }
+    const FrameSample& GetSample(size_t age) const; // age 0 is the last completed frame
+    FrameSample GetAverage() const;
+
+    // Frame time percentile (between 0 and 100) over the whole history
+    float GetFrameTimePercentile(float percentile);
+    // Frame times ordered from oldest to newest, e.g. for plotting
+    const std::vector<float>& GetFrameTimes();
+
+    static const char* GetPhaseName(ProfilerPhase phase);
+
+    Profiler(const Profiler&) = delete; // Delete copy constructor
+    Profiler& operator =(const Profiler&) = delete; // Delete copy assignment operator
+
+private:
+    Profiler() = default; // Private constructor to prevent instantation
+    ~Profiler() = default; // Default destructor
+
+    // Ring buffer of the last frames
+    std::array<FrameSample, HISTORY_SIZE> m_samples;
+    size_t m_nextSample = 0;
+    size_t m_numSamples = 0;
+
+    FrameSample m_currentSample;
+    sf::Clock m_frameClock;
+    size_t m_frameStartAllocations = 0;
+
+    float m_startupMs = 0.0f;
+
+    // Scratch buffers, so querying the history does not allocate every frame
+    std::vector<float> m_frameTimes;
+    std::vector<float> m_sortedFrameTimes;
+};
+
+// Adds the time spent in its scope to a phase of the current frame
+class ScopedPhaseTimer
+{
+public:
+    explicit ScopedPhaseTimer(ProfilerPhase phase) : m_phase(phase) {}
+    ~ScopedPhaseTimer() { Profiler::getInstance().AddPhaseTime(m_phase, m_clock.getElapsedTime().asMicroseconds() / 1000.0f); }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator =(const ScopedPhaseTimer&) = delete;
+
+private:
+    ProfilerPhase m_phase;
+    sf::Clock m_clock;
+};
+
+#endif // PROFILER_HPP
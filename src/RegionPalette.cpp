@@ -0,0 +1,65 @@
+#include "RegionPalette.hpp"
+
+#include <cmath> // std::fmod, std::fabs
+
+namespace
+{
+struct NamedColor
+{
+    const char* name;
+    RegionColor color;
+};
+
+// clang-format off
+
+// https://loading.io/color/feature/Set3-10/
+const NamedColor NAMED_COLORS[RegionPalette::NUM_NAMED_COLORS] = {
+    {"Turquoise",    {141, 211, 199}},
+    {"Light yellow", {255, 255, 179}},
+    {"Lavender",     {190, 186, 218}},
+    {"Salmon",       {251, 128, 114}},
+    {"Sky blue",     {128, 177, 211}},
+    {"Light orange", {253, 180, 98}},
+    {"Light green",  {179, 222, 105}},
+    {"Light pink",   {252, 205, 229}},
+    {"Light grey",   {217, 217, 217}},
+    {"Purple",       {188, 128, 189}}
+};
+
+// clang-format on
+} // namespace
+
+namespace RegionPalette
+{
+RegionColor GetColor(int region)
+{
+    if (region < NUM_NAMED_COLORS)
+    {
+        return NAMED_COLORS[region].color;
+    }
+
+    // Bigger (e.g. generated) levels: spread pastel hues using the golden angle, so consecutive regions stay distinguishable
+    const float hue = std::fmod(region * 137.508f, 360.0f) / 60.0f;
+    const float x = 1.0f - std::fabs(std::fmod(hue, 2.0f) - 1.0f);
+    const float sectors[6][3] = {{1.0f, x, 0.0f}, {x, 1.0f, 0.0f}, {0.0f, 1.0f, x}, {0.0f, x, 1.0f}, {x, 0.0f, 1.0f}, {1.0f, 0.0f, x}};
+    const float* rgb = sectors[static_cast<int>(hue) % 6];
+
+    const auto toPastel = [](float channel) { return static_cast<uint8_t>(120 + channel * 125); };
+    RegionColor color;
+    color.r = toPastel(rgb[0]);
+    color.g = toPastel(rgb[1]);
+    color.b = toPastel(rgb[2]);
+
+    return color;
+}
+
+std::string GetName(int region)
+{
+    if (region < NUM_NAMED_COLORS)
+    {
+        return NAMED_COLORS[region].name;
+    }
+
+    return "Region " + std::to_string(region + 1);
+}
+} // namespace RegionPalette
@@ -0,0 +1,24 @@
+#ifndef REGION_PALETTE_HPP
+#define REGION_PALETTE_HPP
+
+#include <cstdint>
+#include <string>
+
+struct RegionColor
+{
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+};
+
+// Colors of the regions, without SFML so the headless tools (e.g. the thumbnails of queens-cli) match the game
+namespace RegionPalette
+{
+const int NUM_NAMED_COLORS = 10;
+
+// Regions beyond the named colors get a generated one
+RegionColor GetColor(int region);
+std::string GetName(int region);
+} // namespace RegionPalette
+
+#endif // REGION_PALETTE_HPP
@@ -1,13 +1,30 @@
 #ifndef RESOURCE_MANAGER_HPP
 #define RESOURCE_MANAGER_HPP
 
-#include <iostream>
-#include <string>
+#include <algorithm> // std::max
+#include <cstddef>
 
+#include "SFML/Graphics/Image.hpp"
+#include "SFML/Graphics/Rect.hpp"
 #include "SFML/Graphics/Texture.hpp"
 
-#include "GlobalSettings.hpp"
+#include "SFML/System/Clock.hpp"
 
+#include "EmbeddedTextures.hpp"
+#include "Log.hpp"
+
+// Regions of the texture atlas
+enum class AtlasRegion
+{
+    FILL, // plain white block, tinted through the vertex colors for tile fills and outlines
+    X,
+    QUEEN
+};
+
+// The icons are compiled into the game (see EmbeddedTextures.hpp), so nothing is read from disk and the game starts
+// from any working directory. Nothing is done at start-up either: the atlas is decoded the first time a tile asks
+// for one of its regions, and uploaded to the GPU the first time it is drawn, i.e. while building the first frame.
+// Only used from the main thread.
 class ResourceManager
 {
 public:
@@ -18,35 +35,24 @@ public:
         return instance;
     }
 
-    void Load()
+    // By using const sf::Texture&, we ensure that you we referencing the original texture managed by the ResourceManager rather than creating a copy
+    const sf::Texture& getAtlasTexture() const
     {
-        std::cout << "Loading resources..." << std::endl;
-
-        // Load textures
-        const std::string texturesPath = std::string(GlobalSettings::TEXTURES_PATH);
-
-        const std::string xTexturePath = texturesPath + "x_icon.png";
-        if (m_xTexture.loadFromFile(xTexturePath))
+        if (!m_isAtlasTextureUploaded)
         {
-            std::cout << "Texture: " << xTexturePath << " loaded correctly" << std::endl;
+            UploadAtlas();
         }
-        const std::string queenTexturePath = texturesPath + "queen_icon.png";
-        if (m_queenTexture.loadFromFile(queenTexturePath))
-        {
-            std::cout << "Texture: " << queenTexturePath << " loaded correctly" << std::endl;
-        }
-        const std::string transparentTexturePath = texturesPath + "transparent_icon.png";
-        if (m_transparentTexture.loadFromFile(transparentTexturePath))
+        return m_atlasTexture;
+    }
+    const sf::IntRect& getAtlasRect(AtlasRegion region) const
+    {
+        if (!m_isAtlasDecoded)
         {
-            std::cout << "Texture: " << transparentTexturePath << " loaded correctly" << std::endl;
+            DecodeAtlas();
         }
+        return m_atlasRects[static_cast<int>(region)];
     }
 
-    // By using const sf::Texture&, we ensure that you we referencing the original texture managed by the ResourceManager rather than creating a copy
-    const sf::Texture& getXTexture() const { return m_xTexture; }
-    const sf::Texture& getQueenTexture() const { return m_queenTexture; }
-    const sf::Texture& getTransparentTexture() const { return m_transparentTexture; }
-
     ResourceManager(const ResourceManager&) = delete; // Delete copy constructor
     ResourceManager& operator =(const ResourceManager&) = delete; // Delete copy assignment operator
 
@@ -54,10 +60,79 @@ private:
     ResourceManager() = default; // Private constructor to prevent instantation
     ~ResourceManager() = default; // Default destructor
 
-    // Textures
-    sf::Texture m_xTexture;
-    sf::Texture m_queenTexture;
-    sf::Texture m_transparentTexture;
+    // All the board graphics live in a single texture so the whole board can be drawn in one draw call.
+    // Mutable as it is built on first use, from the const getters.
+    mutable sf::Image m_atlasImage;
+    mutable sf::Texture m_atlasTexture;
+    mutable sf::IntRect m_atlasRects[3];
+    mutable bool m_isAtlasDecoded = false;
+    mutable bool m_isAtlasTextureUploaded = false;
+
+    static bool DecodeImage(sf::Image& image, const char* name, const unsigned char* data, size_t size)
+    {
+        if (!image.loadFromMemory(data, size))
+        {
+            LOG_ERROR(LOAD) << "Texture: " << name << " could not be decoded";
+            return false;
+        }
+        return true;
+    }
+
+    void DecodeAtlas() const
+    {
+        m_isAtlasDecoded = true;
+        sf::Clock clock;
+
+        sf::Image xImage;
+        sf::Image queenImage;
+        DecodeImage(xImage, "x_icon.png", EmbeddedTextures::X_ICON_PNG, EmbeddedTextures::X_ICON_PNG_SIZE);
+        DecodeImage(queenImage, "queen_icon.png", EmbeddedTextures::QUEEN_ICON_PNG, EmbeddedTextures::QUEEN_ICON_PNG_SIZE);
+        BuildAtlas(xImage, queenImage);
+
+        LOG_INFO(LOAD) << "Texture atlas decoded in " << clock.getElapsedTime().asMicroseconds() << " us";
+    }
+
+    void UploadAtlas() const
+    {
+        if (!m_isAtlasDecoded)
+        {
+            DecodeAtlas();
+        }
+        m_isAtlasTextureUploaded = true;
+
+        m_atlasTexture.loadFromImage(m_atlasImage);
+        m_atlasImage = sf::Image(); // only the GPU copy is needed from now on
+    }
+
+    // Packed here rather than at build time: the build step only embeds files as they are (CMake cannot decode PNGs),
+    // and packing two 64x64 icons takes microseconds
+    void BuildAtlas(const sf::Image& xImage, const sf::Image& queenImage) const
+    {
+        // Regions are laid out horizontally: [fill][x][queen]
+        const sf::Vector2u xSize = xImage.getSize();
+        const sf::Vector2u queenSize = queenImage.getSize();
+        const unsigned int fillSize = 4;
+
+        const unsigned int atlasWidth = fillSize + xSize.x + queenSize.x;
+        const unsigned int atlasHeight = std::max(fillSize, std::max(xSize.y, queenSize.y));
+
+        sf::Image& atlas = m_atlasImage;
+        atlas.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+        for (unsigned int x = 0; x < fillSize; x++)
+        {
+            for (unsigned int y = 0; y < fillSize; y++)
+            {
+                atlas.setPixel(x, y, sf::Color::White);
+            }
+        }
+        atlas.copy(xImage, fillSize, 0);
+        atlas.copy(queenImage, fillSize + xSize.x, 0);
+
+        // The fill region is sampled at its center only, so neighbouring regions never bleed into it
+        m_atlasRects[static_cast<int>(AtlasRegion::FILL)] = sf::IntRect(fillSize / 2, fillSize / 2, 0, 0);
+        m_atlasRects[static_cast<int>(AtlasRegion::X)] = sf::IntRect(fillSize, 0, xSize.x, xSize.y);
+        m_atlasRects[static_cast<int>(AtlasRegion::QUEEN)] = sf::IntRect(fillSize + xSize.x, 0, queenSize.x, queenSize.y);
+    }
 };
 
 #endif // RESOURCE_MANAGER_HPP
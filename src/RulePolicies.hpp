@@ -0,0 +1,134 @@
+#ifndef RULE_POLICIES_HPP
+#define RULE_POLICIES_HPP
+
+#include <array>
+#include <cstddef>
+
+// The rules of the game, and of its variants, as compile-time policies the checker and solver are instantiated with,
+// so each variant gets its own inlined search loop instead of branching on the rules at every node.
+// A policy provides:
+// - NAME: how tools and benchmarks refer to it
+// - QUEENS_PER_LINE: how many queens every row, column and region holds
+// - EXCLUSION_RADIUS: how many rows and columns away a queen can exclude a tile
+// - IS_TOROIDAL: whether the board wraps around its edges, for exclusions too
+// - IsExcluded(rowOffset, columnOffset): whether a queen excludes the tile at that offset, besides its row, column and region
+
+struct RuleOffset
+{
+    int row = 0;
+    int column = 0;
+};
+
+constexpr int GetChebyshevDistance(int rowOffset, int columnOffset)
+{
+    const int rowDistance = rowOffset < 0 ? -rowOffset : rowOffset;
+    const int columnDistance = columnOffset < 0 ? -columnOffset : columnOffset;
+
+    return rowDistance > columnDistance ? rowDistance : columnDistance;
+}
+
+constexpr bool IsKnightMove(int rowOffset, int columnOffset)
+{
+    return rowOffset * rowOffset + columnOffset * columnOffset == 5;
+}
+
+// One queen per row, column and region, and queens never touch, not even diagonally
+struct StandardRules
+{
+    static constexpr const char* NAME = "standard";
+    static constexpr int QUEENS_PER_LINE = 1;
+    static constexpr int EXCLUSION_RADIUS = 1;
+    static constexpr bool IS_TOROIDAL = false;
+
+    static constexpr bool IsExcluded(int rowOffset, int columnOffset) { return GetChebyshevDistance(rowOffset, columnOffset) <= 1; }
+};
+
+// Queens keep at least two tiles between each other
+struct RadiusTwoRules
+{
+    static constexpr const char* NAME = "radius-2";
+    static constexpr int QUEENS_PER_LINE = 1;
+    static constexpr int EXCLUSION_RADIUS = 2;
+    static constexpr bool IS_TOROIDAL = false;
+
+    static constexpr bool IsExcluded(int rowOffset, int columnOffset) { return GetChebyshevDistance(rowOffset, columnOffset) <= 2; }
+};
+
+// Queens can neither touch nor be a knight's move apart
+struct KnightRules
+{
+    static constexpr const char* NAME = "knight";
+    static constexpr int QUEENS_PER_LINE = 1;
+    static constexpr int EXCLUSION_RADIUS = 2;
+    static constexpr bool IS_TOROIDAL = false;
+
+    static constexpr bool IsExcluded(int rowOffset, int columnOffset)
+    {
+        return GetChebyshevDistance(rowOffset, columnOffset) <= 1 || IsKnightMove(rowOffset, columnOffset);
+    }
+};
+
+// Two queens per row, column and region, which still never touch
+struct TwoQueensRules
+{
+    static constexpr const char* NAME = "two-queens";
+    static constexpr int QUEENS_PER_LINE = 2;
+    static constexpr int EXCLUSION_RADIUS = 1;
+    static constexpr bool IS_TOROIDAL = false;
+
+    static constexpr bool IsExcluded(int rowOffset, int columnOffset) { return GetChebyshevDistance(rowOffset, columnOffset) <= 1; }
+};
+
+// Standard rules on a board whose opposite edges touch
+struct ToroidalRules
+{
+    static constexpr const char* NAME = "toroidal";
+    static constexpr int QUEENS_PER_LINE = 1;
+    static constexpr int EXCLUSION_RADIUS = 1;
+    static constexpr bool IS_TOROIDAL = true;
+
+    static constexpr bool IsExcluded(int rowOffset, int columnOffset) { return GetChebyshevDistance(rowOffset, columnOffset) <= 1; }
+};
+
+template <typename Rules>
+constexpr int GetNumExclusionOffsets()
+{
+    int numOffsets = 0;
+    for (int row = -Rules::EXCLUSION_RADIUS; row <= Rules::EXCLUSION_RADIUS; row++)
+    {
+        for (int column = -Rules::EXCLUSION_RADIUS; column <= Rules::EXCLUSION_RADIUS; column++)
+        {
+            if ((row != 0 || column != 0) && Rules::IsExcluded(row, column))
+            {
+                numOffsets++;
+            }
+        }
+    }
+
+    return numOffsets;
+}
+
+// Every offset a queen excludes, in reading order, the queen's own tile aside
+template <typename Rules>
+constexpr std::array<RuleOffset, GetNumExclusionOffsets<Rules>()> GetExclusionOffsets()
+{
+    std::array<RuleOffset, GetNumExclusionOffsets<Rules>()> offsets = {};
+
+    size_t index = 0;
+    for (int row = -Rules::EXCLUSION_RADIUS; row <= Rules::EXCLUSION_RADIUS; row++)
+    {
+        for (int column = -Rules::EXCLUSION_RADIUS; column <= Rules::EXCLUSION_RADIUS; column++)
+        {
+            if ((row != 0 || column != 0) && Rules::IsExcluded(row, column))
+            {
+                offsets[index].row = row;
+                offsets[index].column = column;
+                index++;
+            }
+        }
+    }
+
+    return offsets;
+}
+
+#endif // RULE_POLICIES_HPP
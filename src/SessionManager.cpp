@@ -0,0 +1,86 @@
+#include "SessionManager.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+SessionManager::SessionManager() = default;
+
+SessionManager::~SessionManager()
+{
+    DestroyAllSessions();
+}
+
+int SessionManager::AddLevel(const GridBoard& level)
+{
+    m_levels.emplace_back(level);
+
+    return static_cast<int>(m_levels.size()) - 1;
+}
+
+SessionId SessionManager::CreateSession(int levelId)
+{
+    if (levelId < 0 || levelId >= static_cast<int>(m_levels.size()))
+    {
+        return INVALID_SESSION;
+    }
+
+    SessionId id = static_cast<SessionId>(m_sessions.size());
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        m_sessions.emplace_back(nullptr);
+    }
+
+    void* memory = m_countingResource.allocate(sizeof(GameSession), alignof(GameSession));
+    m_sessions[id] = new (memory) GameSession(m_levels[levelId], &m_countingResource);
+    m_numSessions++;
+
+    return id;
+}
+
+void SessionManager::DestroySession(SessionId id)
+{
+    GameSession* session = GetSession(id);
+    if (!session)
+    {
+        return;
+    }
+
+    // Releases the session's arena (back to the pool) before the session itself
+    session->~GameSession();
+    m_countingResource.deallocate(session, sizeof(GameSession), alignof(GameSession));
+
+    m_sessions[id] = nullptr;
+    m_freeIds.emplace_back(id);
+    m_numSessions--;
+}
+
+void SessionManager::DestroyAllSessions()
+{
+    for (SessionId id = 0; id < m_sessions.size(); id++)
+    {
+        DestroySession(id);
+    }
+
+    m_sessions.clear();
+    m_freeIds.clear();
+}
+
+void* SessionManager::CountingResource::do_allocate(size_t bytes, size_t alignment)
+{
+    void* pointer = m_upstream->allocate(bytes, alignment);
+    m_allocatedBytes += bytes;
+
+    return pointer;
+}
+
+void SessionManager::CountingResource::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    m_upstream->deallocate(pointer, bytes, alignment);
+    m_allocatedBytes -= bytes;
+}
@@ -0,0 +1,72 @@
+#ifndef SESSION_MANAGER_HPP
+#define SESSION_MANAGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory_resource>
+#include <vector>
+
+#include "GameSession.hpp"
+#include "GridSolver.hpp"
+
+using SessionId = uint32_t;
+
+// Holds the game sessions of many players, e.g. for a game server. Levels are stored once and shared by their sessions,
+// and the sessions (with their arenas' overflow) are allocated from a pool, which also tells how much memory they use.
+// Not thread-safe: use one manager per thread, each serving its own players.
+class SessionManager
+{
+public:
+    static const SessionId INVALID_SESSION = UINT32_MAX;
+
+    SessionManager();
+    ~SessionManager();
+
+    SessionManager(const SessionManager&) = delete;
+    SessionManager& operator =(const SessionManager&) = delete;
+
+    // Returns the id of the level, to create sessions on it
+    int AddLevel(const GridBoard& level);
+    size_t GetNumLevels() const { return m_levels.size(); }
+
+    // Returns INVALID_SESSION if the level does not exist. Ids of destroyed sessions are reused.
+    SessionId CreateSession(int levelId);
+    void DestroySession(SessionId id);
+    void DestroyAllSessions();
+
+    // nullptr if there is no such session
+    GameSession* GetSession(SessionId id) const { return id < m_sessions.size() ? m_sessions[id] : nullptr; }
+    size_t GetNumSessions() const { return m_numSessions; }
+
+    // Bytes currently allocated for the sessions: the sessions themselves and whatever their histories needed on top
+    size_t GetMemoryUsage() const { return m_countingResource.GetAllocatedBytes(); }
+
+private:
+    // Forwards to another resource, keeping track of the bytes in use
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit CountingResource(std::pmr::memory_resource* upstream) : m_upstream(upstream) {}
+
+        size_t GetAllocatedBytes() const { return m_allocatedBytes; }
+
+    private:
+        std::pmr::memory_resource* m_upstream;
+        size_t m_allocatedBytes = 0;
+
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::pmr::unsynchronized_pool_resource m_pool;
+    CountingResource m_countingResource{&m_pool};
+
+    std::deque<GridBoard> m_levels; // a deque, so sessions can keep references to the levels when more are added
+    std::vector<GameSession*> m_sessions; // [id], nullptr for free ids
+    std::vector<SessionId> m_freeIds;
+    size_t m_numSessions = 0;
+};
+
+#endif // SESSION_MANAGER_HPP
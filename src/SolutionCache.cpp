@@ -0,0 +1,389 @@
+#include "SolutionCache.hpp"
+
+#include <cstring> // std::memcpy
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Log.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#undef ERROR // clashes with LogSeverity::ERROR
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// File layout:
+// - header: magic (4 bytes)
+// - records: grid hash (8 bytes) | number of rows (2 bytes) | queen column for each row (2 bytes each)
+const char CACHE_MAGIC[4] = {'Q', 'S', 'C', '1'};
+const size_t RECORD_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint16_t);
+} // namespace
+
+bool SolutionCache::Open(const std::string& filePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    CloseFile();
+
+    // Create the cache file with just its header if it does not exist yet
+    {
+        std::ifstream existingFile(filePath, std::ios::binary);
+        if (!existingFile.is_open())
+        {
+            std::ofstream newFile(filePath, std::ios::binary);
+            newFile.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        }
+    }
+
+    if (!MapFile(filePath))
+    {
+        LOG_ERROR(LOAD) << "Solution cache: " << filePath << " could not be mapped";
+        return false;
+    }
+
+    if (m_mappedSize < sizeof(CACHE_MAGIC) || std::memcmp(m_mappedData, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+    {
+        LOG_ERROR(LOAD) << "Solution cache: " << filePath << " is not a valid cache file";
+        UnmapFile();
+        return false;
+    }
+
+    const size_t recordsEnd = IndexMappedRecords();
+    if (recordsEnd < m_mappedSize)
+    {
+        // The last record was cut short (e.g. the program was killed while writing it): records appended after it
+        // would be read at the wrong offsets from then on, so it is dropped from the file. The records indexed above keep
+        // their offsets.
+        LOG_WARNING(LOAD) << "Solution cache: dropped a truncated record at the end of " << filePath;
+        UnmapFile();
+
+        std::error_code error;
+        std::filesystem::resize_file(filePath, recordsEnd, error);
+        if (error || !MapFile(filePath))
+        {
+            LOG_ERROR(LOAD) << "Solution cache: " << filePath << " could not be repaired";
+            m_mappedIndex.clear();
+            return false;
+        }
+    }
+
+    m_appendStream.open(filePath, std::ios::binary | std::ios::app);
+
+    m_stats.entries = m_mappedIndex.size();
+
+    return true;
+}
+
+void SolutionCache::Close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    CloseFile();
+}
+
+SolutionCacheStats SolutionCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_stats;
+}
+
+void SolutionCache::CloseFile()
+{
+    if (m_appendStream.is_open())
+    {
+        m_appendStream.close();
+    }
+
+    UnmapFile();
+
+    m_mappedIndex.clear();
+    m_pendingRecords.clear();
+    m_stats = SolutionCacheStats();
+}
+
+bool SolutionCache::Lookup(uint64_t gridHash, size_t numRows, size_t numColumns, QueenLayout& layout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (FindRecord(gridHash, numRows, numColumns, layout))
+    {
+        m_stats.hits++;
+
+        return true;
+    }
+
+    m_stats.misses++;
+
+    return false;
+}
+
+bool SolutionCache::Peek(uint64_t gridHash, size_t numRows, size_t numColumns, QueenLayout& layout) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return FindRecord(gridHash, numRows, numColumns, layout);
+}
+
+bool SolutionCache::Contains(uint64_t gridHash) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_pendingRecords.count(gridHash) > 0 || m_mappedIndex.count(gridHash) > 0;
+}
+
+void SolutionCache::Store(uint64_t gridHash, const QueenLayout& layout)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Solutions never change for a given grid, so there is nothing to do if we already know it
+    if (layout.empty() || m_pendingRecords.count(gridHash) > 0 || m_mappedIndex.count(gridHash) > 0)
+    {
+        return;
+    }
+
+    m_pendingRecords[gridHash] = layout;
+
+    if (m_appendStream.is_open())
+    {
+        const uint16_t numRows = static_cast<uint16_t>(layout.size());
+        m_appendStream.write(reinterpret_cast<const char*>(&gridHash), sizeof(gridHash));
+        m_appendStream.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+        m_appendStream.write(reinterpret_cast<const char*>(layout.data()), layout.size() * sizeof(uint16_t));
+        m_appendStream.flush();
+    }
+
+    m_stats.stores++;
+    m_stats.entries++;
+}
+
+uint64_t SolutionCache::HashGrid(const std::vector<std::vector<int>>& repr)
+{
+    // 64-bit FNV-1a over the dimensions and the color id of every tile
+    const uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+    const uint64_t fnvPrime = 1099511628211ULL;
+
+    uint64_t hash = fnvOffsetBasis;
+    const auto hashValue = [&](uint64_t value) {
+        for (size_t i = 0; i < sizeof(value); i++)
+        {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= fnvPrime;
+        }
+    };
+
+    hashValue(repr.size());
+    for (const std::vector<int>& row : repr)
+    {
+        hashValue(row.size());
+        for (const int colorId : row)
+        {
+            hash ^= static_cast<unsigned char>(colorId);
+            hash *= fnvPrime;
+        }
+    }
+
+    return hash;
+}
+
+bool SolutionCache::FindRecord(uint64_t gridHash, size_t numRows, size_t numColumns, QueenLayout& layout) const
+{
+    // The columns are used as tile indices, so a record for another grid must never get through
+    const auto pendingIt = m_pendingRecords.find(gridHash);
+    if (pendingIt != m_pendingRecords.end())
+    {
+        if (pendingIt->second.size() != numRows)
+        {
+            return false;
+        }
+        layout = pendingIt->second;
+    }
+    else
+    {
+        const auto mappedIt = m_mappedIndex.find(gridHash);
+        if (mappedIt == m_mappedIndex.end())
+        {
+            return false;
+        }
+
+        const unsigned char* record = m_mappedData + mappedIt->second;
+
+        uint16_t recordRows = 0;
+        std::memcpy(&recordRows, record + sizeof(uint64_t), sizeof(recordRows));
+        if (recordRows != numRows)
+        {
+            return false;
+        }
+        layout.resize(recordRows);
+        std::memcpy(layout.data(), record + RECORD_HEADER_SIZE, recordRows * sizeof(uint16_t));
+    }
+
+    for (const uint16_t column : layout)
+    {
+        if (column >= numColumns)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t SolutionCache::IndexMappedRecords()
+{
+    m_mappedIndex.clear();
+
+    size_t numInvalidRecords = 0;
+    size_t offset = sizeof(CACHE_MAGIC);
+    while (offset + RECORD_HEADER_SIZE <= m_mappedSize)
+    {
+        uint64_t gridHash = 0;
+        uint16_t numRows = 0;
+        std::memcpy(&gridHash, m_mappedData + offset, sizeof(gridHash));
+        std::memcpy(&numRows, m_mappedData + offset + sizeof(gridHash), sizeof(numRows));
+
+        const size_t recordSize = RECORD_HEADER_SIZE + numRows * sizeof(uint16_t);
+        if (offset + recordSize > m_mappedSize)
+        {
+            // Truncated record, see Open()
+            break;
+        }
+
+        // A queen in every column of a square level, so no column can be past the number of rows (e.g. a corrupt file)
+        bool isValid = numRows > 0;
+        for (size_t i = 0; i < numRows && isValid; i++)
+        {
+            uint16_t column = 0;
+            std::memcpy(&column, m_mappedData + offset + RECORD_HEADER_SIZE + i * sizeof(column), sizeof(column));
+            isValid = column < numRows;
+        }
+
+        if (isValid)
+        {
+            m_mappedIndex[gridHash] = offset;
+        }
+        else
+        {
+            numInvalidRecords++;
+        }
+        offset += recordSize;
+    }
+
+    if (numInvalidRecords > 0)
+    {
+        LOG_WARNING(LOAD) << "Solution cache: ignored " << numInvalidRecords << " invalid record(s)";
+    }
+
+    return offset;
+}
+
+#ifdef _WIN32
+
+bool SolutionCache::MapFile(const std::string& filePath)
+{
+    m_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (m_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        m_fileHandle = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(m_fileHandle, &fileSize);
+    m_mappedSize = static_cast<size_t>(fileSize.QuadPart);
+
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mappingHandle == nullptr)
+    {
+        UnmapFile();
+        return false;
+    }
+
+    m_mappedData = static_cast<const unsigned char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (m_mappedData == nullptr)
+    {
+        UnmapFile();
+        return false;
+    }
+
+    return true;
+}
+
+void SolutionCache::UnmapFile()
+{
+    if (m_mappedData)
+    {
+        UnmapViewOfFile(m_mappedData);
+    }
+    if (m_mappingHandle)
+    {
+        CloseHandle(m_mappingHandle);
+    }
+    if (m_fileHandle)
+    {
+        CloseHandle(m_fileHandle);
+    }
+
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+}
+
+#else
+
+bool SolutionCache::MapFile(const std::string& filePath)
+{
+    m_fileDescriptor = open(filePath.c_str(), O_RDONLY);
+    if (m_fileDescriptor < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(m_fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        UnmapFile();
+        return false;
+    }
+    m_mappedSize = static_cast<size_t>(fileStat.st_size);
+
+    void* mappedData = mmap(nullptr, m_mappedSize, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+    if (mappedData == MAP_FAILED)
+    {
+        UnmapFile();
+        return false;
+    }
+    m_mappedData = static_cast<const unsigned char*>(mappedData);
+
+    return true;
+}
+
+void SolutionCache::UnmapFile()
+{
+    if (m_mappedData)
+    {
+        munmap(const_cast<unsigned char*>(m_mappedData), m_mappedSize);
+    }
+    if (m_fileDescriptor >= 0)
+    {
+        close(m_fileDescriptor);
+    }
+
+    m_mappedData = nullptr;
+    m_mappedSize = 0;
+    m_fileDescriptor = -1;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SOLUTION_CACHE_HPP
+#define SOLUTION_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Queen layout of a solved level: for each row, the column where its queen is placed
+using QueenLayout = std::vector<uint16_t>;
+
+struct SolutionCacheStats
+{
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t stores = 0;
+    size_t entries = 0;
+
+    float HitRate() const { return (hits + misses) > 0 ? static_cast<float>(hits) / (hits + misses) : 0.0f; }
+};
+
+// On-disk cache of solved levels, keyed by a hash of the level grid (i.e. the regions, not the marks).
+// The cache file is an append-only log of records which is memory-mapped when opened, so a lookup only
+// costs a hash map probe plus a read of the mapped record. Levels solved on different threads share it, behind a mutex.
+class SolutionCache
+{
+public:
+    // Static member function to get the instance
+    static SolutionCache& getInstance()
+    {
+        static SolutionCache instance; // Guaranteed to be initialized only once
+        return instance;
+    }
+
+    bool Open(const std::string& filePath);
+    void Close();
+
+    // Records which do not fit the level (e.g. from a corrupt file or a hash collision) are treated as misses
+    bool Lookup(uint64_t gridHash, size_t numRows, size_t numColumns, QueenLayout& layout);
+    bool Peek(uint64_t gridHash, size_t numRows, size_t numColumns, QueenLayout& layout) const; // same, without counting as a lookup
+    void Store(uint64_t gridHash, const QueenLayout& layout);
+    bool Contains(uint64_t gridHash) const; // whether the level has been solved, without counting as a lookup
+
+    SolutionCacheStats GetStats() const;
+
+    static uint64_t HashGrid(const std::vector<std::vector<int>>& repr);
+
+    SolutionCache(const SolutionCache&) = delete; // Delete copy constructor
+    SolutionCache& operator =(const SolutionCache&) = delete; // Delete copy assignment operator
+
+private:
+    SolutionCache() = default; // Private constructor to prevent instantation
+    ~SolutionCache() { Close(); }
+
+    // Memory-mapped view of the cache file as it was when opened
+    const unsigned char* m_mappedData = nullptr;
+    size_t m_mappedSize = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fileDescriptor = -1;
+#endif
+
+    // Offset of each record within the mapped file, by grid hash
+    std::unordered_map<uint64_t, size_t> m_mappedIndex;
+    // Records stored since the file was mapped (they are appended to the file as well)
+    std::unordered_map<uint64_t, QueenLayout> m_pendingRecords;
+
+    std::ofstream m_appendStream;
+
+    SolutionCacheStats m_stats;
+
+    mutable std::mutex m_mutex;
+
+    void CloseFile();
+    bool MapFile(const std::string& filePath);
+    void UnmapFile();
+    size_t IndexMappedRecords(); // returns the end of the last complete record
+    bool FindRecord(uint64_t gridHash, size_t numRows, size_t numColumns, QueenLayout& layout) const;
+};
+
+#endif // SOLUTION_CACHE_HPP
@@ -0,0 +1,395 @@
+#include "ThumbnailRenderer.hpp"
+
+#include <algorithm> // std::fill, std::copy, std::max
+#include <array>
+#include <cstring> // std::memcmp
+
+namespace
+{
+const RegionColor GRID_LINE_RGB = {90, 90, 90};
+const RegionColor BORDER_RGB = {0, 0, 0};
+const RegionColor QUEEN_RGB = {40, 40, 40};
+
+const float QUEEN_RADIUS = 0.3f; // relative to the tile
+
+// Fills the pixels [first, last) of a row
+void FillSpan(uint8_t* row, int first, int last, uint8_t color)
+{
+    if (first < last)
+    {
+        std::fill(row + first, row + last, color);
+    }
+}
+
+void DrawQueen(Thumbnail& thumbnail, int left, int top, int right, int bottom)
+{
+    // Disc centered on the inside of the tile (without its lines), tested at the center of each pixel
+    const float centerX = (left + right) / 2.0f;
+    const float centerY = (top + bottom) / 2.0f;
+    const float radius = std::max(0.5f, (right - left) * QUEEN_RADIUS);
+    for (int y = top; y < bottom; y++)
+    {
+        uint8_t* row = &thumbnail.pixels[static_cast<size_t>(y) * thumbnail.width];
+        const float dy = y + 0.5f - centerY;
+        for (int x = left; x < right; x++)
+        {
+            const float dx = x + 0.5f - centerX;
+            if (dx * dx + dy * dy <= radius * radius)
+            {
+                row[x] = ThumbnailRenderer::QUEEN_COLOR;
+            }
+        }
+    }
+}
+
+// CRC of the PNG chunks
+uint32_t UpdateCrc(uint32_t crc, const uint8_t* data, size_t size)
+{
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> crcs = {};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; bit++)
+            {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            crcs[i] = value;
+        }
+        return crcs;
+    }();
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+void AppendUint32(std::vector<uint8_t>& output, uint32_t value)
+{
+    output.push_back(static_cast<uint8_t>(value >> 24));
+    output.push_back(static_cast<uint8_t>(value >> 16));
+    output.push_back(static_cast<uint8_t>(value >> 8));
+    output.push_back(static_cast<uint8_t>(value));
+}
+
+void BeginChunk(std::vector<uint8_t>& png, const char* type)
+{
+    AppendUint32(png, 0); // length, written by EndChunk
+    png.insert(png.end(), type, type + 4);
+}
+
+void EndChunk(std::vector<uint8_t>& png, size_t chunkStart)
+{
+    const uint32_t length = static_cast<uint32_t>(png.size() - chunkStart - 8);
+    for (int i = 0; i < 4; i++)
+    {
+        png[chunkStart + i] = static_cast<uint8_t>(length >> (24 - 8 * i));
+    }
+
+    const size_t typeStart = chunkStart + 4;
+    AppendUint32(png, UpdateCrc(0xFFFFFFFFu, &png[typeStart], png.size() - typeStart) ^ 0xFFFFFFFFu);
+}
+
+// zlib stream of a single deflate block with the fixed Huffman codes, where the only matches are runs of the previous
+// byte (distance 1): enough for thumbnails, which are mostly runs, without the tables of a general compressor
+class RunDeflater
+{
+public:
+    explicit RunDeflater(std::vector<uint8_t>& output) : m_output(output)
+    {
+        m_output.push_back(0x78); // deflate, 32K window
+        m_output.push_back(0x01); // no dictionary, fastest compression (the header is a multiple of 31)
+        WriteBits(1, 1); // last block
+        WriteBits(1, 2); // fixed Huffman codes
+    }
+
+    void Push(uint8_t byte)
+    {
+        UpdateAdler(byte);
+
+        if (m_hasPrevious && byte == m_previous)
+        {
+            m_runLength++;
+            if (m_runLength == MAX_MATCH_LENGTH)
+            {
+                FlushRun();
+            }
+            return;
+        }
+
+        FlushRun();
+        WriteSymbol(byte);
+        m_previous = byte;
+        m_hasPrevious = true;
+    }
+
+    void Finish()
+    {
+        FlushRun();
+        WriteSymbol(END_OF_BLOCK);
+        if (m_bitCount > 0)
+        {
+            m_output.push_back(static_cast<uint8_t>(m_bitBuffer));
+        }
+
+        AppendUint32(m_output, (m_adlerB % ADLER_MODULO) << 16 | (m_adlerA % ADLER_MODULO));
+    }
+
+private:
+    static const int MIN_MATCH_LENGTH = 3;
+    static const int MAX_MATCH_LENGTH = 258;
+    static const int END_OF_BLOCK = 256;
+    static const uint32_t ADLER_MODULO = 65521;
+    static const int ADLER_MAX_BYTES = 5552; // bytes which can be summed before the modulo overflows 32 bits
+
+    std::vector<uint8_t>& m_output;
+    uint32_t m_bitBuffer = 0;
+    int m_bitCount = 0;
+
+    bool m_hasPrevious = false;
+    uint8_t m_previous = 0;
+    int m_runLength = 0; // repeats of m_previous not written yet
+
+    uint32_t m_adlerA = 1;
+    uint32_t m_adlerB = 0;
+    int m_adlerBytes = 0;
+
+    void UpdateAdler(uint8_t byte)
+    {
+        m_adlerA += byte;
+        m_adlerB += m_adlerA;
+        if (++m_adlerBytes == ADLER_MAX_BYTES)
+        {
+            m_adlerA %= ADLER_MODULO;
+            m_adlerB %= ADLER_MODULO;
+            m_adlerBytes = 0;
+        }
+    }
+
+    void WriteBits(uint32_t value, int count)
+    {
+        m_bitBuffer |= value << m_bitCount;
+        m_bitCount += count;
+        while (m_bitCount >= 8)
+        {
+            m_output.push_back(static_cast<uint8_t>(m_bitBuffer));
+            m_bitBuffer >>= 8;
+            m_bitCount -= 8;
+        }
+    }
+
+    // Huffman codes are sent from their most significant bit, unlike every other field
+    void WriteCode(uint32_t code, int length)
+    {
+        uint32_t reversed = 0;
+        for (int i = 0; i < length; i++)
+        {
+            reversed |= ((code >> i) & 1) << (length - 1 - i);
+        }
+        WriteBits(reversed, length);
+    }
+
+    // Literal/length symbol, with the fixed code lengths of the deflate format
+    void WriteSymbol(int symbol)
+    {
+        if (symbol < 144)
+        {
+            WriteCode(0x30 + symbol, 8);
+        }
+        else if (symbol < 256)
+        {
+            WriteCode(0x190 + symbol - 144, 9);
+        }
+        else if (symbol < 280)
+        {
+            WriteCode(symbol - 256, 7);
+        }
+        else
+        {
+            WriteCode(0xC0 + symbol - 280, 8);
+        }
+    }
+
+    void WriteMatch(int length)
+    {
+        static const int LENGTH_BASES[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static const int LENGTH_EXTRA_BITS[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static const int NUM_LENGTH_CODES = static_cast<int>(sizeof(LENGTH_BASES) / sizeof(LENGTH_BASES[0]));
+
+        int code = NUM_LENGTH_CODES - 1;
+        while (LENGTH_BASES[code] > length)
+        {
+            code--;
+        }
+        WriteSymbol(257 + code);
+        WriteBits(static_cast<uint32_t>(length - LENGTH_BASES[code]), LENGTH_EXTRA_BITS[code]);
+        WriteCode(0, 5); // distance code 0: distance 1
+    }
+
+    void FlushRun()
+    {
+        if (m_runLength >= MIN_MATCH_LENGTH)
+        {
+            WriteMatch(m_runLength);
+        }
+        else
+        {
+            for (int i = 0; i < m_runLength; i++)
+            {
+                WriteSymbol(m_previous);
+            }
+        }
+        m_runLength = 0;
+    }
+};
+} // namespace
+
+namespace ThumbnailRenderer
+{
+RegionColor GetPaletteColor(int index)
+{
+    switch (index)
+    {
+    case GRID_LINE_COLOR:
+        return GRID_LINE_RGB;
+    case BORDER_COLOR:
+        return BORDER_RGB;
+    case QUEEN_COLOR:
+        return QUEEN_RGB;
+    default:
+        return RegionPalette::GetColor(index);
+    }
+}
+
+void Render(const GridBoard& board, const ThumbnailOptions& options, Thumbnail& thumbnail)
+{
+    const int size = board.size;
+    const int border = std::max(1, options.borderThickness);
+    const int tileSize = std::max(options.tileSize, border + 1);
+
+    // Every tile starts with its top and left lines, the board ends with its right and bottom borders
+    thumbnail.width = size * tileSize + border;
+    thumbnail.height = thumbnail.width;
+    thumbnail.pixels.resize(static_cast<size_t>(thumbnail.width) * thumbnail.height);
+    const size_t width = static_cast<size_t>(thumbnail.width);
+
+    for (int row = 0; row < size; row++)
+    {
+        const int top = row * tileSize;
+        uint8_t* firstRow = &thumbnail.pixels[top * width];
+
+        // All the pixel rows of a tile row start as its fills and vertical lines...
+        for (int column = 0; column < size; column++)
+        {
+            const int left = column * tileSize;
+            const bool isBorder = column == 0 || board.regions[row][column] != board.regions[row][column - 1];
+            const int lineWidth = isBorder ? border : 1;
+            FillSpan(firstRow, left, left + lineWidth, isBorder ? BORDER_COLOR : GRID_LINE_COLOR);
+            FillSpan(firstRow, left + lineWidth, left + tileSize, board.regions[row][column]);
+        }
+        FillSpan(firstRow, size * tileSize, thumbnail.width, BORDER_COLOR);
+        for (int y = 1; y < tileSize; y++)
+        {
+            std::copy(firstRow, firstRow + width, firstRow + y * width);
+        }
+
+        // ...then the horizontal lines go over them, the thin ones stopping at the vertical borders
+        for (int column = 0; column < size; column++)
+        {
+            const int left = column * tileSize;
+            if (row == 0 || board.regions[row][column] != board.regions[row - 1][column])
+            {
+                for (int y = 0; y < border; y++)
+                {
+                    FillSpan(firstRow + y * width, left, left + tileSize, BORDER_COLOR);
+                }
+            }
+            else
+            {
+                const bool isLeftBorder = column == 0 || board.regions[row][column] != board.regions[row][column - 1];
+                FillSpan(firstRow, left + (isLeftBorder ? border : 1), left + tileSize, GRID_LINE_COLOR);
+            }
+        }
+    }
+    for (int y = size * tileSize; y < thumbnail.height; y++)
+    {
+        FillSpan(&thumbnail.pixels[y * width], 0, thumbnail.width, BORDER_COLOR);
+    }
+
+    if (!options.drawQueens)
+    {
+        return;
+    }
+    for (int row = 0; row < size; row++)
+    {
+        const int column = board.queens[row];
+        if (column >= 0 && column < size)
+        {
+            // Inside of the tile, as if all its lines were borders, so every queen is centered the same way
+            DrawQueen(thumbnail, column * tileSize + border, row * tileSize + border, (column + 1) * tileSize, (row + 1) * tileSize);
+        }
+    }
+}
+
+void EncodePng(const Thumbnail& thumbnail, std::vector<uint8_t>& png)
+{
+    static const uint8_t SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const size_t width = static_cast<size_t>(thumbnail.width);
+
+    png.assign(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+
+    size_t chunkStart = png.size();
+    BeginChunk(png, "IHDR");
+    AppendUint32(png, static_cast<uint32_t>(thumbnail.width));
+    AppendUint32(png, static_cast<uint32_t>(thumbnail.height));
+    const uint8_t header[] = {8, 3, 0, 0, 0}; // 8 bits per pixel, indexed colors, deflate, standard filters, not interlaced
+    png.insert(png.end(), header, header + sizeof(header));
+    EndChunk(png, chunkStart);
+
+    chunkStart = png.size();
+    BeginChunk(png, "PLTE");
+    for (int i = 0; i < PALETTE_SIZE; i++)
+    {
+        const RegionColor color = GetPaletteColor(i);
+        png.push_back(color.r);
+        png.push_back(color.g);
+        png.push_back(color.b);
+    }
+    EndChunk(png, chunkStart);
+
+    chunkStart = png.size();
+    BeginChunk(png, "IDAT");
+    RunDeflater deflater(png);
+    for (int y = 0; y < thumbnail.height; y++)
+    {
+        const uint8_t* row = &thumbnail.pixels[y * width];
+        const bool isSameAsPrevious = y > 0 && std::memcmp(row, row - width, width) == 0;
+        if (isSameAsPrevious)
+        {
+            // "Up" filter: every byte is the difference with the byte above
+            deflater.Push(2);
+            for (size_t x = 0; x < width; x++)
+            {
+                deflater.Push(0);
+            }
+        }
+        else
+        {
+            deflater.Push(0);
+            for (size_t x = 0; x < width; x++)
+            {
+                deflater.Push(row[x]);
+            }
+        }
+    }
+    deflater.Finish();
+    EndChunk(png, chunkStart);
+
+    chunkStart = png.size();
+    BeginChunk(png, "IEND");
+    EndChunk(png, chunkStart);
+}
+} // namespace ThumbnailRenderer
@@ -0,0 +1,45 @@
+#ifndef THUMBNAIL_RENDERER_HPP
+#define THUMBNAIL_RENDERER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "GridSolver.hpp"
+#include "RegionPalette.hpp"
+
+// Picture of a board as palette indices (see ThumbnailRenderer::GetPaletteColor), one byte per pixel, row by row
+struct Thumbnail
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels; // [y * width + x]
+};
+
+struct ThumbnailOptions
+{
+    int tileSize = 12; // pixels from one tile to the next, lines included
+    int borderThickness = 2; // lines between regions and around the board, those inside a region are 1 pixel
+    bool drawQueens = true; // the queens of the board, if it has any
+};
+
+// Software rasterizer for previews of the levels, e.g. for the level picker or a website: it needs no GPU nor window,
+// so it runs on headless machines and on any number of threads at once (it has no shared state)
+namespace ThumbnailRenderer
+{
+// Palette entries: the regions first (region id = index), then the lines and the queens
+const int GRID_LINE_COLOR = GridBoard::MAX_SIZE;
+const int BORDER_COLOR = GridBoard::MAX_SIZE + 1;
+const int QUEEN_COLOR = GridBoard::MAX_SIZE + 2;
+const int PALETTE_SIZE = GridBoard::MAX_SIZE + 3;
+
+RegionColor GetPaletteColor(int index);
+
+// Reuses the pixels of `thumbnail`, so rendering many boards of the same size does not allocate
+void Render(const GridBoard& board, const ThumbnailOptions& options, Thumbnail& thumbnail);
+
+// Replaces the content of `png` with a PNG file of the thumbnail (8-bit indexed). The pixel data is deflated as runs of
+// the same byte, with rows equal to the previous one sent as zeros (PNG "up" filter), which suits flat pictures.
+void EncodePng(const Thumbnail& thumbnail, std::vector<uint8_t>& png);
+} // namespace ThumbnailRenderer
+
+#endif // THUMBNAIL_RENDERER_HPP
@@ -0,0 +1,136 @@
+#include "Trace.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+void Tracer::Record(TraceEvent event, uint64_t startNs, uint64_t durationNs, bool success)
+{
+    AtomicCounters& counters = m_counters[static_cast<size_t>(event)];
+    counters.invocations.fetch_add(1, std::memory_order_relaxed);
+    counters.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+    if (success)
+    {
+        counters.successes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Small, stable id per thread for the trace viewer
+    static std::atomic<uint32_t> nextThreadId{1};
+    thread_local const uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_spansMutex);
+    if (m_spans.size() < MAX_RECORDED_SPANS)
+    {
+        m_spans.push_back({event, threadId, startNs, durationNs, success});
+    }
+}
+
+void Tracer::Reset()
+{
+    for (AtomicCounters& counters : m_counters)
+    {
+        counters.invocations = 0;
+        counters.successes = 0;
+        counters.totalNs = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_spansMutex);
+    m_spans.clear();
+}
+
+TraceCounters Tracer::GetCounters(TraceEvent event) const
+{
+    const AtomicCounters& counters = m_counters[static_cast<size_t>(event)];
+
+    TraceCounters result;
+    result.invocations = counters.invocations.load(std::memory_order_relaxed);
+    result.successes = counters.successes.load(std::memory_order_relaxed);
+    result.totalNs = counters.totalNs.load(std::memory_order_relaxed);
+
+    return result;
+}
+
+size_t Tracer::GetNumRecordedSpans() const
+{
+    std::lock_guard<std::mutex> lock(m_spansMutex);
+    return m_spans.size();
+}
+
+bool Tracer::ExportChromeTrace(const std::string& filePath) const
+{
+    FILE* file = std::fopen(filePath.c_str(), "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    // Complete events ("ph": "X"), timestamps and durations in microseconds
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    {
+        std::lock_guard<std::mutex> lock(m_spansMutex);
+        for (size_t i = 0; i < m_spans.size(); i++)
+        {
+            const Span& span = m_spans[i];
+            std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"success\":%s}}%s\n",
+                GetEventName(span.event),
+                GetEventCategory(span.event),
+                span.threadId,
+                span.startNs / 1000.0,
+                span.durationNs / 1000.0,
+                span.success ? "true" : "false",
+                i + 1 < m_spans.size() ? "," : "");
+        }
+    }
+    std::fprintf(file, "]}\n");
+
+    std::fclose(file);
+
+    return true;
+}
+
+uint64_t Tracer::GetNowNs() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+}
+
+const char* Tracer::GetEventName(TraceEvent event)
+{
+    switch (event)
+    {
+    case TraceEvent::LOAD:
+        return "Load";
+    case TraceEvent::CHECK:
+        return "Check";
+    case TraceEvent::SOLVE:
+        return "Solve";
+    case TraceEvent::RULE_QUEENS_CROSS_OUT_RELATED_TILES:
+        return "1. QueensCrossOutRelatedTiles";
+    case TraceEvent::RULE_MARK_QUEEN_IN_REGIONS_WITH_ONLY_ONE_EMPTY_TILE:
+        return "2. MarkQueenInRegionsWithOnlyOneEmptyTile";
+    case TraceEvent::RULE_MARK_QUEEN_IN_ROWS_OR_COLUMNS_WITH_ONLY_ONE_EMPTY_TILE:
+        return "3. MarkQueenInRowsOrColumnsWithOnlyOneEmptyTile";
+    case TraceEvent::RULE_CROSSING_OUT_TILES_IN_REGION_EXCEPT_ROW_OR_COLUMN:
+        return "4. CrossingOutTilesInRegionExceptRowOrColumn";
+    case TraceEvent::RULE_CROSS_OUT_ROW_OR_COLUMN_EXCEPT_REGION:
+        return "5. CrossOutRowOrColumnExceptRegion";
+    case TraceEvent::COUNT:
+    default:
+        return "";
+    }
+}
+
+const char* Tracer::GetEventCategory(TraceEvent event)
+{
+    switch (event)
+    {
+    case TraceEvent::LOAD:
+        return "load";
+    case TraceEvent::CHECK:
+        return "check";
+    case TraceEvent::SOLVE:
+    case TraceEvent::COUNT:
+    default:
+        return "solve";
+    }
+}
@@ -0,0 +1,146 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Whether trace spans are compiled in at all, set by CMake
+#ifndef QUEENS_TRACING
+#define QUEENS_TRACING 1
+#endif
+
+enum class TraceEvent
+{
+    LOAD,
+    CHECK,
+    SOLVE,
+    RULE_QUEENS_CROSS_OUT_RELATED_TILES,
+    RULE_MARK_QUEEN_IN_REGIONS_WITH_ONLY_ONE_EMPTY_TILE,
+    RULE_MARK_QUEEN_IN_ROWS_OR_COLUMNS_WITH_ONLY_ONE_EMPTY_TILE,
+    RULE_CROSSING_OUT_TILES_IN_REGION_EXCEPT_ROW_OR_COLUMN,
+    RULE_CROSS_OUT_ROW_OR_COLUMN_EXCEPT_REGION,
+    COUNT
+};
+
+struct TraceCounters
+{
+    size_t invocations = 0;
+    size_t successes = 0;
+    uint64_t totalNs = 0;
+};
+
+// Collects per-event counters and, while enabled, the individual spans so they can be exported
+// in the Chrome trace event format (chrome://tracing, Perfetto)
+class Tracer
+{
+public:
+    // Static member function to get the instance
+    static Tracer& getInstance()
+    {
+        static Tracer instance; // Guaranteed to be initialized only once
+        return instance;
+    }
+
+    static const size_t MAX_RECORDED_SPANS = 1000000;
+
+    bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    void Record(TraceEvent event, uint64_t startNs, uint64_t durationNs, bool success);
+    void Reset();
+
+    TraceCounters GetCounters(TraceEvent event) const;
+    size_t GetNumRecordedSpans() const;
+
+    bool ExportChromeTrace(const std::string& filePath) const;
+
+    uint64_t GetNowNs() const;
+
+    static const char* GetEventName(TraceEvent event);
+    static const char* GetEventCategory(TraceEvent event);
+
+    Tracer(const Tracer&) = delete; // Delete copy constructor
+    Tracer& operator =(const Tracer&) = delete; // Delete copy assignment operator
+
+private:
+    Tracer() = default; // Private constructor to prevent instantation
+    ~Tracer() = default; // Default destructor
+
+    struct AtomicCounters
+    {
+        std::atomic<size_t> invocations{0};
+        std::atomic<size_t> successes{0};
+        std::atomic<uint64_t> totalNs{0};
+    };
+
+    struct Span
+    {
+        TraceEvent event;
+        uint32_t threadId;
+        uint64_t startNs;
+        uint64_t durationNs;
+        bool success;
+    };
+
+    std::atomic<bool> m_enabled{false};
+    std::array<AtomicCounters, static_cast<size_t>(TraceEvent::COUNT)> m_counters;
+
+    mutable std::mutex m_spansMutex;
+    std::vector<Span> m_spans;
+
+    const std::chrono::steady_clock::time_point m_startTime = std::chrono::steady_clock::now();
+};
+
+#if QUEENS_TRACING
+
+// Times its scope and reports it to the tracer; when tracing is disabled it only costs a relaxed atomic load
+class TraceSpan
+{
+public:
+    explicit TraceSpan(TraceEvent event) : m_event(event), m_isActive(Tracer::getInstance().IsEnabled())
+    {
+        if (m_isActive)
+        {
+            m_startNs = Tracer::getInstance().GetNowNs();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (m_isActive)
+        {
+            Tracer& tracer = Tracer::getInstance();
+            tracer.Record(m_event, m_startNs, tracer.GetNowNs() - m_startNs, m_success);
+        }
+    }
+
+    void SetSuccess(bool success) { m_success = success; }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator =(const TraceSpan&) = delete;
+
+private:
+    TraceEvent m_event;
+    bool m_isActive;
+    bool m_success = true;
+    uint64_t m_startNs = 0;
+};
+
+#else
+
+class TraceSpan
+{
+public:
+    explicit TraceSpan(TraceEvent) {}
+    void SetSuccess(bool) {}
+};
+
+#endif
+
+#endif // TRACE_HPP
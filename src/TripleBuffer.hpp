@@ -0,0 +1,48 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Hands the latest value over from one producer thread to one consumer thread without locks nor waiting:
+// each side owns one of the three buffers, and the third one, in the middle, is swapped atomically
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Producer: fill the write buffer, then publish it
+    T& GetWriteBuffer() { return m_buffers[m_writeIndex]; }
+    void Publish() { m_writeIndex = m_middle.exchange(m_writeIndex | NEW_DATA_BIT, std::memory_order_acq_rel) & INDEX_MASK; }
+
+    // Consumer: the last published value (the same as before if nothing has been published since)
+    const T& Read()
+    {
+        if (m_middle.load(std::memory_order_relaxed) & NEW_DATA_BIT)
+        {
+            m_readIndex = m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        return m_buffers[m_readIndex];
+    }
+
+    // Only while neither side is using it
+    void Reset(const T& value)
+    {
+        m_buffers.fill(value);
+        m_writeIndex = 0;
+        m_middle.store(1, std::memory_order_relaxed);
+        m_readIndex = 2;
+    }
+
+private:
+    static const uint8_t INDEX_MASK = 3;
+    static const uint8_t NEW_DATA_BIT = 4;
+
+    std::array<T, 3> m_buffers = {};
+    uint8_t m_writeIndex = 0; // producer side
+    alignas(64) std::atomic<uint8_t> m_middle{1};
+    alignas(64) uint8_t m_readIndex = 2; // consumer side
+};
+
+#endif // TRIPLE_BUFFER_HPP
@@ -1,7 +1,8 @@
 #include "UiManager.hpp"
 
-#include <algorithm> // for std::sort
-#include <filesystem>
+#include <algorithm> // for std::clamp
+#include <cfloat> // for FLT_MAX
+#include <cstdio> // for std::snprintf
 #include <string>
 
 #include "imgui-SFML.h"
@@ -9,8 +10,14 @@
 
 #include "SFML/Window/Event.hpp"
 
+#include "AllocationTracker.hpp"
+#include "BoardFormat.hpp"
 #include "GlobalSettings.hpp"
+#include "InputRecorder.hpp"
 #include "Level.hpp"
+#include "Profiler.hpp"
+#include "SolutionCache.hpp"
+#include "Trace.hpp"
 #include "UiSettings.hpp"
 
 void UiManager::Init(sf::RenderWindow& window)
@@ -49,6 +56,11 @@ void UiManager::Run(sf::RenderWindow& window, Level& level, float fps)
     HandleUi(window, level, fps);
 
     End();
+
+    if (UiSettings::SHOW_PROFILER)
+    {
+        ShowProfiler();
+    }
 }
 
 void UiManager::HandleUi(sf::RenderWindow& window, Level& level, float fps)
@@ -63,6 +75,8 @@ void UiManager::HandleUi(sf::RenderWindow& window, Level& level, float fps)
 
     UpdateBackgroundColor();
 
+    UpdateRenderingSettings(window);
+
     // -------------------------
     ImGui::Separator();
     ImGui::Separator();
@@ -75,8 +89,17 @@ void UiManager::HandleUi(sf::RenderWindow& window, Level& level, float fps)
     ImGui::Separator();
     // -------------------------
 
+    ShowOverviewSettings();
+
+    // -------------------------
+    ImGui::Separator();
+    ImGui::Separator();
+    // -------------------------
+
     LoadLevel(level);
 
+    ShowCamera(level);
+
     // -------------------------
     ImGui::Separator();
     ImGui::Separator();
@@ -87,6 +110,15 @@ void UiManager::HandleUi(sf::RenderWindow& window, Level& level, float fps)
     ResetLevel(level);
     ImGui::SameLine();
     SolveLevel(level);
+    ImGui::SameLine();
+    HintLevel(level);
+
+    // -------------------------
+    ImGui::Separator();
+    ImGui::Separator();
+    // -------------------------
+
+    ShowBackgroundSolver(level);
 
     // -------------------------
     ImGui::Separator();
@@ -101,10 +133,17 @@ void UiManager::HandleUi(sf::RenderWindow& window, Level& level, float fps)
         // - The total elapsed time after the user has completed the level and the completion popup has been closed
         ShowElapsedTime(level);
 
+        // Shown as solved in the level picker from now on
+        const size_t levelIndex = static_cast<size_t>(UiSettings::LEVEL_CURRENT_INDEX);
+        if (level.IsCompleted() && levelIndex < m_levelIndex.GetNumLevels() && !m_levelIndex.IsSolved(levelIndex))
+        {
+            m_levelIndex.SetSolved(levelIndex);
+        }
+
         // If the level has been completed, we show a completion popup
-        if (UiSettings::LEVEL_COMPLETED && !UiSettings::POPUP_HAS_BEEN_CLOSED)
+        if (level.IsCompleted() && !level.HasCompletionPopupBeenClosed())
         {
-            ShowLevelCompleted();
+            ShowLevelCompleted(level);
         }
     }
 }
@@ -117,6 +156,29 @@ void UiManager::End()
 void UiManager::Render(sf::RenderWindow& window)
 {
     ImGui::SFML::Render(window);
+
+    // Each ImGui draw command is a draw call
+    if (const ImDrawData* drawData = ImGui::GetDrawData())
+    {
+        int drawCalls = 0;
+        for (int i = 0; i < drawData->CmdListsCount; i++)
+        {
+            drawCalls += drawData->CmdLists[i]->CmdBuffer.Size;
+        }
+        Profiler::getInstance().AddDrawCalls(drawCalls);
+    }
+}
+
+bool UiManager::IsAnimating() const
+{
+    // The text cursor of an active input field blinks, and the progress of a background solve or of the rating of the
+    // levels keeps changing
+    return ImGui::GetIO().WantTextInput || m_backgroundSolver.IsRunning() || m_levelIndex.IsRating();
+}
+
+bool UiManager::IsCapturingMouse() const
+{
+    return ImGui::GetIO().WantCaptureMouse;
 }
 
 void UiManager::UpdateWindowTitle(sf::RenderWindow& window)
@@ -129,7 +191,7 @@ void UiManager::UpdateWindowTitle(sf::RenderWindow& window)
 
 void UiManager::ShowFPS(float fps)
 {
-    ImGui::Text("FPS: %f", fps);
+    ImGui::Text("FPS: %.1f", fps);
 }
 
 void UiManager::UpdateMousePosition(sf::RenderWindow& window)
@@ -156,6 +218,16 @@ void UiManager::UpdateBackgroundColor()
     }
 }
 
+void UiManager::UpdateRenderingSettings(sf::RenderWindow& window)
+{
+    ImGui::Checkbox("Render on demand", &GlobalSettings::RENDER_ON_DEMAND);
+
+    if (ImGui::SliderInt("Frame cap (0 = none)", &GlobalSettings::FRAME_RATE_LIMIT, 0, 240))
+    {
+        window.setFramerateLimit(GlobalSettings::FRAME_RATE_LIMIT);
+    }
+}
+
 void UiManager::ShowRules()
 {
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.7f, 0.2f, 0.9f, 1.0f));
@@ -182,6 +254,19 @@ void UiManager::ShowRules()
     }
 }
 
+void UiManager::ShowOverviewSettings()
+{
+    ImGui::TextColored(ImVec4(1, 1, 0, 1), "Overview");
+
+    ImGui::Checkbox("Show overview of many boards", &UiSettings::SHOW_OVERVIEW);
+
+    if (UiSettings::SHOW_OVERVIEW)
+    {
+        ImGui::SliderInt("Boards", &UiSettings::OVERVIEW_NUM_BOARDS, 1, GlobalSettings::OVERVIEW_MAX_BOARDS);
+        ImGui::SliderInt("Moves per second", &UiSettings::OVERVIEW_MOVES_PER_SECOND, 0, 5000);
+    }
+}
+
 void UiManager::DebugUi(Level& level)
 {
     ImGui::TextColored(ImVec4(1, 1, 0, 1), "Debug");
@@ -198,6 +283,147 @@ void UiManager::DebugUi(Level& level)
             level.PrintRepresentation();
         }
         ImGui::PopStyleColor(2);
+
+        ImGui::Checkbox("Show profiler", &UiSettings::SHOW_PROFILER);
+
+        // Solution cache statistics
+        const SolutionCacheStats cacheStats = SolutionCache::getInstance().GetStats();
+        ImGui::Text("Solution cache: %zu entries", cacheStats.entries);
+        ImGui::Text("Hits: %zu | Misses: %zu | Hit rate: %.1f%%", cacheStats.hits, cacheStats.misses, cacheStats.HitRate() * 100.0f);
+
+        ShowTracing();
+        ShowAllocations();
+
+        ShowInputRecording(level);
+    }
+}
+
+void UiManager::ShowProfiler()
+{
+    Profiler& profiler = Profiler::getInstance();
+
+    ImGui::Begin("Profiler", &UiSettings::SHOW_PROFILER);
+
+    if (profiler.GetNumSamples() == 0)
+    {
+        ImGui::Text("No frames recorded yet.");
+        ImGui::End();
+        return;
+    }
+
+    const FrameSample& last = profiler.GetSample(0);
+    const FrameSample average = profiler.GetAverage();
+
+    ImGui::Text("Cold start: %.1f ms (target %d ms)", profiler.GetStartupMs(), GlobalSettings::STARTUP_TARGET_MS);
+    ImGui::Text("Last %zu frames", profiler.GetNumSamples());
+    ImGui::Text("Frame time: p50 %.2f ms | p99 %.2f ms", profiler.GetFrameTimePercentile(50.0f), profiler.GetFrameTimePercentile(99.0f));
+
+    const std::vector<float>& frameTimes = profiler.GetFrameTimes();
+    ImGui::PlotLines("Frame time (ms)", frameTimes.data(), static_cast<int>(frameTimes.size()), 0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 80));
+
+    ImGui::Separator();
+
+    ImGui::Text("%-14s %8s %8s", "Phase", "Last", "Average");
+    for (size_t i = 0; i < static_cast<size_t>(ProfilerPhase::COUNT); i++)
+    {
+        ImGui::Text("%-14s %5.2f ms %5.2f ms", Profiler::GetPhaseName(static_cast<ProfilerPhase>(i)), last.phaseMs[i], average.phaseMs[i]);
+    }
+    ImGui::Text("%-14s %5.2f ms %5.2f ms", "Total", last.frameMs, average.frameMs);
+
+    ImGui::Separator();
+
+    ImGui::Text("Draw calls: %d (average %d)", last.drawCalls, average.drawCalls);
+    ImGui::Text("Allocations: %zu (average %zu)", last.allocations, average.allocations);
+
+    ImGui::End();
+}
+
+void UiManager::ShowTracing()
+{
+    Tracer& tracer = Tracer::getInstance();
+
+    bool tracingEnabled = tracer.IsEnabled();
+    if (ImGui::Checkbox("Solver tracing", &tracingEnabled))
+    {
+        tracer.SetEnabled(tracingEnabled);
+    }
+
+    if (!tracingEnabled)
+    {
+        return;
+    }
+
+    ImGui::Text("%-48s %7s %7s %10s", "Event", "Calls", "Success", "Avg (us)");
+    for (size_t i = 0; i < static_cast<size_t>(TraceEvent::COUNT); i++)
+    {
+        const TraceEvent event = static_cast<TraceEvent>(i);
+        const TraceCounters counters = tracer.GetCounters(event);
+        const double averageUs = counters.invocations > 0 ? counters.totalNs / 1000.0 / counters.invocations : 0.0;
+        ImGui::Text("%-48s %7zu %7zu %10.2f", Tracer::GetEventName(event), counters.invocations, counters.successes, averageUs);
+    }
+
+    ImGui::Text("Recorded spans: %zu", tracer.GetNumRecordedSpans());
+    if (ImGui::Button("Export trace"))
+    {
+        tracer.ExportChromeTrace(GlobalSettings::TRACE_EXPORT_PATH);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset trace"))
+    {
+        tracer.Reset();
+    }
+}
+
+void UiManager::ShowAllocations()
+{
+    bool scopeTrackingEnabled = AllocationTracker::IsScopeTrackingEnabled();
+    if (ImGui::Checkbox("Scope allocations", &scopeTrackingEnabled))
+    {
+        AllocationTracker::SetScopeTrackingEnabled(scopeTrackingEnabled);
+    }
+
+    if (!scopeTrackingEnabled)
+    {
+        return;
+    }
+
+    ImGui::Text("%-8s %12s %14s", "Scope", "Allocations", "Bytes");
+    for (size_t i = 0; i < static_cast<size_t>(AllocationScope::COUNT); i++)
+    {
+        const AllocationScope scope = static_cast<AllocationScope>(i);
+        const AllocationCounters counters = AllocationTracker::GetScopeCounters(scope);
+        ImGui::Text("%-8s %12zu %14zu", AllocationTracker::GetScopeName(scope), counters.count, counters.bytes);
+    }
+
+    if (ImGui::Button("Reset allocations"))
+    {
+        AllocationTracker::ResetScopeCounters();
+    }
+}
+
+void UiManager::ShowInputRecording(Level& level)
+{
+    InputRecorder& recorder = InputRecorder::getInstance();
+
+    if (!recorder.IsRecording())
+    {
+        if (ImGui::Button("Record input") && m_levelIndex.GetNumLevels() > 0 && recorder.StartRecording(GlobalSettings::INPUT_RECORDING_PATH, level))
+        {
+            // Recordings start by (re)loading the current level, so replaying them always starts from the same state
+            InputEvent loadEvent;
+            loadEvent.type = InputEventType::LOAD_LEVEL;
+            loadEvent.levelFileName = m_levelIndex.GetNames()[UiSettings::LEVEL_CURRENT_INDEX];
+            recorder.Dispatch(level, loadEvent);
+        }
+    }
+    else
+    {
+        if (ImGui::Button("Stop recording"))
+        {
+            recorder.StopRecording();
+        }
+        ImGui::SameLine();
+        ImGui::Text("%zu events recorded to %s", recorder.GetNumRecordedEvents(), GlobalSettings::INPUT_RECORDING_PATH);
     }
 }
 
@@ -206,31 +432,137 @@ void UiManager::LoadLevel(Level& level)
     ImGui::TextColored(ImVec4(1, 1, 0, 1), "Load");
 
     // This prevents the program from crashing from a clean slate (i.e., no levels have been saved yet)
-    if (m_levelsToLoad.empty())
+    if (m_levelIndex.GetNumLevels() == 0)
     {
         ImGui::Text("Save at least 1 level so levels can be loaded.");
         return;
     }
 
-    if (ImGui::BeginCombo("Level to load", m_levelsToLoad[UiSettings::LEVEL_CURRENT_INDEX].data(), 0))
+    m_levelIndex.Update();
+
+    // Released before any thumbnail of this frame is drawn, as ImGui only uses them when rendering
+    ReleaseLevelThumbnails();
+
+    ImGui::InputTextWithHint("Search", "level name", UiSettings::LEVEL_SEARCH_QUERY, sizeof(UiSettings::LEVEL_SEARCH_QUERY));
+    ImGui::SameLine();
+    ImGui::RadioButton("Prefix", &UiSettings::LEVEL_SEARCH_MODE, static_cast<int>(LevelSearchMode::PREFIX));
+    ImGui::SameLine();
+    ImGui::RadioButton("Contains", &UiSettings::LEVEL_SEARCH_MODE, static_cast<int>(LevelSearchMode::CONTAINS));
+
+    ImGui::SetNextItemWidth(80.0f);
+    if (ImGui::InputInt("Size", &UiSettings::LEVEL_FILTER_SIZE))
+    {
+        UiSettings::LEVEL_FILTER_SIZE = std::clamp(UiSettings::LEVEL_FILTER_SIZE, 0, GridBoard::MAX_SIZE);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100.0f);
+    int difficultyItem = UiSettings::LEVEL_FILTER_DIFFICULTY + 1;
+    if (ImGui::Combo("Difficulty", &difficultyItem, "any\0easy\0medium\0hard\0ambiguous\0unsolvable\0"))
+    {
+        UiSettings::LEVEL_FILTER_DIFFICULTY = difficultyItem - 1;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100.0f);
+    ImGui::Combo("Solved", &UiSettings::LEVEL_FILTER_SOLVED, "any\0solved\0unsolved\0");
+
+    LevelFilter filter;
+    filter.query = UiSettings::LEVEL_SEARCH_QUERY;
+    filter.mode = static_cast<LevelSearchMode>(UiSettings::LEVEL_SEARCH_MODE);
+    filter.size = UiSettings::LEVEL_FILTER_SIZE;
+    filter.difficulty = UiSettings::LEVEL_FILTER_DIFFICULTY;
+    filter.solved = static_cast<LevelSolvedFilter>(UiSettings::LEVEL_FILTER_SOLVED);
+    const std::vector<uint32_t>& matches = m_levelIndex.Search(filter);
+
+    if (m_levelIndex.IsRating())
+    {
+        ImGui::Text("%zu of %zu levels (%zu rated so far)", matches.size(), m_levelIndex.GetNumLevels(), m_levelIndex.GetNumRated());
+    }
+    else
+    {
+        ImGui::Text("%zu of %zu levels", matches.size(), m_levelIndex.GetNumLevels());
+    }
+
+    const ImGuiTableFlags tableFlags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter;
+    if (!ImGui::BeginTable("Levels", 5, tableFlags, ImVec2(0.0f, GlobalSettings::LEVEL_PICKER_HEIGHT)))
     {
-        for (size_t i = 0; i < m_levelsToLoad.size(); i++)
+        return;
+    }
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, GlobalSettings::LEVEL_THUMBNAIL_SIZE);
+    ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+    ImGui::TableSetupColumn("Size", ImGuiTableColumnFlags_WidthFixed);
+    ImGui::TableSetupColumn("Difficulty", ImGuiTableColumnFlags_WidthFixed);
+    ImGui::TableSetupColumn("Solved", ImGuiTableColumnFlags_WidthFixed);
+    ImGui::TableHeadersRow();
+
+    // Only the visible rows are laid out, and only their thumbnails rendered
+    const float rowHeight = GlobalSettings::LEVEL_THUMBNAIL_SIZE + ImGui::GetStyle().CellPadding.y * 2.0f;
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(matches.size()), rowHeight);
+    while (clipper.Step())
+    {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
         {
-            const bool isSelected = (UiSettings::LEVEL_CURRENT_INDEX == i);
-            if (ImGui::Selectable(m_levelsToLoad[i].data(), isSelected))
+            const size_t i = matches[row];
+            ImGui::TableNextRow(ImGuiTableRowFlags_None, rowHeight);
+
+            ImGui::TableNextColumn();
+            const sf::Texture& thumbnail = GetLevelThumbnail(i);
+            if (thumbnail.getSize().x > 0)
             {
-                UiSettings::LEVEL_CURRENT_INDEX = i;
+                ImGui::Image(thumbnail, sf::Vector2f(GlobalSettings::LEVEL_THUMBNAIL_SIZE, GlobalSettings::LEVEL_THUMBNAIL_SIZE));
+            }
+            else
+            {
+                ImGui::Dummy(ImVec2(GlobalSettings::LEVEL_THUMBNAIL_SIZE, GlobalSettings::LEVEL_THUMBNAIL_SIZE));
+            }
 
-                level.Clear();
-                level.Load(m_levelsToLoad[UiSettings::LEVEL_CURRENT_INDEX]);
+            ImGui::TableNextColumn();
+            const bool isSelected = (static_cast<size_t>(UiSettings::LEVEL_CURRENT_INDEX) == i);
+            if (ImGui::Selectable(m_levelIndex.GetNames()[i].data(), isSelected, ImGuiSelectableFlags_SpanAllColumns))
+            {
+                UiSettings::LEVEL_CURRENT_INDEX = static_cast<int>(i);
+
+                InputEvent loadEvent;
+                loadEvent.type = InputEventType::LOAD_LEVEL;
+                loadEvent.levelFileName = m_levelIndex.GetNames()[i];
+                InputRecorder::getInstance().Dispatch(level, loadEvent);
             }
 
-            if (isSelected)
+            // Details still being rated are left blank
+            const uint8_t difficulty = m_levelIndex.GetDifficulty(i);
+            ImGui::TableNextColumn();
+            if (m_levelIndex.GetSize(i) > 0)
+            {
+                ImGui::Text("%d", m_levelIndex.GetSize(i));
+            }
+            ImGui::TableNextColumn();
+            if (difficulty != LevelIndex::UNKNOWN_DIFFICULTY)
             {
-                ImGui::SetItemDefaultFocus();
+                ImGui::TextUnformatted(GetDifficultyName(static_cast<GridDifficulty>(difficulty)));
+            }
+            ImGui::TableNextColumn();
+            if (m_levelIndex.IsSolved(i))
+            {
+                ImGui::TextUnformatted("yes");
             }
         }
-        ImGui::EndCombo();
+    }
+    ImGui::EndTable();
+}
+
+void UiManager::ShowCamera(Level& level)
+{
+    if (!level.HasLoaded())
+    {
+        return;
+    }
+
+    ImGui::Text("Zoom: %.0f%% (mouse wheel, drag with the right button to pan)", level.GetCameraZoom() * 100.0f);
+    ImGui::SameLine();
+    if (ImGui::Button("Fit to window"))
+    {
+        level.FitCamera();
     }
 }
 
@@ -240,7 +572,9 @@ void UiManager::ResetLevel(Level& level)
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.6f, 0.0f, 0.0f, 1.0f));
     if (ImGui::Button("Reset"))
     {
-        level.Reset();
+        InputEvent resetEvent;
+        resetEvent.type = InputEventType::RESET;
+        InputRecorder::getInstance().Dispatch(level, resetEvent);
     }
     ImGui::PopStyleColor(2);
 }
@@ -251,33 +585,165 @@ void UiManager::SolveLevel(Level& level)
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 0.4f, 0.0f, 1.0f));
     if (ImGui::Button("Solve"))
     {
-        level.Solve();
+        InputEvent solveEvent;
+        solveEvent.type = InputEventType::SOLVE;
+        InputRecorder::getInstance().Dispatch(level, solveEvent);
     }
     ImGui::PopStyleColor(2);
 }
 
+void UiManager::HintLevel(Level& level)
+{
+    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.4f, 0.7f, 1.0f));
+    ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 0.3f, 0.5f, 1.0f));
+    if (ImGui::Button("Hint"))
+    {
+        InputEvent hintEvent;
+        hintEvent.type = InputEventType::HINT;
+        InputRecorder::getInstance().Dispatch(level, hintEvent);
+    }
+    ImGui::PopStyleColor(2);
+}
+
+void UiManager::ShowBackgroundSolver(Level& level)
+{
+    // The result of a finished search is applied here, on the main thread, in one go
+    BackgroundSolveResult result;
+    if (m_backgroundSolver.TakeResult(result))
+    {
+        ApplyBackgroundSolveResult(level, result);
+    }
+
+    ImGui::TextColored(ImVec4(1, 1, 0, 1), "Background solver");
+
+    if (!m_backgroundSolver.IsRunning())
+    {
+        const char* modes[] = {"Find a solution", "Count solutions"};
+        ImGui::Combo("Mode", &UiSettings::BACKGROUND_SOLVE_MODE, modes, IM_ARRAYSIZE(modes));
+        ImGui::SliderInt("Time budget (s)", &UiSettings::BACKGROUND_SOLVE_TIME_BUDGET_S, 1, 60);
+
+        if (ImGui::Button("Solve in background") && level.HasLoaded())
+        {
+            GridBoard board;
+            if (level.ToGridBoard(board))
+            {
+                const BackgroundSolveMode mode = static_cast<BackgroundSolveMode>(UiSettings::BACKGROUND_SOLVE_MODE);
+                m_backgroundSolver.Start(board, mode, GlobalSettings::BACKGROUND_COUNT_MAX_SOLUTIONS, UiSettings::BACKGROUND_SOLVE_TIME_BUDGET_S * 1000);
+                m_backgroundSolveGridHash = level.GetGridHash();
+                m_backgroundSolveSize = board.size;
+                m_backgroundSolveStatus.clear();
+            }
+            else
+            {
+                m_backgroundSolveStatus = "This level is too big for the solver";
+            }
+        }
+    }
+    else
+    {
+        const BackgroundSolveProgress& progress = m_backgroundSolver.GetProgress();
+        const GridSolverStats& stats = progress.solver.stats;
+        const double nodesPerSecond = progress.elapsedMs > 0.0f ? stats.nodes / (progress.elapsedMs / 1000.0) : 0.0;
+
+        ImGui::Text("Searching... %.1f s", progress.elapsedMs / 1000.0f);
+        ImGui::Text("Nodes: %llu (%.0f per second)", static_cast<unsigned long long>(stats.nodes), nodesPerSecond);
+        ImGui::Text("Depth: %d of %d (deepest: %d)", progress.solver.depth, m_backgroundSolveSize, progress.solver.maxDepth);
+        ImGui::Text("Deductions: %llu | Guesses: %llu", static_cast<unsigned long long>(stats.forced), static_cast<unsigned long long>(stats.guesses));
+        if (m_backgroundSolver.GetMode() == BackgroundSolveMode::COUNT_SOLUTIONS)
+        {
+            ImGui::Text("Solutions found: %llu", static_cast<unsigned long long>(progress.solver.numSolutions));
+        }
+
+        if (ImGui::Button("Cancel"))
+        {
+            m_backgroundSolver.Cancel();
+        }
+    }
+
+    if (!m_backgroundSolveStatus.empty())
+    {
+        ImGui::TextWrapped("%s", m_backgroundSolveStatus.c_str());
+    }
+}
+
+void UiManager::ApplyBackgroundSolveResult(Level& level, const BackgroundSolveResult& result)
+{
+    const unsigned long long numSolutions = result.numSolutions;
+    const unsigned long long numNodes = result.stats.nodes;
+    const float seconds = result.elapsedMs / 1000.0f;
+
+    const char* stopReason = "";
+    if (result.outcome == BackgroundSolveOutcome::CANCELLED)
+    {
+        stopReason = "cancelled";
+    }
+    else if (result.outcome == BackgroundSolveOutcome::TIMED_OUT)
+    {
+        stopReason = "out of time";
+    }
+
+    char status[256];
+    if (result.mode == BackgroundSolveMode::SOLVE && numSolutions > 0)
+    {
+        // The level may have changed while searching
+        if (level.GetGridHash() != m_backgroundSolveGridHash)
+        {
+            std::snprintf(status, sizeof(status), "Solution found in %.2f s, but another level has been loaded since", seconds);
+        }
+        else
+        {
+            QueenLayout solution(result.solution.size);
+            for (int row = 0; row < result.solution.size; row++)
+            {
+                solution[row] = static_cast<uint16_t>(result.solution.queens[row]);
+            }
+            level.PlaceSolution(solution);
+
+            std::snprintf(status, sizeof(status), "Solved in %.2f s (%llu nodes, %llu guesses)", seconds, numNodes, static_cast<unsigned long long>(result.stats.guesses));
+        }
+    }
+    else if (result.outcome != BackgroundSolveOutcome::FINISHED)
+    {
+        std::snprintf(status, sizeof(status), "Stopped (%s) after %.2f s and %llu nodes, %llu solution(s) found so far", stopReason, seconds, numNodes, numSolutions);
+    }
+    else if (numSolutions == 0)
+    {
+        std::snprintf(status, sizeof(status), "No solution (%llu nodes searched in %.2f s)", numNodes, seconds);
+    }
+    else if (numSolutions >= GlobalSettings::BACKGROUND_COUNT_MAX_SOLUTIONS)
+    {
+        std::snprintf(status, sizeof(status), "At least %llu solutions (counted in %.2f s)", numSolutions, seconds);
+    }
+    else
+    {
+        std::snprintf(status, sizeof(status), "%llu solution(s)%s (counted in %.2f s, %llu nodes)", numSolutions, numSolutions == 1 ? ", the solution is unique" : "", seconds, numNodes);
+    }
+
+    m_backgroundSolveStatus = status;
+}
+
 void UiManager::ShowElapsedTime(Level& level)
 {
     int timeElapsed = static_cast<int>(level.GetClock().getElapsedTime().asSeconds());
-    if (UiSettings::LEVEL_COMPLETED)
+    if (level.IsCompleted())
     {
-        timeElapsed = UiSettings::LEVEL_COMPLETED_TIME;
+        timeElapsed = level.GetCompletedTime();
     }
     ImGui::Text("Time elapsed: %d seconds", timeElapsed);
 }
 
-void UiManager::ShowLevelCompleted()
+void UiManager::ShowLevelCompleted(Level& level)
 {
     ImGui::OpenPopup("Level completed");
 
     if (ImGui::BeginPopupModal("Level completed", NULL, ImGuiWindowFlags_AlwaysAutoResize))
     {
         ImGui::Text("Good job!");
-        ImGui::Text("You've completed the level in %d seconds!", UiSettings::LEVEL_COMPLETED_TIME);
+        ImGui::Text("You've completed the level in %d seconds!", level.GetCompletedTime());
         ImGui::Separator();
         if (ImGui::Button("Close", ImVec2(120, 0)))
         {
-            UiSettings::POPUP_HAS_BEEN_CLOSED = true;
+            level.CloseCompletionPopup();
             
             ImGui::CloseCurrentPopup();
         }
@@ -287,20 +753,66 @@ void UiManager::ShowLevelCompleted()
 
 void UiManager::GetLevelsToLoad()
 {
-    m_levelsToLoad.clear();
+    // Sorted by name, the sizes, difficulties and solved states follow on a worker thread
+    m_levelIndex.Build(std::string(GlobalSettings::LEVELS_PATH));
+
+    m_levelThumbnails.clear();
+    m_levelThumbnails.resize(m_levelIndex.GetNumLevels());
+    m_levelThumbnailUses.clear();
+}
 
-    for (const auto& entry : std::filesystem::directory_iterator(std::string(GlobalSettings::LEVELS_PATH)))
+const sf::Texture& UiManager::GetLevelThumbnail(size_t index)
+{
+    LevelThumbnail& levelThumbnail = m_levelThumbnails[index];
+    std::unique_ptr<sf::Texture>& texture = levelThumbnail.texture;
+    if (texture)
     {
-        const auto& path = entry.path();
-        if (path.extension() == ".txt")
-        {
-            m_levelsToLoad.emplace_back(path.filename().string());
-        }
+        // Now the most recently shown
+        m_levelThumbnailUses.splice(m_levelThumbnailUses.end(), m_levelThumbnailUses, levelThumbnail.usePosition);
+        return *texture;
     }
+    texture = std::make_unique<sf::Texture>();
+    levelThumbnail.usePosition = m_levelThumbnailUses.insert(m_levelThumbnailUses.end(), index);
 
-    // Sort level files alphabetically
-    std::sort(
-        m_levelsToLoad.begin(),
-        m_levelsToLoad.end(),
-        [](const std::string& a, const std::string& b) -> bool { return a < b; });
+    std::string line;
+    std::string error;
+    GridBoard board;
+    if (!BoardFormat::ReadBoardFile(std::string(GlobalSettings::LEVELS_PATH) + m_levelIndex.GetNames()[index], line, board, error))
+    {
+        return *texture;
+    }
+
+    // Only the regions: the picker should not give the solution away, even of the levels saved with their queens
+    ThumbnailOptions options;
+    options.tileSize = GlobalSettings::LEVEL_THUMBNAIL_TILE_SIZE;
+    options.borderThickness = 1;
+    options.drawQueens = false;
+    ThumbnailRenderer::Render(board, options, m_thumbnail);
+
+    m_thumbnailPixels.resize(m_thumbnail.pixels.size() * 4);
+    for (size_t i = 0; i < m_thumbnail.pixels.size(); i++)
+    {
+        const RegionColor color = ThumbnailRenderer::GetPaletteColor(m_thumbnail.pixels[i]);
+        m_thumbnailPixels[i * 4] = color.r;
+        m_thumbnailPixels[i * 4 + 1] = color.g;
+        m_thumbnailPixels[i * 4 + 2] = color.b;
+        m_thumbnailPixels[i * 4 + 3] = 255;
+    }
+    if (texture->create(m_thumbnail.width, m_thumbnail.height))
+    {
+        texture->update(m_thumbnailPixels.data());
+        texture->setSmooth(true); // shown smaller than it is
+    }
+
+    return *texture;
+}
+
+void UiManager::ReleaseLevelThumbnails()
+{
+    // The least recently shown first
+    while (m_levelThumbnailUses.size() > GlobalSettings::LEVEL_THUMBNAIL_CACHE_SIZE)
+    {
+        m_levelThumbnails[m_levelThumbnailUses.front()].texture.reset();
+        m_levelThumbnailUses.pop_front();
+    }
 }
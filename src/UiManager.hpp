@@ -1,9 +1,18 @@
 #ifndef UI_MANAGER_HPP
 #define UI_MANAGER_HPP
 
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "SFML/Graphics/Texture.hpp"
+
+#include "BackgroundSolver.hpp"
 #include "Level.hpp"
+#include "LevelIndex.hpp"
+#include "ThumbnailRenderer.hpp"
 
 class UiManager
 {
@@ -14,17 +23,38 @@ public:
     void Init(sf::RenderWindow& window);
     void Shutdown();
 
-    std::vector<std::string> getLevelsToLoad() const { return m_levelsToLoad; }
+    const std::vector<std::string>& getLevelsToLoad() const { return m_levelIndex.GetNames(); }
 
     void ProcessEvent(sf::Event event);
 
     void Run(sf::RenderWindow& window, Level& level, float fps);
     void Render(sf::RenderWindow& window);
 
+    bool IsAnimating() const;
+    bool IsCapturingMouse() const; // the mouse is over the UI, so it should not reach the level
+
 private:
     sf::Clock m_deltaClock;
 
-    std::vector<std::string> m_levelsToLoad;
+    LevelIndex m_levelIndex;
+
+    // Thumbnails of the levels, rendered the first time they are shown: [level index], null until then or once
+    // released, and empty (0x0) if the level file could not be read
+    struct LevelThumbnail
+    {
+        std::unique_ptr<sf::Texture> texture;
+        std::list<size_t>::iterator usePosition; // in m_levelThumbnailUses, while there is a texture
+    };
+    std::vector<LevelThumbnail> m_levelThumbnails;
+    std::list<size_t> m_levelThumbnailUses; // levels with a thumbnail, least recently shown first
+    Thumbnail m_thumbnail; // reused from one thumbnail to the next
+    std::vector<sf::Uint8> m_thumbnailPixels;
+
+    // Background solver
+    BackgroundSolver m_backgroundSolver;
+    uint64_t m_backgroundSolveGridHash = 0; // level the running search is about
+    int m_backgroundSolveSize = 0;
+    std::string m_backgroundSolveStatus; // outcome of the last search
 
     // UI
     void Update(sf::RenderWindow& window);
@@ -38,21 +68,34 @@ private:
     void ShowFPS(float fps);
     void UpdateMousePosition(sf::RenderWindow& window);
     void UpdateBackgroundColor();
+    void UpdateRenderingSettings(sf::RenderWindow& window);
 
     void ShowRules();
 
+    void ShowOverviewSettings();
+
     void DebugUi(Level& level);
+    void ShowProfiler();
+    void ShowTracing();
+    void ShowAllocations();
+    void ShowInputRecording(Level& level);
 
     // Level related
     void LoadLevel(Level& level);
+    void ShowCamera(Level& level);
     void ResetLevel(Level& level);
     void SolveLevel(Level& level);
+    void HintLevel(Level& level);
+    void ShowBackgroundSolver(Level& level);
+    void ApplyBackgroundSolveResult(Level& level, const BackgroundSolveResult& result);
 
     void ShowElapsedTime(Level& level);
-    void ShowLevelCompleted();
+    void ShowLevelCompleted(Level& level);
 
     // Non-UI helper functions
     void GetLevelsToLoad();
+    const sf::Texture& GetLevelThumbnail(size_t index);
+    void ReleaseLevelThumbnails();
 };
 
 #endif // UI_MANAGER_HPP
@@ -1,17 +1,21 @@
 #include "UiSettings.hpp"
 
-#include <climits>
-
 namespace UiSettings
 {
-int LEVEL_COLS = -1;
-int LEVEL_ROWS = -1;
-
 int LEVEL_CURRENT_INDEX = 0;
+char LEVEL_SEARCH_QUERY[128] = "";
+int LEVEL_SEARCH_MODE = 0;
+int LEVEL_FILTER_SIZE = 0;
+int LEVEL_FILTER_DIFFICULTY = -1;
+int LEVEL_FILTER_SOLVED = 0;
 
-bool SHOW_DEBUG_OPTIONS = false;
+int BACKGROUND_SOLVE_MODE = 0;
+int BACKGROUND_SOLVE_TIME_BUDGET_S = 10;
 
-bool LEVEL_COMPLETED = false;
-int LEVEL_COMPLETED_TIME = INT_MAX;
-bool POPUP_HAS_BEEN_CLOSED = false;
+bool SHOW_OVERVIEW = false;
+int OVERVIEW_NUM_BOARDS = 200;
+int OVERVIEW_MOVES_PER_SECOND = 300;
+
+bool SHOW_DEBUG_OPTIONS = false;
+bool SHOW_PROFILER = false;
 } // namespace UiSettings
@@ -3,16 +3,22 @@
 
 namespace UiSettings
 {
-extern int LEVEL_COLS;
-extern int LEVEL_ROWS;
-
 extern int LEVEL_CURRENT_INDEX;
+extern char LEVEL_SEARCH_QUERY[128];
+extern int LEVEL_SEARCH_MODE; // LevelSearchMode
+extern int LEVEL_FILTER_SIZE; // 0 for any size
+extern int LEVEL_FILTER_DIFFICULTY; // GridDifficulty, -1 for any
+extern int LEVEL_FILTER_SOLVED; // LevelSolvedFilter
 
-extern bool SHOW_DEBUG_OPTIONS;
+extern int BACKGROUND_SOLVE_MODE; // BackgroundSolveMode
+extern int BACKGROUND_SOLVE_TIME_BUDGET_S;
 
-extern bool LEVEL_COMPLETED;
-extern int LEVEL_COMPLETED_TIME;
-extern bool POPUP_HAS_BEEN_CLOSED;
+extern bool SHOW_OVERVIEW;
+extern int OVERVIEW_NUM_BOARDS;
+extern int OVERVIEW_MOVES_PER_SECOND; // made by the simulated players, across all boards
+
+extern bool SHOW_DEBUG_OPTIONS;
+extern bool SHOW_PROFILER;
 } // namespace UiSettings
 
 #endif // UI_SETTINGS_HPP